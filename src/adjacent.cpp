@@ -33,6 +33,7 @@ Adjacent::Adjacent()
   : m_name()
   , m_faceUri()
   , m_linkCost(DEFAULT_LINK_COST)
+  , m_fixedLinkCost(toRouteCost(ceil(DEFAULT_LINK_COST)))
   , m_status(STATUS_INACTIVE)
   , m_interestTimedOutNo(0)
   , m_faceId(0)
@@ -48,6 +49,7 @@ Adjacent::Adjacent(const ndn::Name& an)
   : m_name(an)
   , m_faceUri()
   , m_linkCost(DEFAULT_LINK_COST)
+  , m_fixedLinkCost(toRouteCost(ceil(DEFAULT_LINK_COST)))
   , m_status(STATUS_INACTIVE)
   , m_interestTimedOutNo(0)
   , m_faceId(0)
@@ -76,6 +78,7 @@ Adjacent::setLinkCost(double lc)
   }
 
   m_linkCost = lc;
+  m_fixedLinkCost = toRouteCost(getLinkCost());
 }
 
 NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(Adjacent);
@@ -120,8 +123,10 @@ void
 Adjacent::wireDecode(const ndn::Block& wire)
 {
   m_name.clear();
+  m_nameId.reset();
   m_faceUri = ndn::FaceUri();
   m_linkCost = 0;
+  m_fixedLinkCost = 0;
 
   m_wire = wire;
 
@@ -151,6 +156,7 @@ Adjacent::wireDecode(const ndn::Block& wire)
 
   if (val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::Cost) {
     m_linkCost = ndn::encoding::readDouble(*val);
+    m_fixedLinkCost = toRouteCost(getLinkCost());
     ++val;
   }
   else {
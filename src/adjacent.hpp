@@ -22,6 +22,9 @@
 #ifndef NLSR_ADJACENT_HPP
 #define NLSR_ADJACENT_HPP
 
+#include "router-id.hpp"
+#include "route/route-cost.hpp"
+
 #include <string>
 #include <cmath>
 
@@ -79,6 +82,14 @@ public:
   {
     m_wire.reset();
     m_name = name;
+    m_nameId.reset();
+  }
+
+  /*! \brief Returns the router ID of the neighbor, interning its name on first use. */
+  RouterId
+  getNameId() const
+  {
+    return m_nameId.intern(m_name);
   }
 
   const ndn::FaceUri&
@@ -103,6 +114,13 @@ public:
   void
   setLinkCost(double lc);
 
+  /*! \brief Returns getLinkCost() in fixed point, or INFINITE_ROUTE_COST if it is negative. */
+  RouteCost
+  getFixedLinkCost() const
+  {
+    return m_fixedLinkCost;
+  }
+
   Status
   getStatus() const
   {
@@ -193,6 +211,8 @@ private:
   ndn::FaceUri m_faceUri;
   /*! m_linkCost The semi-arbitrary cost to traverse the link. */
   double m_linkCost;
+  /*! m_fixedLinkCost The fixed-point form of the rounded-up m_linkCost */
+  RouteCost m_fixedLinkCost;
   /*! m_status Whether the neighbor is active or not */
   Status m_status = STATUS_UNKNOWN;
   /*! m_interestTimedOutNo How many failed Hello interests we have sent since the last reply */
@@ -200,6 +220,8 @@ private:
   /*! m_faceId The NFD-assigned ID for the neighbor, used to
    * determine whether a Face is available */
   uint64_t m_faceId;
+  /*! m_nameId A reference on the router ID of m_name, empty until it is first asked for */
+  mutable RouterIdRef m_nameId;
 
   mutable ndn::Block m_wire;
 
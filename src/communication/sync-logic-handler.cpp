@@ -47,13 +47,37 @@ SyncLogicHandler::SyncLogicHandler(ndn::Face& face, const IsLsaNew& isLsaNew,
                          .append(boost::lexical_cast<std::string>(Lsa::Type::ADJACENCY));
   m_coorLsaUserPrefix = ndn::Name(m_confParam.getSyncUserPrefix())
                          .append(boost::lexical_cast<std::string>(Lsa::Type::COORDINATE));
+  m_summaryLsaUserPrefix = ndn::Name(m_confParam.getSyncUserPrefix())
+                             .append(boost::lexical_cast<std::string>(Lsa::Type::SUMMARY));
+
+  addUserNodes(m_syncLogic);
+
+  // An area border router publishes its LSAs in both its own area and the backbone,
+  // and the LSAs of either area go into the same LSDB
+  if (m_confParam.isAreaBorderRouter()) {
+    ndn::Name backboneSyncPrefix = m_confParam.getAreaSyncPrefix(ConfParameter::BACKBONE_AREA);
+    NLSR_LOG_DEBUG("Joining the backbone sync group " << backboneSyncPrefix);
+    m_backboneSyncLogic = std::make_unique<SyncProtocolAdapter>(m_syncFace,
+                            m_confParam.getSyncProtocol(), backboneSyncPrefix,
+                            m_nameLsaUserPrefix, m_confParam.getSyncInterestLifetime(),
+                            std::bind(&SyncLogicHandler::processUpdate, this, _1, _2));
+    addUserNodes(*m_backboneSyncLogic);
+  }
+}
 
+void
+SyncLogicHandler::addUserNodes(SyncProtocolAdapter& syncLogic)
+{
   if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_ON) {
-    m_syncLogic.addUserNode(m_adjLsaUserPrefix);
+    syncLogic.addUserNode(m_adjLsaUserPrefix);
   }
 
   if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
-    m_syncLogic.addUserNode(m_coorLsaUserPrefix);
+    syncLogic.addUserNode(m_coorLsaUserPrefix);
+  }
+
+  if (m_confParam.isAreaBorderRouter()) {
+    syncLogic.addUserNode(m_summaryLsaUserPrefix);
   }
 }
 
@@ -108,6 +132,14 @@ SyncLogicHandler::processUpdateFromSync(const ndn::Name& originRouter,
                        "is enabled. Not going to fetch.");
         return;
       }
+
+      // A stub router routes everything but its stub prefixes toward its neighbors
+      if (m_confParam.isStubRouter() &&
+          (lsaType == Lsa::Type::SUMMARY ||
+           (lsaType == Lsa::Type::NAME && m_confParam.getStubPrefixes().empty()))) {
+        NLSR_LOG_DEBUG("Stub router is not going to fetch " << lsaType << " LSA");
+        return;
+      }
       (*onNewLsa)(updateName, seqNo, originRouter);
     }
   }
@@ -116,18 +148,27 @@ SyncLogicHandler::processUpdateFromSync(const ndn::Name& originRouter,
 void
 SyncLogicHandler::publishRoutingUpdate(const Lsa::Type& type, const uint64_t& seqNo)
 {
+  const ndn::Name* userPrefix = nullptr;
   switch (type) {
   case Lsa::Type::ADJACENCY:
-    m_syncLogic.publishUpdate(m_adjLsaUserPrefix, seqNo);
+    userPrefix = &m_adjLsaUserPrefix;
     break;
   case Lsa::Type::COORDINATE:
-    m_syncLogic.publishUpdate(m_coorLsaUserPrefix, seqNo);
+    userPrefix = &m_coorLsaUserPrefix;
     break;
   case Lsa::Type::NAME:
-    m_syncLogic.publishUpdate(m_nameLsaUserPrefix, seqNo);
+    userPrefix = &m_nameLsaUserPrefix;
     break;
-  default:
+  case Lsa::Type::SUMMARY:
+    userPrefix = &m_summaryLsaUserPrefix;
     break;
+  default:
+    return;
+  }
+
+  m_syncLogic.publishUpdate(*userPrefix, seqNo);
+  if (m_backboneSyncLogic != nullptr) {
+    m_backboneSyncLogic->publishUpdate(*userPrefix, seqNo);
   }
 }
 
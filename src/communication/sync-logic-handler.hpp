@@ -91,6 +91,11 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   processUpdateFromSync(const ndn::Name& originRouter,
                         const ndn::Name& updateName, uint64_t seqNo);
 
+private:
+  /*! \brief Adds the user prefixes of the LSAs this router publishes to \p syncLogic. */
+  void
+  addUserNodes(SyncProtocolAdapter& syncLogic);
+
 public:
   std::unique_ptr<OnNewLsa> onNewLsa;
 
@@ -103,8 +108,11 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::Name m_nameLsaUserPrefix;
   ndn::Name m_adjLsaUserPrefix;
   ndn::Name m_coorLsaUserPrefix;
+  ndn::Name m_summaryLsaUserPrefix;
 
   SyncProtocolAdapter m_syncLogic;
+  /*! The sync group of the backbone area, which only area border routers join. */
+  std::unique_ptr<SyncProtocolAdapter> m_backboneSyncLogic;
 
 private:
   const std::string NLSR_COMPONENT = "nlsr";
@@ -246,6 +246,64 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     return false;
   }
 
+  // area
+  std::string area = section.get<std::string>("area", "");
+  if (area.find('/') != std::string::npos) {
+    std::cerr << "Area must be a single name component" << std::endl;
+    return false;
+  }
+  m_confParam.setArea(area);
+
+  // area-border-router
+  std::string areaBorderRouter = section.get<std::string>("area-border-router", "off");
+  if (boost::iequals(areaBorderRouter, "off")) {
+    m_confParam.setAreaBorderRouter(false);
+  }
+  else if (boost::iequals(areaBorderRouter, "on")) {
+    if (area.empty() || area == ConfParameter::BACKBONE_AREA) {
+      std::cerr << "An area border router needs an area other than the backbone area "
+                << ConfParameter::BACKBONE_AREA << std::endl;
+      return false;
+    }
+    m_confParam.setAreaBorderRouter(true);
+  }
+  else {
+    std::cerr << "Invalid setting for area-border-router. "
+              << "Allowed values: off, on" << std::endl;
+    return false;
+  }
+
+  // stub-router
+  std::string stubRouter = section.get<std::string>("stub-router", "off");
+  if (boost::iequals(stubRouter, "off")) {
+    m_confParam.setStubRouter(false);
+  }
+  else if (boost::iequals(stubRouter, "on")) {
+    m_confParam.setStubRouter(true);
+  }
+  else {
+    std::cerr << "Invalid setting for stub-router. "
+              << "Allowed values: off, on" << std::endl;
+    return false;
+  }
+
+  // stub-prefix
+  for (const auto& tn : section) {
+    if (tn.first != "stub-prefix") {
+      continue;
+    }
+    ndn::Name stubPrefix(tn.second.data());
+    if (stubPrefix.empty()) {
+      std::cerr << "No stub-prefix provided, or invalid stub-prefix" << std::endl;
+      return false;
+    }
+    if (!m_confParam.isStubRouter()) {
+      std::cerr << "stub-prefix requires stub-router on" << std::endl;
+      return false;
+    }
+    m_confParam.addStubPrefix(stubPrefix);
+  }
+
   // lsa-refresh-time
   uint32_t lsaRefreshTime = section.get<uint32_t>("lsa-refresh-time", LSA_REFRESH_TIME_DEFAULT);
 
@@ -317,6 +375,34 @@ ConfFileProcessor::processConfSectionGeneral(const ConfigSection& section)
     return false;
   }
 
+  // lsdb-snapshot-interval
+  uint32_t snapshotInterval = section.get<uint32_t>("lsdb-snapshot-interval",
+                                                    LSDB_SNAPSHOT_INTERVAL_DEFAULT);
+  if (snapshotInterval >= LSDB_SNAPSHOT_INTERVAL_MIN &&
+      snapshotInterval <= LSDB_SNAPSHOT_INTERVAL_MAX) {
+    m_confParam.setLsdbSnapshotInterval(snapshotInterval);
+  }
+  else {
+    std::cerr << "Invalid value for lsdb-snapshot-interval. "
+              << "Allowed range: " << LSDB_SNAPSHOT_INTERVAL_MIN
+              << "-" << LSDB_SNAPSHOT_INTERVAL_MAX << std::endl;
+    return false;
+  }
+
+  // state-fsync
+  std::string stateFsync = section.get<std::string>("state-fsync", "off");
+  if (boost::iequals(stateFsync, "off")) {
+    m_confParam.setStateFsync(false);
+  }
+  else if (boost::iequals(stateFsync, "on")) {
+    m_confParam.setStateFsync(true);
+  }
+  else {
+    std::cerr << "Invalid setting for state-fsync. "
+              << "Allowed values: off, on" << std::endl;
+    return false;
+  }
+
   try {
     std::string stateDir = section.get<std::string>("state-dir");
     if (bf::exists(stateDir)) {
@@ -580,6 +666,21 @@ ConfFileProcessor::processConfSectionFib(const ConfigSection& section)
     return false;
   }
 
+  // fast-reroute
+  std::string fastReroute = section.get<std::string>("fast-reroute", "off");
+
+  if (boost::iequals(fastReroute, "off")) {
+    m_confParam.setFastReroute(false);
+  }
+  else if (boost::iequals(fastReroute, "on")) {
+    m_confParam.setFastReroute(true);
+  }
+  else {
+    std::cerr << "Invalid setting for fast-reroute. "
+              << "Allowed values: off, on" << std::endl;
+    return false;
+  }
+
   // routing-calc-interval
   ConfigurationVariable<uint32_t> routingCalcInterval("routing-calc-interval",
                                                       std::bind(&ConfParameter::setRoutingCalcInterval,
@@ -591,6 +692,40 @@ ConfFileProcessor::processConfSectionFib(const ConfigSection& section)
     return false;
   }
 
+  // routing-calc-initial-delay
+  ConfigurationVariable<uint32_t> routingCalcInitialDelay("routing-calc-initial-delay",
+                                                          std::bind(&ConfParameter::setRoutingCalcInitialDelay,
+                                                          &m_confParam, _1));
+  routingCalcInitialDelay.setMinAndMaxValue(ROUTING_CALC_INITIAL_DELAY_MIN,
+                                            ROUTING_CALC_INITIAL_DELAY_MAX);
+  routingCalcInitialDelay.setOptional(ROUTING_CALC_INITIAL_DELAY_DEFAULT);
+
+  if (!routingCalcInitialDelay.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-hold-time
+  ConfigurationVariable<uint32_t> routingCalcHoldTime("routing-calc-hold-time",
+                                                      std::bind(&ConfParameter::setRoutingCalcHoldTime,
+                                                      &m_confParam, _1));
+  routingCalcHoldTime.setMinAndMaxValue(ROUTING_CALC_HOLD_TIME_MIN, ROUTING_CALC_HOLD_TIME_MAX);
+  routingCalcHoldTime.setOptional(ROUTING_CALC_HOLD_TIME_DEFAULT);
+
+  if (!routingCalcHoldTime.parseFromConfigSection(section)) {
+    return false;
+  }
+
+  // routing-calc-threads
+  ConfigurationVariable<uint32_t> routingCalcThreads("routing-calc-threads",
+                                                     std::bind(&ConfParameter::setRoutingCalcThreads,
+                                                     &m_confParam, _1));
+  routingCalcThreads.setMinAndMaxValue(ROUTING_CALC_THREADS_MIN, ROUTING_CALC_THREADS_MAX);
+  routingCalcThreads.setOptional(ROUTING_CALC_THREADS_DEFAULT);
+
+  if (!routingCalcThreads.parseFromConfigSection(section)) {
+    return false;
+  }
+
   return true;
 }
 
@@ -614,6 +749,14 @@ ConfFileProcessor::processConfSectionAdvertising(const ConfigSection& section)
        return false;
      }
     }
+    else if (tn.first == "aggregate") {
+      ndn::Name aggregate(tn.second.data());
+      if (aggregate.empty()) {
+        std::cerr << " Wrong command format ! [aggregate /name/prefix] or bad URI" << std::endl;
+        return false;
+      }
+      m_confParam.addAggregationRule(aggregate);
+    }
   }
   return true;
 }
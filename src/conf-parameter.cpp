@@ -29,6 +29,8 @@ INIT_LOGGER(ConfParameter);
 // To be changed when breaking changes are made to sync
 const uint64_t ConfParameter::SYNC_VERSION = 10;
 
+const std::string ConfParameter::BACKBONE_AREA = "0";
+
 static std::unique_ptr<ndn::security::CertificateFetcherDirectFetch>
 makeCertificateFetcher(ndn::Face& face)
 {
@@ -40,9 +42,15 @@ makeCertificateFetcher(ndn::Face& face)
 ConfParameter::ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
                              const std::string& confFileName)
   : m_confFileName(confFileName)
+  , m_isAreaBorderRouter(false)
+  , m_isStubRouter(false)
   , m_lsaRefreshTime(LSA_REFRESH_TIME_DEFAULT)
+  , m_lsdbSnapshotInterval(LSDB_SNAPSHOT_INTERVAL_DEFAULT)
   , m_adjLsaBuildInterval(ADJ_LSA_BUILD_INTERVAL_DEFAULT)
   , m_routingCalcInterval(ROUTING_CALC_INTERVAL_DEFAULT)
+  , m_routingCalcInitialDelay(ROUTING_CALC_INITIAL_DELAY_DEFAULT)
+  , m_routingCalcHoldTime(ROUTING_CALC_HOLD_TIME_DEFAULT)
+  , m_routingCalcThreads(ROUTING_CALC_THREADS_DEFAULT)
   , m_faceDatasetFetchInterval(ndn::time::seconds(static_cast<int>(FACE_DATASET_FETCH_INTERVAL_DEFAULT)))
   , m_lsaInterestLifetime(ndn::time::seconds(static_cast<int>(LSA_INTEREST_LIFETIME_DEFAULT)))
   , m_routerDeadInterval(2 * LSA_REFRESH_TIME_DEFAULT)
@@ -52,6 +60,8 @@ ConfParameter::ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
   , m_hyperbolicState(HYPERBOLIC_STATE_OFF)
   , m_corR(0)
   , m_maxFacesPerPrefix(MAX_FACES_PER_PREFIX_MIN)
+  , m_fastReroute(false)
+  , m_isStateFsync(false)
   , m_syncInterestLifetime(ndn::time::milliseconds(SYNC_INTEREST_LIFETIME_DEFAULT))
   , m_syncProtocol(SYNC_PROTOCOL_PSYNC)
   , m_adjl()
@@ -68,6 +78,13 @@ ConfParameter::writeLog()
   NLSR_LOG_INFO("Router Name: " << m_routerName);
   NLSR_LOG_INFO("Site Name: " << m_siteName);
   NLSR_LOG_INFO("Network: " << m_network);
+  if (!m_area.empty()) {
+    NLSR_LOG_INFO("Area: " << m_area);
+    NLSR_LOG_INFO("Area border router: " << (m_isAreaBorderRouter ? "yes" : "no"));
+  }
+  if (m_isStubRouter) {
+    NLSR_LOG_INFO("Stub router, learning " << m_stubPrefixes.size() << " prefix(es)");
+  }
   NLSR_LOG_INFO("Router Prefix: " << m_routerPrefix);
   NLSR_LOG_INFO("Sync Prefix: " << m_syncPrefix);
   NLSR_LOG_INFO("Sync LSA prefix: " << m_lsaPrefix);
@@ -76,9 +93,11 @@ ConfParameter::writeLog()
   NLSR_LOG_INFO("Info Interest interval: " << m_infoInterestInterval);
   NLSR_LOG_INFO("LSA refresh time: " << m_lsaRefreshTime);
   NLSR_LOG_INFO("FIB Entry refresh time: " << m_lsaRefreshTime * 2);
+  NLSR_LOG_INFO("LSDB snapshot interval: " << m_lsdbSnapshotInterval);
   NLSR_LOG_INFO("LSA Interest lifetime: " << getLsaInterestLifetime());
   NLSR_LOG_INFO("Router dead interval: " << getRouterDeadInterval());
   NLSR_LOG_INFO("Max Faces Per Prefix: " << m_maxFacesPerPrefix);
+  NLSR_LOG_INFO("Fast reroute: " << (m_fastReroute ? "on" : "off"));
   if (m_hyperbolicState == HYPERBOLIC_STATE_ON || m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN) {
     NLSR_LOG_INFO("Hyperbolic Routing: " << m_hyperbolicState);
     NLSR_LOG_INFO("Hyp R: " << m_corR);
@@ -88,10 +107,14 @@ ConfParameter::writeLog()
     }
   }
   NLSR_LOG_INFO("State Directory: " << m_stateFileDir);
+  NLSR_LOG_INFO("State fsync: " << (m_isStateFsync ? "on" : "off"));
 
   // Event Intervals
   NLSR_LOG_INFO("Adjacency LSA build interval:  " << m_adjLsaBuildInterval);
   NLSR_LOG_INFO("Routing calculation interval:  " << m_routingCalcInterval);
+  NLSR_LOG_INFO("Routing calculation initial delay:  " << m_routingCalcInitialDelay);
+  NLSR_LOG_INFO("Routing calculation hold time:  " << m_routingCalcHoldTime);
+  NLSR_LOG_INFO("Routing calculation threads:  " << m_routingCalcThreads);
 }
 
 void
@@ -99,11 +122,7 @@ ConfParameter::setNetwork(const ndn::Name& networkName)
 {
   m_network = networkName;
 
-  m_syncPrefix.append("localhop");
-  m_syncPrefix.append(m_network);
-  m_syncPrefix.append("nlsr");
-  m_syncPrefix.append("sync");
-  m_syncPrefix.appendVersion(SYNC_VERSION);
+  m_syncPrefix = getAreaSyncPrefix(m_area);
 
   m_lsaPrefix.append("localhop");
   m_lsaPrefix.append(m_network);
@@ -111,6 +130,28 @@ ConfParameter::setNetwork(const ndn::Name& networkName)
   m_lsaPrefix.append("LSA");
 }
 
+void
+ConfParameter::setArea(const std::string& area)
+{
+  m_area = area;
+  m_syncPrefix = getAreaSyncPrefix(m_area);
+}
+
+ndn::Name
+ConfParameter::getAreaSyncPrefix(const std::string& area) const
+{
+  ndn::Name syncPrefix("localhop");
+  syncPrefix.append(m_network);
+  syncPrefix.append("nlsr");
+  syncPrefix.append("sync");
+  // Each area has its own sync group, and thus its own LSDB
+  if (!area.empty()) {
+    syncPrefix.append(area);
+  }
+  syncPrefix.appendVersion(SYNC_VERSION);
+  return syncPrefix;
+}
+
 void
 ConfParameter::loadCertToValidator(const ndn::security::Certificate& cert)
 {
@@ -32,6 +32,8 @@
 #include <ndn-cxx/security/validator-config.hpp>
 #include <ndn-cxx/security/certificate-fetcher-direct-fetch.hpp>
 
+#include <algorithm>
+
 namespace nlsr {
 
 enum {
@@ -40,6 +42,12 @@ enum {
   LSA_REFRESH_TIME_MAX = 7200
 };
 
+enum {
+  LSDB_SNAPSHOT_INTERVAL_MIN = 0,
+  LSDB_SNAPSHOT_INTERVAL_DEFAULT = 0,
+  LSDB_SNAPSHOT_INTERVAL_MAX = 3600
+};
+
 enum SyncProtocol {
 #ifdef HAVE_CHRONOSYNC
   SYNC_PROTOCOL_CHRONOSYNC,
@@ -65,6 +73,24 @@ enum {
   ROUTING_CALC_INTERVAL_MAX = 15
 };
 
+enum {
+  ROUTING_CALC_INITIAL_DELAY_MIN = 0,
+  ROUTING_CALC_INITIAL_DELAY_DEFAULT = 100,
+  ROUTING_CALC_INITIAL_DELAY_MAX = 15000
+};
+
+enum {
+  ROUTING_CALC_HOLD_TIME_MIN = 0,
+  ROUTING_CALC_HOLD_TIME_DEFAULT = 1000,
+  ROUTING_CALC_HOLD_TIME_MAX = 15000
+};
+
+enum {
+  ROUTING_CALC_THREADS_MIN = 0,
+  ROUTING_CALC_THREADS_DEFAULT = 1,
+  ROUTING_CALC_THREADS_MAX = 64
+};
+
 
 enum {
   FACE_DATASET_FETCH_TRIES_MIN = 1,
@@ -129,6 +155,9 @@ enum {
 class ConfParameter
 {
 public:
+  /*! The area that connects all the other areas. */
+  static const std::string BACKBONE_AREA;
+
   ConfParameter(ndn::Face& face, ndn::KeyChain& keyChain,
                 const std::string& confFileName = "nlsr.conf");
 
@@ -171,6 +200,83 @@ public:
     return m_siteName;
   }
 
+  /*! \brief Sets the routing area of this router and scopes the sync group to it.
+    \param area The area ID, or an empty string if the network is not divided into areas.
+  */
+  void
+  setArea(const std::string& area);
+
+  const std::string&
+  getArea() const
+  {
+    return m_area;
+  }
+
+  void
+  setAreaBorderRouter(bool isAreaBorderRouter)
+  {
+    m_isAreaBorderRouter = isAreaBorderRouter;
+  }
+
+  /*! \brief Returns whether this router joins the backbone area in addition to its own area.
+  */
+  bool
+  isAreaBorderRouter() const
+  {
+    return m_isAreaBorderRouter;
+  }
+
+  /*! \brief Returns whether this router takes part in the link-state routing of \p area.
+  */
+  bool
+  isInArea(const std::string& area) const
+  {
+    return area == m_area || (m_isAreaBorderRouter && area == BACKBONE_AREA);
+  }
+
+  /*! \brief Returns the sync prefix of the routers of \p area.
+  */
+  ndn::Name
+  getAreaSyncPrefix(const std::string& area) const;
+
+  void
+  setStubRouter(bool isStubRouter)
+  {
+    m_isStubRouter = isStubRouter;
+  }
+
+  /*! \brief Returns whether this router only routes toward its neighbors, without the
+             name prefixes of the other routers.
+  */
+  bool
+  isStubRouter() const
+  {
+    return m_isStubRouter;
+  }
+
+  void
+  addStubPrefix(const ndn::Name& prefix)
+  {
+    m_stubPrefixes.push_back(prefix);
+  }
+
+  /*! \brief Returns the name prefixes that a stub router still learns from other routers.
+  */
+  const std::vector<ndn::Name>&
+  getStubPrefixes() const
+  {
+    return m_stubPrefixes;
+  }
+
+  /*! \brief Returns whether a stub router installs the routes of \p name.
+  */
+  bool
+  isStubPrefix(const ndn::Name& name) const
+  {
+    return std::any_of(m_stubPrefixes.begin(), m_stubPrefixes.end(),
+                       [&name] (const ndn::Name& prefix) { return prefix.isPrefixOf(name); });
+  }
+
   void
   buildRouterAndSyncUserPrefix()
   {
@@ -231,6 +337,21 @@ public:
     return m_lsaRefreshTime;
   }
 
+  void
+  setLsdbSnapshotInterval(uint32_t interval)
+  {
+    m_lsdbSnapshotInterval = interval;
+  }
+
+  /*! \brief Returns how often, in seconds, the LSDB is written to the state directory;
+             0 disables the snapshots.
+  */
+  uint32_t
+  getLsdbSnapshotInterval() const
+  {
+    return m_lsdbSnapshotInterval;
+  }
+
   void
   setLsaInterestLifetime(const ndn::time::seconds& lifetime)
   {
@@ -267,6 +388,42 @@ public:
     return m_routingCalcInterval;
   }
 
+  void
+  setRoutingCalcInitialDelay(uint32_t delay)
+  {
+    m_routingCalcInitialDelay = delay;
+  }
+
+  uint32_t
+  getRoutingCalcInitialDelay() const
+  {
+    return m_routingCalcInitialDelay;
+  }
+
+  void
+  setRoutingCalcHoldTime(uint32_t holdTime)
+  {
+    m_routingCalcHoldTime = holdTime;
+  }
+
+  uint32_t
+  getRoutingCalcHoldTime() const
+  {
+    return m_routingCalcHoldTime;
+  }
+
+  void
+  setRoutingCalcThreads(uint32_t nThreads)
+  {
+    m_routingCalcThreads = nThreads;
+  }
+
+  uint32_t
+  getRoutingCalcThreads() const
+  {
+    return m_routingCalcThreads;
+  }
+
   void
   setRouterDeadInterval(uint32_t rdt)
   {
@@ -391,6 +548,21 @@ public:
     return m_maxFacesPerPrefix;
   }
 
+  void
+  setFastReroute(bool fastReroute)
+  {
+    m_fastReroute = fastReroute;
+  }
+
+  /*! \brief Returns whether loop-free alternates are calculated and installed as soon as
+             the face of a next hop is destroyed.
+  */
+  bool
+  getFastReroute() const
+  {
+    return m_fastReroute;
+  }
+
   void
   setStateFileDir(const std::string& ssfd)
   {
@@ -403,6 +575,21 @@ public:
     return m_stateFileDir;
   }
 
+  void
+  setStateFsync(bool isStateFsync)
+  {
+    m_isStateFsync = isStateFsync;
+  }
+
+  /*! \brief Returns whether state files are flushed to the disk before they replace the
+             previous ones.
+  */
+  bool
+  isStateFsync() const
+  {
+    return m_isStateFsync;
+  }
+
   void
   setConfFileNameDynamic(const std::string& confFileDynamic)
   {
@@ -433,12 +620,32 @@ public:
     return m_adjl;
   }
 
+  const AdjacencyList&
+  getAdjacencyList() const
+  {
+    return m_adjl;
+  }
+
   NamePrefixList&
   getNamePrefixList()
   {
     return m_npl;
   }
 
+  /*! \brief Adds a rule that advertises \p aggregate instead of the names under it.
+  */
+  void
+  addAggregationRule(const ndn::Name& aggregate)
+  {
+    m_aggregationRules.push_back(aggregate);
+  }
+
+  const std::vector<ndn::Name>&
+  getAggregationRules() const
+  {
+    return m_aggregationRules;
+  }
+
   ndn::security::ValidatorConfig&
   getValidator()
   {
@@ -494,6 +701,10 @@ private:
   ndn::Name m_routerName;
   ndn::Name m_siteName;
   ndn::Name m_network;
+  std::string m_area;
+  bool m_isAreaBorderRouter;
+  bool m_isStubRouter;
+  std::vector<ndn::Name> m_stubPrefixes;
 
   ndn::Name m_routerPrefix;
   ndn::Name m_syncUserPrefix;
@@ -502,9 +713,13 @@ private:
   ndn::Name m_lsaPrefix;
 
   uint32_t  m_lsaRefreshTime;
+  uint32_t m_lsdbSnapshotInterval;
 
   uint32_t m_adjLsaBuildInterval;
   uint32_t m_routingCalcInterval;
+  uint32_t m_routingCalcInitialDelay;
+  uint32_t m_routingCalcHoldTime;
+  uint32_t m_routingCalcThreads;
 
   uint32_t m_faceDatasetFetchTries;
   ndn::time::seconds m_faceDatasetFetchInterval;
@@ -522,8 +737,10 @@ private:
   std::vector<double> m_corTheta;
 
   uint32_t m_maxFacesPerPrefix;
+  bool m_fastReroute;
 
   std::string m_stateFileDir;
+  bool m_isStateFsync;
 
   ndn::time::milliseconds m_syncInterestLifetime;
 
@@ -534,6 +751,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
 
   AdjacencyList m_adjl;
   NamePrefixList m_npl;
+  std::vector<ndn::Name> m_aggregationRules;
   ndn::security::ValidatorConfig m_validator;
   ndn::security::ValidatorConfig m_prefixUpdateValidator;
   ndn::security::SigningInfo m_signingInfo;
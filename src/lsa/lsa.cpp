@@ -39,6 +39,8 @@ Lsa::Lsa(const Lsa& lsa)
   : m_originRouter(lsa.getOriginRouter())
   , m_seqNo(lsa.getSeqNo())
   , m_expirationTimePoint(lsa.getExpirationTimePoint())
+  , m_area(lsa.getArea())
+  , m_originRouterId(lsa.m_originRouterId)
 {
 }
 
@@ -48,6 +50,10 @@ Lsa::wireEncode(ndn::EncodingImpl<TAG>& encoder) const
 {
   size_t totalLength = 0;
 
+  if (!m_area.empty()) {
+    totalLength += prependStringBlock(encoder, ndn::tlv::nlsr::Area, m_area);
+  }
+
   totalLength += prependStringBlock(encoder,
                                     ndn::tlv::nlsr::ExpirationTime,
                                     ndn::time::toString(m_expirationTimePoint));
@@ -68,7 +74,9 @@ void
 Lsa::wireDecode(const ndn::Block& wire)
 {
   m_originRouter.clear();
+  m_originRouterId.reset();
   m_seqNo = 0;
+  m_area.clear();
 
   ndn::Block baseWire = wire;
   baseWire.parse();
@@ -94,10 +102,16 @@ Lsa::wireDecode(const ndn::Block& wire)
 
   if (val != baseWire.elements_end() && val->type() == ndn::tlv::nlsr::ExpirationTime) {
     m_expirationTimePoint = ndn::time::fromString(readString(*val));
+    ++val;
   }
   else {
     NDN_THROW(Error("Missing required ExpirationTime field"));
   }
+
+  // The area is left out by routers that do not divide the network into areas
+  if (val != baseWire.elements_end() && val->type() == ndn::tlv::nlsr::Area) {
+    m_area = readString(*val);
+  }
 }
 
 std::ostream&
@@ -113,6 +127,9 @@ operator<<(std::ostream& os, const Lsa::Type& type)
   case Lsa::Type::NAME:
     os << "NAME";
     break;
+  case Lsa::Type::SUMMARY:
+    os << "SUMMARY";
+    break;
   default:
     os << "BASE";
     break;
@@ -134,6 +151,9 @@ operator>>(std::istream& is, Lsa::Type& type)
   else if (typeString == "NAME") {
     type = Lsa::Type::NAME;
   }
+  else if (typeString == "SUMMARY") {
+    type = Lsa::Type::SUMMARY;
+  }
   else {
     type = Lsa::Type::BASE;
   }
@@ -147,8 +167,11 @@ Lsa::getString() const
   auto duration = m_expirationTimePoint - ndn::time::system_clock::now();
   os << "    " << getType() << " LSA:\n"
      << "      Origin Router      : " << m_originRouter << "\n"
-     << "      Sequence Number    : " << m_seqNo << "\n"
-     << "      Expires in         : " << ndn::time::duration_cast<ndn::time::milliseconds>(duration)
+     << "      Sequence Number    : " << m_seqNo << "\n";
+  if (!m_area.empty()) {
+    os << "      Area               : " << m_area << "\n";
+  }
+  os << "      Expires in         : " << ndn::time::duration_cast<ndn::time::milliseconds>(duration)
      << "\n";
   return os.str();
 }
@@ -25,6 +25,7 @@
 #include "name-prefix-list.hpp"
 #include "adjacent.hpp"
 #include "adjacency-list.hpp"
+#include "router-id.hpp"
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
@@ -37,6 +38,7 @@ namespace nlsr {
             Name
             SequenceNumber
             ExpirationTimePoint
+            Area?
  */
 class Lsa
 {
@@ -51,6 +53,7 @@ public:
     ADJACENCY,
     COORDINATE,
     NAME,
+    SUMMARY,
     BASE
   };
 
@@ -88,10 +91,11 @@ public:
     return m_originRouter;
   }
 
-  ndn::Name
-  getOriginRouterCopy() const
+  /*! \brief Returns the router ID of the origin router, interning it on first use. */
+  RouterId
+  getOriginRouterId() const
   {
-    return m_originRouter;
+    return m_originRouterId.intern(m_originRouter);
   }
 
   const ndn::time::system_clock::TimePoint&
@@ -107,6 +111,22 @@ public:
     m_wire.reset();
   }
 
+  /*! \brief Returns the routing area of the origin router, or an empty string if the
+             network is not divided into areas.
+   */
+  const std::string&
+  getArea() const
+  {
+    return m_area;
+  }
+
+  void
+  setArea(const std::string& area)
+  {
+    m_area = area;
+    m_wire.reset();
+  }
+
   void
   setExpiringEventId(ndn::scheduler::EventId eid)
   {
@@ -139,9 +159,13 @@ PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   ndn::Name m_originRouter;
   uint64_t m_seqNo = 0;
   ndn::time::system_clock::TimePoint m_expirationTimePoint;
+  std::string m_area;
   ndn::scheduler::ScopedEventId m_expiringEventId;
 
   mutable ndn::Block m_wire;
+
+private:
+  mutable RouterIdRef m_originRouterId;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(Lsa);
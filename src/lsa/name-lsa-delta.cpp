@@ -0,0 +1,201 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "name-lsa-delta.hpp"
+#include "tlv-nlsr.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+
+NameLsaDelta::NameLsaDelta(const ndn::Name& originRouter, uint64_t seqNo, uint64_t baseSeqNo,
+                           const ndn::time::system_clock::TimePoint& timepoint,
+                           const std::list<ndn::Name>& addedNames,
+                           const std::list<ndn::Name>& removedNames)
+  : Lsa(originRouter, seqNo, timepoint)
+  , m_baseSeqNo(baseSeqNo)
+  , m_addedNames(addedNames)
+  , m_removedNames(removedNames)
+{
+}
+
+NameLsaDelta::NameLsaDelta(const ndn::Block& block)
+{
+  wireDecode(block);
+}
+
+void
+NameLsaDelta::append(const NameLsaDelta& next)
+{
+  m_wire.reset();
+
+  for (const auto& name : next.getAddedNames()) {
+    auto it = std::find(m_removedNames.begin(), m_removedNames.end(), name);
+    if (it != m_removedNames.end()) {
+      m_removedNames.erase(it);
+    }
+    else {
+      m_addedNames.push_back(name);
+    }
+  }
+
+  for (const auto& name : next.getRemovedNames()) {
+    auto it = std::find(m_addedNames.begin(), m_addedNames.end(), name);
+    if (it != m_addedNames.end()) {
+      m_addedNames.erase(it);
+    }
+    else {
+      m_removedNames.push_back(name);
+    }
+  }
+
+  m_seqNo = next.getSeqNo();
+  m_expirationTimePoint = next.getExpirationTimePoint();
+  m_area = next.getArea();
+}
+
+template<ndn::encoding::Tag TAG>
+size_t
+NameLsaDelta::wireEncode(ndn::EncodingImpl<TAG>& block) const
+{
+  size_t totalLength = 0;
+
+  auto prependNames = [&block] (uint32_t type, const std::list<ndn::Name>& names) {
+    size_t length = 0;
+    for (auto it = names.rbegin(); it != names.rend(); ++it) {
+      length += it->wireEncode(block);
+    }
+    length += block.prependVarNumber(length);
+    length += block.prependVarNumber(type);
+    return length;
+  };
+
+  totalLength += prependNames(ndn::tlv::nlsr::RemovedNames, m_removedNames);
+  totalLength += prependNames(ndn::tlv::nlsr::AddedNames, m_addedNames);
+  totalLength += prependNonNegativeIntegerBlock(block, ndn::tlv::nlsr::BaseSequenceNumber,
+                                                m_baseSeqNo);
+
+  totalLength += Lsa::wireEncode(block);
+
+  totalLength += block.prependVarNumber(totalLength);
+  totalLength += block.prependVarNumber(ndn::tlv::nlsr::NameLsaDelta);
+
+  return totalLength;
+}
+
+NDN_CXX_DEFINE_WIRE_ENCODE_INSTANTIATIONS(NameLsaDelta);
+
+const ndn::Block&
+NameLsaDelta::wireEncode() const
+{
+  if (m_wire.hasWire()) {
+    return m_wire;
+  }
+
+  ndn::EncodingEstimator estimator;
+  size_t estimatedSize = wireEncode(estimator);
+
+  ndn::EncodingBuffer buffer(estimatedSize, 0);
+  wireEncode(buffer);
+
+  m_wire = buffer.block();
+
+  return m_wire;
+}
+
+void
+NameLsaDelta::wireDecode(const ndn::Block& wire)
+{
+  m_wire = wire;
+
+  if (m_wire.type() != ndn::tlv::nlsr::NameLsaDelta) {
+    NDN_THROW(Error("NameLsaDelta", m_wire.type()));
+  }
+
+  m_wire.parse();
+
+  auto val = m_wire.elements_begin();
+
+  if (val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::Lsa) {
+    Lsa::wireDecode(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required Lsa field"));
+  }
+
+  if (val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::BaseSequenceNumber) {
+    m_baseSeqNo = ndn::readNonNegativeInteger(*val);
+    ++val;
+  }
+  else {
+    NDN_THROW(Error("Missing required BaseSequenceNumber field"));
+  }
+
+  auto readNames = [&val, this] (uint32_t type, std::list<ndn::Name>& names) {
+    if (val == m_wire.elements_end() || val->type() != type) {
+      NDN_THROW(Error("Missing required names field of type " + std::to_string(type)));
+    }
+    names.clear();
+    val->parse();
+    for (const auto& element : val->elements()) {
+      if (element.type() != ndn::tlv::Name) {
+        NDN_THROW(Error("Name", element.type()));
+      }
+      names.emplace_back(element);
+    }
+    ++val;
+  };
+
+  readNames(ndn::tlv::nlsr::AddedNames, m_addedNames);
+  readNames(ndn::tlv::nlsr::RemovedNames, m_removedNames);
+}
+
+std::string
+NameLsaDelta::toString() const
+{
+  std::ostringstream os;
+  os << getString();
+  os << "      Base Sequence Number : " << m_baseSeqNo << "\n";
+  os << "      Added Names:\n";
+  for (const auto& name : m_addedNames) {
+    os << "        " << name << "\n";
+  }
+  os << "      Removed Names:\n";
+  for (const auto& name : m_removedNames) {
+    os << "        " << name << "\n";
+  }
+
+  return os.str();
+}
+
+std::tuple<bool, std::list<ndn::Name>, std::list<ndn::Name>>
+NameLsaDelta::update(const std::shared_ptr<Lsa>& lsa)
+{
+  return std::make_tuple(false, std::list<ndn::Name>{}, std::list<ndn::Name>{});
+}
+
+std::ostream&
+operator<<(std::ostream& os, const NameLsaDelta& delta)
+{
+  return os << delta.toString();
+}
+
+} // namespace nlsr
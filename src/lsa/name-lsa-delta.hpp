@@ -0,0 +1,129 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LSA_NAME_LSA_DELTA_HPP
+#define NLSR_LSA_NAME_LSA_DELTA_HPP
+
+#include "lsa.hpp"
+
+namespace nlsr {
+
+/*!
+   \brief Data abstraction for NameLsaDelta
+
+   A name LSA delta carries the names that a router added to and removed from its name LSA
+   between a base sequence number and the sequence number in its Lsa field. A router that
+   holds the name LSA at the base sequence number applies the delta in place instead of
+   fetching the whole name LSA again.
+
+   NameLsaDelta := NAME-LSA-DELTA-TYPE TLV-LENGTH
+                     Lsa
+                     BaseSequenceNumber
+                     AddedNames
+                     RemovedNames
+
+   AddedNames := ADDED-NAMES-TYPE TLV-LENGTH
+                   Name*
+
+   RemovedNames := REMOVED-NAMES-TYPE TLV-LENGTH
+                     Name*
+ */
+class NameLsaDelta : public Lsa
+{
+public:
+  NameLsaDelta() = default;
+
+  NameLsaDelta(const ndn::Name& originRouter, uint64_t seqNo, uint64_t baseSeqNo,
+               const ndn::time::system_clock::TimePoint& timepoint,
+               const std::list<ndn::Name>& addedNames,
+               const std::list<ndn::Name>& removedNames);
+
+  NameLsaDelta(const ndn::Block& block);
+
+  /*! \brief Returns the type of the LSA that the delta changes. */
+  Lsa::Type
+  getType() const override
+  {
+    return Lsa::Type::NAME;
+  }
+
+  uint64_t
+  getBaseSeqNo() const
+  {
+    return m_baseSeqNo;
+  }
+
+  const std::list<ndn::Name>&
+  getAddedNames() const
+  {
+    return m_addedNames;
+  }
+
+  const std::list<ndn::Name>&
+  getRemovedNames() const
+  {
+    return m_removedNames;
+  }
+
+  /*! \brief Returns whether the delta changes no name. */
+  bool
+  isEmpty() const
+  {
+    return m_addedNames.empty() && m_removedNames.empty();
+  }
+
+  /*! \brief Appends \p next, which starts where this delta ends.
+
+    A name that one delta adds and the other removes cancels out.
+   */
+  void
+  append(const NameLsaDelta& next);
+
+  template<ndn::encoding::Tag TAG>
+  size_t
+  wireEncode(ndn::EncodingImpl<TAG>& block) const;
+
+  const ndn::Block&
+  wireEncode() const override;
+
+  void
+  wireDecode(const ndn::Block& wire);
+
+  std::string
+  toString() const override;
+
+  /*! \brief Does nothing; a delta is applied to a name LSA by the LSDB, never installed. */
+  std::tuple<bool, std::list<ndn::Name>, std::list<ndn::Name>>
+  update(const std::shared_ptr<Lsa>& lsa) override;
+
+private:
+  uint64_t m_baseSeqNo = 0;
+  std::list<ndn::Name> m_addedNames;
+  std::list<ndn::Name> m_removedNames;
+};
+
+NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(NameLsaDelta);
+
+std::ostream&
+operator<<(std::ostream& os, const NameLsaDelta& delta);
+
+} // namespace nlsr
+
+#endif // NLSR_LSA_NAME_LSA_DELTA_HPP
@@ -54,7 +54,7 @@ NameLsa::wireEncode(ndn::EncodingImpl<TAG>& block) const
   totalLength += Lsa::wireEncode(block);
 
   totalLength += block.prependVarNumber(totalLength);
-  totalLength += block.prependVarNumber(ndn::tlv::nlsr::NameLsa);
+  totalLength += block.prependVarNumber(getTlvType());
 
   return totalLength;
 }
@@ -84,7 +84,7 @@ NameLsa::wireDecode(const ndn::Block& wire)
 {
   m_wire = wire;
 
-  if (m_wire.type() != ndn::tlv::nlsr::NameLsa) {
+  if (m_wire.type() != getTlvType()) {
     NDN_THROW(Error("NameLsa", m_wire.type()));
   }
 
@@ -112,6 +112,12 @@ NameLsa::wireDecode(const ndn::Block& wire)
   m_npl = npl;
 }
 
+uint32_t
+NameLsa::getTlvType() const
+{
+  return ndn::tlv::nlsr::NameLsa;
+}
+
 bool
 NameLsa::isEqualContent(const NameLsa& other) const
 {
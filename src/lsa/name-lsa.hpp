@@ -100,6 +100,11 @@ public:
   std::tuple<bool, std::list<ndn::Name>, std::list<ndn::Name>>
   update(const std::shared_ptr<Lsa>& lsa) override;
 
+protected:
+  /*! \brief Returns the TLV type that encloses the encoded LSA. */
+  virtual uint32_t
+  getTlvType() const;
+
 private:
   NamePrefixList m_npl;
 };
@@ -0,0 +1,68 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_LSA_SUMMARY_LSA_HPP
+#define NLSR_LSA_SUMMARY_LSA_HPP
+
+#include "name-lsa.hpp"
+
+namespace nlsr {
+
+/*!
+   \brief Data abstraction for SummaryLsa
+
+   An area border router advertises the name prefixes of the routers in its own area
+   with a summary LSA, which carries that area in its Lsa field.
+
+   SummaryLsa := SUMMARY-LSA-TYPE TLV-LENGTH
+                   Lsa
+                   Name*
+ */
+class SummaryLsa : public NameLsa
+{
+public:
+  SummaryLsa() = default;
+
+  SummaryLsa(const ndn::Name& originRouter, uint64_t seqNo,
+             const ndn::time::system_clock::TimePoint& timepoint,
+             const NamePrefixList& npl);
+
+  SummaryLsa(const ndn::Block& block);
+
+  Lsa::Type
+  getType() const override
+  {
+    return type();
+  }
+
+  static constexpr Lsa::Type
+  type()
+  {
+    return Lsa::Type::SUMMARY;
+  }
+
+protected:
+  uint32_t
+  getTlvType() const override;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_LSA_SUMMARY_LSA_HPP
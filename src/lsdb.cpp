@@ -23,8 +23,21 @@
 
 #include "logger.hpp"
 #include "nlsr.hpp"
+#include "tlv-nlsr.hpp"
 #include "utility/name-helper.hpp"
 
+#include <boost/lexical_cast.hpp>
+
+#include <algorithm>
+#include <cerrno>
+#include <cstdio>
+#include <fstream>
+#include <future>
+#include <iterator>
+
+#include <fcntl.h>
+#include <unistd.h>
+
 namespace nlsr {
 
 INIT_LOGGER(Lsdb);
@@ -32,6 +45,8 @@ INIT_LOGGER(Lsdb);
 const ndn::time::steady_clock::TimePoint Lsdb::DEFAULT_LSA_RETRIEVAL_DEADLINE =
   ndn::time::steady_clock::TimePoint::min();
 
+constexpr size_t Lsdb::NAME_LSA_DELTA_HISTORY;
+
 Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   : m_face(face)
   , m_scheduler(face.getIoService())
@@ -44,17 +59,28 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_lsaRefreshTime(ndn::time::seconds(m_confParam.getLsaRefreshTime()))
   , m_adjLsaBuildInterval(m_confParam.getAdjLsaBuildInterval())
   , m_thisRouterPrefix(m_confParam.getRouterPrefix())
-  , m_sequencingManager(m_confParam.getStateFileDir(), m_confParam.getHyperbolicState())
+  , m_sequencingManager(m_confParam.getStateFileDir(), m_confParam.getHyperbolicState(),
+                        m_confParam.isStateFsync())
   , m_onNewLsaConnection(m_sync.onNewLsa->connect(
       [this] (const ndn::Name& updateName, uint64_t sequenceNumber,
               const ndn::Name& originRouter) {
         ndn::Name lsaInterest{updateName};
         lsaInterest.appendNumber(sequenceNumber);
+
+        // A router that holds an older name LSA only asks for the changes since then
+        Lsa::Type lsaType;
+        std::istringstream(updateName[-1].toUri()) >> lsaType;
+        if (lsaType == Lsa::Type::NAME) {
+          if (auto nameLsa = findLsa<NameLsa>(originRouter)) {
+            lsaInterest = getNameLsaDeltaName(updateName, sequenceNumber, nameLsa->getSeqNo());
+          }
+        }
         expressInterest(lsaInterest, 0);
       }))
   , m_segmentPublisher(m_face, keyChain)
   , m_isBuildAdjLsaScheduled(false)
   , m_adjBuildCount(0)
+  , m_snapshotWriter(m_confParam.getLsdbSnapshotInterval() > 0 ? 1 : 0)
 {
   ndn::Name name = m_confParam.getLsaPrefix();
   NLSR_LOG_DEBUG("Setting interest filter for LsaPrefix: " << name);
@@ -69,17 +95,200 @@ Lsdb::Lsdb(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
     m_confParam.getSigningInfo(), ndn::nfd::ROUTE_FLAG_CAPTURE);
 
   buildAndInstallOwnNameLsa();
+  // The summary LSA tells the routers of the area that this router is their border router
+  if (m_confParam.isAreaBorderRouter()) {
+    buildAndInstallOwnSummaryLsa();
+  }
   // Install coordinate LSAs if using HR or dry-run HR.
   if (m_confParam.getHyperbolicState() != HYPERBOLIC_STATE_OFF) {
     buildAndInstallOwnCoordinateLsa();
   }
+
+  if (m_confParam.getLsdbSnapshotInterval() > 0) {
+    scheduleSnapshot();
+  }
+}
+
+std::string
+Lsdb::getSnapshotFileName() const
+{
+  return m_confParam.getStateFileDir() + "/nlsrLsdb.bin";
+}
+
+void
+Lsdb::scheduleSnapshot()
+{
+  m_snapshotEvent = m_scheduler.schedule(
+    ndn::time::seconds(m_confParam.getLsdbSnapshotInterval()), [this] {
+      writeSnapshot();
+      scheduleSnapshot();
+    });
+}
+
+/*! \brief Replaces \p fileName with the concatenation of \p blocks.
+  \return The number of blocks written, or -1 on error.
+ */
+static ssize_t
+writeSnapshotFile(const std::string& fileName, const std::vector<ndn::Block>& blocks,
+                  bool shouldFsync)
+{
+  std::string tempFileName = fileName + ".tmp";
+  int fd = ::open(tempFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    NLSR_LOG_WARN("Cannot open " << tempFileName);
+    return -1;
+  }
+
+  bool isWritten = true;
+  for (auto block = blocks.begin(); isWritten && block != blocks.end(); ++block) {
+    const uint8_t* data = block->wire();
+    size_t size = block->size();
+    while (size > 0) {
+      ssize_t n = ::write(fd, data, size);
+      if (n < 0 && errno == EINTR) {
+        continue;
+      }
+      if (n <= 0) {
+        isWritten = false;
+        break;
+      }
+      data += n;
+      size -= n;
+    }
+  }
+  isWritten = isWritten && (!shouldFsync || ::fsync(fd) == 0);
+  isWritten = ::close(fd) == 0 && isWritten;
+  if (!isWritten) {
+    NLSR_LOG_WARN("Cannot write LSDB snapshot to " << tempFileName);
+    return -1;
+  }
+
+  if (std::rename(tempFileName.c_str(), fileName.c_str()) != 0) {
+    NLSR_LOG_WARN("Cannot rename LSDB snapshot to " << fileName);
+    return -1;
+  }
+  return static_cast<ssize_t>(blocks.size());
+}
+
+void
+Lsdb::writeSnapshot()
+{
+  std::vector<ndn::Block> blocks;
+  blocks.reserve(m_lsdb.size());
+  for (const auto& lsa : m_lsdb) {
+    // Own LSAs are built anew, with higher sequence numbers, after a restart
+    if (lsa->getOriginRouter() != m_thisRouterPrefix) {
+      blocks.push_back(lsa->wireEncode());
+    }
+  }
+
+  // The blocks keep their buffers alive; an LSA that changes later is encoded into a new one
+  auto write = [fileName = getSnapshotFileName(), blocks = std::move(blocks),
+                shouldFsync = m_confParam.isStateFsync()] {
+    ssize_t nLsas = writeSnapshotFile(fileName, blocks, shouldFsync);
+    if (nLsas >= 0) {
+      NLSR_LOG_DEBUG("Wrote " << nLsas << " LSAs to " << fileName);
+    }
+  };
+
+  if (m_snapshotWriter.getNThreads() == 0) {
+    write();
+  }
+  else {
+    m_snapshotWriter.post(std::move(write));
+  }
+}
+
+void
+Lsdb::flushSnapshot()
+{
+  if (m_confParam.getLsdbSnapshotInterval() == 0) {
+    return;
+  }
+
+  m_snapshotEvent.cancel();
+  writeSnapshot();
+
+  // The writer runs its jobs in order, so this one runs after the write
+  std::promise<void> isWritten;
+  m_snapshotWriter.post([&isWritten] { isWritten.set_value(); });
+  isWritten.get_future().wait();
+}
+
+void
+Lsdb::loadSnapshot()
+{
+  std::ifstream file(getSnapshotFileName(), std::ios::binary);
+  if (!file) {
+    return;
+  }
+  std::vector<uint8_t> buffer((std::istreambuf_iterator<char>(file)),
+                              std::istreambuf_iterator<char>());
+
+  auto now = ndn::time::system_clock::now();
+  size_t nLoaded = 0;
+  size_t offset = 0;
+  try {
+    while (offset < buffer.size()) {
+      ndn::Block block(buffer.data() + offset, buffer.size() - offset);
+      offset += block.size();
+
+      std::shared_ptr<Lsa> lsa;
+      switch (block.type()) {
+      case ndn::tlv::nlsr::NameLsa:
+        lsa = std::make_shared<NameLsa>(block);
+        break;
+      case ndn::tlv::nlsr::AdjacencyLsa:
+        lsa = std::make_shared<AdjLsa>(block);
+        break;
+      case ndn::tlv::nlsr::CoordinateLsa:
+        lsa = std::make_shared<CoordinateLsa>(block);
+        break;
+      case ndn::tlv::nlsr::SummaryLsa:
+        lsa = std::make_shared<SummaryLsa>(block);
+        break;
+      default:
+        NLSR_LOG_WARN("Unknown TLV type " << block.type() << " in LSDB snapshot");
+        continue;
+      }
+
+      if (lsa->getExpirationTimePoint() <= now ||
+          lsa->getOriginRouter() == m_thisRouterPrefix ||
+          !isLsaNew(lsa->getOriginRouter(), lsa->getType(), lsa->getSeqNo())) {
+        continue;
+      }
+      installLsa(lsa);
+      ++nLoaded;
+    }
+  }
+  catch (const std::exception& e) {
+    // A damaged tail only loses the LSAs after it; sync fetches them again
+    NLSR_LOG_WARN("LSDB snapshot decoding error: " << e.what());
+  }
+  NLSR_LOG_INFO("Loaded " << nLoaded << " LSAs from the LSDB snapshot");
 }
 
 void
 Lsdb::buildAndInstallOwnNameLsa()
 {
+  const auto& rules = m_confParam.getAggregationRules();
+  NamePrefixList npl = rules.empty() ? m_confParam.getNamePrefixList() : aggregateOwnNames();
+
+  // Without aggregation every change of the list is a new name LSA
+  auto ownNameLsa = findLsa<NameLsa>(m_thisRouterPrefix);
+  if (!rules.empty() && ownNameLsa != nullptr) {
+    auto advertised = ownNameLsa->getNpl().getNames();
+    auto names = npl.getNames();
+    if (std::set<ndn::Name>(advertised.begin(), advertised.end()) ==
+        std::set<ndn::Name>(names.begin(), names.end())) {
+      NLSR_LOG_TRACE("Aggregated Name LSA has not changed");
+      return;
+    }
+  }
+
   NameLsa nameLsa(m_thisRouterPrefix, m_sequencingManager.getNameLsaSeq() + 1,
-                  getLsaExpirationTimePoint(), m_confParam.getNamePrefixList());
+                  getLsaExpirationTimePoint(), npl);
+  nameLsa.setArea(m_confParam.getArea());
   m_sequencingManager.increaseNameLsaSeq();
   m_sequencingManager.writeSeqNoToFile();
   m_sync.publishRoutingUpdate(Lsa::Type::NAME, m_sequencingManager.getNameLsaSeq());
@@ -87,12 +296,88 @@ Lsdb::buildAndInstallOwnNameLsa()
   installLsa(std::make_shared<NameLsa>(nameLsa));
 }
 
+NamePrefixList
+Lsdb::aggregateOwnNames()
+{
+  // The table is rebuilt from the whole list, so an aggregate disappears with its last name
+  m_suppressedNames.clear();
+  NamePrefixList npl;
+  for (const auto& name : m_confParam.getNamePrefixList().getNames()) {
+    // The shortest covering rule suppresses the most names
+    const ndn::Name* aggregate = nullptr;
+    for (const auto& rule : m_confParam.getAggregationRules()) {
+      if (rule.size() < name.size() && rule.isPrefixOf(name) &&
+          (aggregate == nullptr || rule.size() < aggregate->size())) {
+        aggregate = &rule;
+      }
+    }
+
+    if (aggregate == nullptr) {
+      npl.insert(name);
+    }
+    else {
+      m_suppressedNames[*aggregate].insert(name);
+    }
+  }
+
+  for (const auto& entry : m_suppressedNames) {
+    NLSR_LOG_DEBUG("Advertising " << entry.first << " for " << entry.second.size() << " names");
+    npl.insert(entry.first);
+  }
+  return npl;
+}
+
+void
+Lsdb::recordOwnNameLsaDelta(const Lsa& nameLsa, uint64_t baseSeqNo,
+                            const std::list<ndn::Name>& addedNames,
+                            const std::list<ndn::Name>& removedNames)
+{
+  if (!m_ownNameLsaDeltas.empty() && m_ownNameLsaDeltas.back().getSeqNo() != baseSeqNo) {
+    m_ownNameLsaDeltas.clear();
+  }
+
+  NameLsaDelta delta(m_thisRouterPrefix, nameLsa.getSeqNo(), baseSeqNo,
+                     nameLsa.getExpirationTimePoint(), addedNames, removedNames);
+  delta.setArea(nameLsa.getArea());
+  m_ownNameLsaDeltas.push_back(delta);
+
+  if (m_ownNameLsaDeltas.size() > NAME_LSA_DELTA_HISTORY) {
+    m_ownNameLsaDeltas.pop_front();
+  }
+}
+
+ndn::optional<NameLsaDelta>
+Lsdb::buildOwnNameLsaDelta(uint64_t baseSeqNo) const
+{
+  auto ownNameLsa = findLsa<NameLsa>(m_thisRouterPrefix);
+  auto it = std::find_if(m_ownNameLsaDeltas.begin(), m_ownNameLsaDeltas.end(),
+                         [baseSeqNo] (const auto& delta) {
+                           return delta.getBaseSeqNo() == baseSeqNo;
+                         });
+  if (ownNameLsa == nullptr || it == m_ownNameLsaDeltas.end()) {
+    return ndn::nullopt;
+  }
+
+  NameLsaDelta delta(*it);
+  for (++it; it != m_ownNameLsaDeltas.end(); ++it) {
+    delta.append(*it);
+  }
+
+  if (delta.getSeqNo() != ownNameLsa->getSeqNo() ||
+      delta.getAddedNames().size() + delta.getRemovedNames().size() >=
+        ownNameLsa->getNpl().size()) {
+    return ndn::nullopt;
+  }
+  return delta;
+}
+
 void
 Lsdb::buildAndInstallOwnCoordinateLsa()
 {
   CoordinateLsa corLsa(m_thisRouterPrefix, m_sequencingManager.getCorLsaSeq() + 1,
                        getLsaExpirationTimePoint(), m_confParam.getCorR(),
                        m_confParam.getCorTheta());
+  corLsa.setArea(m_confParam.getArea());
   m_sequencingManager.increaseCorLsaSeq();
   m_sequencingManager.writeSeqNoToFile();
 
@@ -104,6 +389,61 @@ Lsdb::buildAndInstallOwnCoordinateLsa()
   installLsa(std::make_shared<CoordinateLsa>(corLsa));
 }
 
+void
+Lsdb::buildAndInstallOwnSummaryLsa()
+{
+  std::set<ndn::Name> names;
+  auto nameLsas = m_lsdb.get<byType>().equal_range(Lsa::Type::NAME);
+  for (auto lsaIt = nameLsas.first; lsaIt != nameLsas.second; ++lsaIt) {
+    const auto& nameLsa = static_cast<const NameLsa&>(**lsaIt);
+    if (nameLsa.getOriginRouter() == m_thisRouterPrefix ||
+        nameLsa.getArea() != m_confParam.getArea() ||
+        doesLsaExist(nameLsa.getOriginRouter(), Lsa::Type::SUMMARY)) {
+      continue;
+    }
+    names.insert(nameLsa.getOriginRouter());
+    for (const auto& name : nameLsa.getNpl().getNames()) {
+      names.insert(name);
+    }
+  }
+
+  auto ownSummaryLsa = findLsa<SummaryLsa>(m_thisRouterPrefix);
+  if (ownSummaryLsa != nullptr) {
+    auto advertised = ownSummaryLsa->getNpl().getNames();
+    if (std::set<ndn::Name>(advertised.begin(), advertised.end()) == names) {
+      NLSR_LOG_TRACE("Summary LSA has not changed");
+      return;
+    }
+  }
+
+  NamePrefixList npl;
+  for (const auto& name : names) {
+    npl.insert(name);
+  }
+  SummaryLsa summaryLsa(m_thisRouterPrefix, m_sequencingManager.getSummaryLsaSeq() + 1,
+                        getLsaExpirationTimePoint(), npl);
+  summaryLsa.setArea(m_confParam.getArea());
+  m_sequencingManager.increaseSummaryLsaSeq();
+  m_sequencingManager.writeSeqNoToFile();
+  m_sync.publishRoutingUpdate(Lsa::Type::SUMMARY, m_sequencingManager.getSummaryLsaSeq());
+
+  installLsa(std::make_shared<SummaryLsa>(summaryLsa));
+}
+
+void
+Lsdb::scheduleSummaryLsaBuild(const Lsa& lsa)
+{
+  if (!m_confParam.isAreaBorderRouter() || lsa.getOriginRouter() == m_thisRouterPrefix ||
+      (lsa.getType() != Lsa::Type::NAME && lsa.getType() != Lsa::Type::SUMMARY)) {
+    return;
+  }
+
+  // Changes of several routers are advertised together
+  NLSR_LOG_DEBUG("Scheduling Summary LSA build in " << m_adjLsaBuildInterval);
+  m_scheduledSummaryLsaBuild = m_scheduler.schedule(m_adjLsaBuildInterval,
+                                                    [this] { buildAndInstallOwnSummaryLsa(); });
+}
+
 void
 Lsdb::scheduleAdjLsaBuild()
 {
@@ -128,12 +468,14 @@ Lsdb::scheduleAdjLsaBuild()
 void
 Lsdb::writeLog() const
 {
-  static const Lsa::Type types[] = {Lsa::Type::COORDINATE, Lsa::Type::NAME, Lsa::Type::ADJACENCY};
+  static const Lsa::Type types[] = {Lsa::Type::COORDINATE, Lsa::Type::NAME, Lsa::Type::ADJACENCY,
+                                    Lsa::Type::SUMMARY};
   for (const auto& type : types) {
     if ((type == Lsa::Type::COORDINATE &&
          m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_OFF) ||
         (type == Lsa::Type::ADJACENCY &&
-       m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON)) {
+       m_confParam.getHyperbolicState() == HYPERBOLIC_STATE_ON) ||
+        (type == Lsa::Type::SUMMARY && m_confParam.getArea().empty())) {
       continue;
     }
 
@@ -151,7 +493,8 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
   ndn::Name interestName(interest.getName());
   NLSR_LOG_DEBUG("Interest received for LSA: " << interestName);
 
-  if (interestName[-2].isVersion()) {
+  // The sequence numbers at the end of a delta Interest can look like a version
+  if (interestName[-3] != DELTA_COMPONENT && interestName[-2].isVersion()) {
     // Interest for particular segment
     if (m_segmentPublisher.replyFromStore(interestName)) {
       NLSR_LOG_TRACE("Reply from SegmentPublisher storage");
@@ -161,6 +504,7 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
     interestName = interestName.getSubName(0, interestName.size() - 2);
     NLSR_LOG_TRACE("Interest w/o segment and version: " << interestName);
   }
+  ndn::optional<uint64_t> baseSeqNo = toFullLsaName(interestName);
 
   // increment RCV_LSA_INTEREST
   lsaIncrementSignal(Statistics::PacketType::RCV_LSA_INTEREST);
@@ -187,7 +531,7 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
     }
 
     incrementInterestRcvdStats(interestedLsType);
-    if (processInterestForLsa(interest, originRouter, interestedLsType, seqNo)) {
+    if (processInterestForLsa(interest, originRouter, interestedLsType, seqNo, baseSeqNo)) {
       lsaIncrementSignal(Statistics::PacketType::SENT_LSA_DATA);
     }
   }
@@ -200,13 +544,22 @@ Lsdb::processInterest(const ndn::Name& name, const ndn::Interest& interest)
 
 bool
 Lsdb::processInterestForLsa(const ndn::Interest& interest, const ndn::Name& originRouter,
-                            Lsa::Type lsaType, uint64_t seqNo)
+                            Lsa::Type lsaType, uint64_t seqNo,
+                            ndn::optional<uint64_t> baseSeqNo)
 {
   NLSR_LOG_DEBUG(interest << " received for " << lsaType);
   if (auto lsaPtr = findLsa(originRouter, lsaType)) {
     NLSR_LOG_TRACE("Verifying SeqNo for " << lsaType << " is same as requested.");
     if (lsaPtr->getSeqNo() == seqNo) {
-      m_segmentPublisher.publish(interest.getName(), interest.getName(), lsaPtr->wireEncode(),
+      ndn::Block wire = lsaPtr->wireEncode();
+      // Without a delta the receiver gets the full LSA, which it tells apart by its TLV type
+      if (baseSeqNo && lsaType == Lsa::Type::NAME) {
+        if (auto delta = buildOwnNameLsaDelta(*baseSeqNo)) {
+          NLSR_LOG_TRACE("Sending delta from SeqNo " << *baseSeqNo);
+          wire = delta->wireEncode();
+        }
+      }
+      m_segmentPublisher.publish(interest.getName(), interest.getName(), wire,
                                  m_lsaRefreshTime, m_confParam.getSigningInfo());
       incrementDataSentStats(lsaType);
       return true;
@@ -237,6 +590,7 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
     m_lsdb.emplace(lsa);
 
     onLsdbModified(lsa, LsdbUpdate::INSTALLED, {}, {});
+    scheduleSummaryLsaBuild(*lsa);
 
     lsa->setExpiringEventId(scheduleLsaExpiration(lsa, timeToExpire));
   }
@@ -244,8 +598,10 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
   else if (chkLsa->getSeqNo() < lsa->getSeqNo()) {
     NLSR_LOG_DEBUG("Updating " << lsa->getType() << " LSA:");
     NLSR_LOG_DEBUG(chkLsa->toString());
+    uint64_t baseSeqNo = chkLsa->getSeqNo();
     chkLsa->setSeqNo(lsa->getSeqNo());
     chkLsa->setExpirationTimePoint(lsa->getExpirationTimePoint());
+    chkLsa->setArea(lsa->getArea());
 
     bool updated;
     std::list<ndn::Name> namesToAdd, namesToRemove;
@@ -253,6 +609,10 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
 
     if (updated) {
       onLsdbModified(lsa, LsdbUpdate::UPDATED, namesToAdd, namesToRemove);
+      scheduleSummaryLsaBuild(*lsa);
+    }
+    if (lsa->getType() == Lsa::Type::NAME && lsa->getOriginRouter() == m_thisRouterPrefix) {
+      recordOwnNameLsaDelta(*chkLsa, baseSeqNo, namesToAdd, namesToRemove);
     }
 
     chkLsa->setExpiringEventId(scheduleLsaExpiration(chkLsa, timeToExpire));
@@ -262,7 +622,7 @@ Lsdb::installLsa(std::shared_ptr<Lsa> lsa)
 }
 
 void
-Lsdb::removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt)
+Lsdb::removeLsa(const LsaContainer::index<Lsdb::byRouterId>::type::iterator& lsaIt)
 {
   if (lsaIt != m_lsdb.end()) {
     auto lsaPtr = *lsaIt;
@@ -270,13 +630,17 @@ Lsdb::removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt)
     NLSR_LOG_DEBUG(lsaPtr->toString());
     m_lsdb.erase(lsaIt);
     onLsdbModified(lsaPtr, LsdbUpdate::REMOVED, {}, {});
+    if (lsaPtr->getOriginRouter() != m_thisRouterPrefix) {
+      schedulePruneHighestSeqNo(getLsaName(lsaPtr->getOriginRouter(), lsaPtr->getType()));
+    }
+    scheduleSummaryLsaBuild(*lsaPtr);
   }
 }
 
 void
 Lsdb::removeLsa(const ndn::Name& router, Lsa::Type lsaType)
 {
-  removeLsa(m_lsdb.get<byName>().find(std::make_tuple(router, lsaType)));
+  removeLsa(findLsaIterator(router, lsaType));
 }
 
 void
@@ -328,6 +692,7 @@ Lsdb::buildAndInstallOwnAdjLsa()
                 getLsaExpirationTimePoint(),
                 m_confParam.getAdjacencyList().getNumOfActiveNeighbor(),
                 m_confParam.getAdjacencyList());
+  adjLsa.setArea(m_confParam.getArea());
   m_sequencingManager.increaseAdjLsaSeq();
   m_sequencingManager.writeSeqNoToFile();
 
@@ -352,7 +717,8 @@ Lsdb::expireOrRefreshLsa(std::shared_ptr<Lsa> lsa)
   NLSR_LOG_DEBUG("ExpireOrRefreshLsa called for " << lsa->getType());
   NLSR_LOG_DEBUG("OriginRouter: " << lsa->getOriginRouter() << " Seq No: " << lsa->getSeqNo());
 
-  auto lsaIt = m_lsdb.get<byName>().find(std::make_tuple(lsa->getOriginRouter(), lsa->getType()));
+  auto lsaIt = m_lsdb.get<byRouterId>().find(std::make_tuple(lsa->getOriginRouterId(),
+                                                             lsa->getType()));
 
   // If this name LSA exists in the LSDB
   if (lsaIt != m_lsdb.end()) {
@@ -368,6 +734,10 @@ Lsdb::expireOrRefreshLsa(std::shared_ptr<Lsa> lsa)
         lsaPtr->setSeqNo(lsaPtr->getSeqNo() + 1);
         m_sequencingManager.setLsaSeq(lsaPtr->getSeqNo(), lsaPtr->getType());
         lsaPtr->setExpirationTimePoint(getLsaExpirationTimePoint());
+        if (lsaPtr->getType() == Lsa::Type::NAME) {
+          // Routers holding the previous LSA only need its new sequence number and lifetime
+          recordOwnNameLsaDelta(*lsaPtr, lsaPtr->getSeqNo() - 1, {}, {});
+        }
         NLSR_LOG_DEBUG("Updated LSA:");
         NLSR_LOG_DEBUG(lsaPtr->toString());
         // schedule refreshing event again
@@ -394,27 +764,25 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
   if (deadline == DEFAULT_LSA_RETRIEVAL_DEADLINE) {
     deadline = ndn::time::steady_clock::now() + ndn::time::seconds(static_cast<int>(LSA_REFRESH_TIME_MAX));
   }
+  ndn::Name fullLsaName(interestName);
+  bool isDelta = static_cast<bool>(toFullLsaName(fullLsaName));
   // The first component of the interest is the name.
-  ndn::Name lsaName = interestName.getSubName(0, interestName.size()-1);
+  ndn::Name lsaName = fullLsaName.getSubName(0, fullLsaName.size()-1);
   // The seq no is the last
-  uint64_t seqNo = interestName[-1].toNumber();
+  uint64_t seqNo = fullLsaName[-1].toNumber();
 
-  // If the LSA is not found in the list currently.
-  if (m_highestSeqNo.find(lsaName) == m_highestSeqNo.end()) {
-    m_highestSeqNo[lsaName] = seqNo;
-  }
-  // If the new seq no is higher, that means the LSA is valid
-  else if (seqNo > m_highestSeqNo[lsaName]) {
-    m_highestSeqNo[lsaName] = seqNo;
-  }
-  // Otherwise, its an old/invalid LSA
-  else if (seqNo < m_highestSeqNo[lsaName]) {
+  // An older sequence number than already seen means an old/invalid LSA
+  if (!updateHighestSeqNo(lsaName, seqNo)) {
     return;
   }
 
   ndn::Interest interest(interestName);
   ndn::util::SegmentFetcher::Options options;
   options.interestLifetime = m_confParam.getLsaInterestLifetime();
+  if (isDelta) {
+    // A router that does not know about deltas never answers, so fall back to the full LSA soon
+    options.maxTimeout = options.interestLifetime;
+  }
 
   NLSR_LOG_DEBUG("Fetching Data for LSA: " << interestName << " Seq number: " << seqNo);
   auto fetcher = ndn::util::SegmentFetcher::start(m_face, interest,
@@ -447,10 +815,111 @@ Lsdb::expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
   });
 
   Lsa::Type lsaType;
-  std::istringstream(interestName[-2].toUri()) >> lsaType;
+  std::istringstream(fullLsaName[-2].toUri()) >> lsaType;
   incrementInterestSentStats(lsaType);
 }
 
+ndn::Name
+Lsdb::getLsaName(const ndn::Name& originRouter, Lsa::Type lsaType) const
+{
+  // The inverse of the origin router extraction in afterFetchLsa
+  return ndn::Name(m_confParam.getLsaPrefix())
+           .append(originRouter.getSubName(m_confParam.getNetwork().size()))
+           .append(boost::lexical_cast<std::string>(lsaType));
+}
+
+bool
+Lsdb::updateHighestSeqNo(const ndn::Name& lsaName, uint64_t seqNo)
+{
+  auto it = m_highestSeqNo.find(lsaName);
+  if (it == m_highestSeqNo.end()) {
+    m_highestSeqNo.emplace(lsaName, HighestSeqNo{seqNo, {}});
+    return true;
+  }
+
+  if (seqNo < it->second.seqNo) {
+    return false;
+  }
+  if (seqNo > it->second.seqNo) {
+    NLSR_LOG_TRACE("SeqNo for LSA(name): " << lsaName << " updated to " << seqNo);
+    it->second.seqNo = seqNo;
+  }
+  it->second.pruneEvent.cancel();
+  return true;
+}
+
+void
+Lsdb::schedulePruneHighestSeqNo(const ndn::Name& lsaName)
+{
+  auto it = m_highestSeqNo.find(lsaName);
+  if (it == m_highestSeqNo.end()) {
+    return;
+  }
+
+  it->second.pruneEvent = m_scheduler.schedule(m_lsaRefreshTime, [this, lsaName] {
+    NLSR_LOG_TRACE("Pruning highest SeqNo of " << lsaName);
+    m_highestSeqNo.erase(lsaName);
+  });
+}
+
+ndn::Name
+Lsdb::getNameLsaDeltaName(const ndn::Name& lsaName, uint64_t seqNo, uint64_t baseSeqNo) const
+{
+  return lsaName.getPrefix(-1).append(DELTA_COMPONENT).appendNumber(seqNo)
+                                .appendNumber(baseSeqNo);
+}
+
+ndn::optional<uint64_t>
+Lsdb::toFullLsaName(ndn::Name& interestName) const
+{
+  if (interestName.size() < 3 || interestName[-3] != DELTA_COMPONENT) {
+    return ndn::nullopt;
+  }
+  uint64_t baseSeqNo = interestName[-1].toNumber();
+  uint64_t seqNo = interestName[-2].toNumber();
+  interestName = interestName.getPrefix(-3)
+                   .append(boost::lexical_cast<std::string>(Lsa::Type::NAME))
+                   .appendNumber(seqNo);
+  return baseSeqNo;
+}
+
+bool
+Lsdb::applyNameLsaDelta(const NameLsaDelta& delta)
+{
+  auto nameLsa = findLsa<NameLsa>(delta.getOriginRouter());
+  if (nameLsa == nullptr || nameLsa->getSeqNo() != delta.getBaseSeqNo() ||
+      delta.getSeqNo() <= delta.getBaseSeqNo()) {
+    NLSR_LOG_DEBUG("Cannot apply delta from SeqNo " << delta.getBaseSeqNo() << " to " <<
+                   delta.getOriginRouter());
+    return false;
+  }
+
+  NLSR_LOG_DEBUG("Applying Name LSA delta:");
+  NLSR_LOG_DEBUG(delta.toString());
+  nameLsa->setSeqNo(delta.getSeqNo());
+  nameLsa->setExpirationTimePoint(delta.getExpirationTimePoint());
+  nameLsa->setArea(delta.getArea());
+  for (const auto& name : delta.getAddedNames()) {
+    nameLsa->addName(name);
+  }
+  for (const auto& name : delta.getRemovedNames()) {
+    nameLsa->removeName(name);
+  }
+
+  if (!delta.isEmpty()) {
+    onLsdbModified(nameLsa, LsdbUpdate::UPDATED, delta.getAddedNames(), delta.getRemovedNames());
+    scheduleSummaryLsaBuild(*nameLsa);
+  }
+
+  auto timeToExpire = m_lsaRefreshTime;
+  auto duration = nameLsa->getExpirationTimePoint() - ndn::time::system_clock::now();
+  if (duration > ndn::time::seconds(0)) {
+    timeToExpire = ndn::time::duration_cast<ndn::time::seconds>(duration);
+  }
+  nameLsa->setExpiringEventId(scheduleLsaExpiration(nameLsa, timeToExpire));
+  return true;
+}
+
 void
 Lsdb::onFetchLsaError(uint32_t errorCode, const std::string& msg, const ndn::Name& interestName,
                       uint32_t retransmitNo, const ndn::time::steady_clock::TimePoint& deadline,
@@ -461,7 +930,7 @@ Lsdb::onFetchLsaError(uint32_t errorCode, const std::string& msg, const ndn::Nam
 
   if (ndn::time::steady_clock::now() < deadline) {
     auto it = m_highestSeqNo.find(lsaName);
-    if (it != m_highestSeqNo.end() && it->second == seqNo) {
+    if (it != m_highestSeqNo.end() && it->second.seqNo == seqNo) {
       // If the SegmentFetcher failed due to an Interest timeout, it is safe to re-express
       // immediately since at the least the LSA Interest lifetime has elapsed.
       // Otherwise, it is necessary to delay the Interest re-expression to prevent
@@ -471,10 +940,16 @@ Lsdb::onFetchLsaError(uint32_t errorCode, const std::string& msg, const ndn::Nam
       if (errorCode == ndn::util::SegmentFetcher::ErrorCode::INTEREST_TIMEOUT) {
         delay = ndn::time::seconds(0);
       }
+      // A delta is asked for again as the full LSA, which every router serves
       m_scheduler.schedule(delay, std::bind(&Lsdb::expressInterest, this,
-                                            interestName, retransmitNo + 1, deadline));
+                                            ndn::Name(lsaName).appendNumber(seqNo),
+                                            retransmitNo + 1, deadline));
     }
   }
+  else {
+    // Given up on; a router that left before its LSA was fetched is otherwise never forgotten
+    schedulePruneHighestSeqNo(lsaName);
+  }
 }
 
 void
@@ -483,34 +958,29 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
   NLSR_LOG_DEBUG("Received data for LSA interest: " << interestName);
   lsaIncrementSignal(Statistics::PacketType::RCV_LSA_DATA);
 
-  ndn::Name lsaName = interestName.getSubName(0, interestName.size()-1);
-  uint64_t seqNo = interestName[-1].toNumber();
+  ndn::Name fullLsaName(interestName);
+  bool isDelta = static_cast<bool>(toFullLsaName(fullLsaName));
+  ndn::Name lsaName = fullLsaName.getSubName(0, fullLsaName.size()-1);
+  uint64_t seqNo = fullLsaName[-1].toNumber();
 
-  if (m_highestSeqNo.find(lsaName) == m_highestSeqNo.end()) {
-    m_highestSeqNo[lsaName] = seqNo;
-  }
-  else if (seqNo > m_highestSeqNo[lsaName]) {
-    m_highestSeqNo[lsaName] = seqNo;
-    NLSR_LOG_TRACE("SeqNo for LSA(name): " << interestName << "  updated");
-  }
-  else if (seqNo < m_highestSeqNo[lsaName]) {
+  if (!updateHighestSeqNo(lsaName, seqNo)) {
     return;
   }
 
   std::string chkString("LSA");
-  int32_t lsaPosition = util::getNameComponentPosition(interestName, chkString);
+  int32_t lsaPosition = util::getNameComponentPosition(fullLsaName, chkString);
 
   if (lsaPosition >= 0) {
     // Extracts the prefix of the originating router from the data.
     ndn::Name originRouter = m_confParam.getNetwork();
-    originRouter.append(interestName.getSubName(lsaPosition + 1,
-                                                interestName.size() - lsaPosition - 3));
+    originRouter.append(fullLsaName.getSubName(lsaPosition + 1,
+                                               fullLsaName.size() - lsaPosition - 3));
     try {
       Lsa::Type interestedLsType;
-      std::istringstream(interestName[-2].toUri()) >> interestedLsType;
+      std::istringstream(fullLsaName[-2].toUri()) >> interestedLsType;
 
       if (interestedLsType == Lsa::Type::BASE) {
-        NLSR_LOG_WARN("Received unrecognized LSA Type: " << interestName[-2].toUri());
+        NLSR_LOG_WARN("Received unrecognized LSA Type: " << fullLsaName[-2].toUri());
         return;
       }
 
@@ -518,7 +988,15 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
       if (interestedLsType == Lsa::Type::NAME) {
         lsaIncrementSignal(Statistics::PacketType::RCV_NAME_LSA_DATA);
         if (isLsaNew(originRouter, interestedLsType, seqNo)) {
-          installLsa(std::make_shared<NameLsa>(block));
+          // A delta is only accepted for a delta Interest; decoding it as a name LSA throws,
+          // so the fetch of the full LSA below cannot loop on a delta
+          if (!isDelta || block.type() != ndn::tlv::nlsr::NameLsaDelta) {
+            installLsa(std::make_shared<NameLsa>(block));
+          }
+          // The LSA changed since the delta was asked for, so fetch the full LSA instead
+          else if (!applyNameLsaDelta(NameLsaDelta(block))) {
+            expressInterest(fullLsaName, 0);
+          }
         }
       }
       else if (interestedLsType == Lsa::Type::ADJACENCY) {
@@ -533,6 +1011,11 @@ Lsdb::afterFetchLsa(const ndn::ConstBufferPtr& bufferPtr, const ndn::Name& inter
           installLsa(std::make_shared<CoordinateLsa>(block));
         }
       }
+      else if (interestedLsType == Lsa::Type::SUMMARY) {
+        if (isLsaNew(originRouter, interestedLsType, seqNo)) {
+          installLsa(std::make_shared<SummaryLsa>(block));
+        }
+      }
     }
     catch (const std::exception& e) {
       NLSR_LOG_TRACE("LSA data decoding error :( " << e.what());
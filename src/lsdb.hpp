@@ -25,10 +25,13 @@
 #include "conf-parameter.hpp"
 #include "lsa/lsa.hpp"
 #include "lsa/name-lsa.hpp"
+#include "lsa/name-lsa-delta.hpp"
 #include "lsa/coordinate-lsa.hpp"
 #include "lsa/adj-lsa.hpp"
+#include "lsa/summary-lsa.hpp"
 #include "sequencing-manager.hpp"
 #include "test-access-control.hpp"
+#include "utility/worker-pool.hpp"
 #include "communication/sync-logic-handler.hpp"
 #include "statistics.hpp"
 
@@ -44,6 +47,9 @@
 
 #include <PSync/segment-publisher.hpp>
 
+#include <deque>
+#include <unordered_map>
+
 namespace nlsr {
 
 namespace bmi = boost::multi_index;
@@ -68,25 +74,102 @@ public:
     }
   }
 
+  /*! \brief Installs the unexpired LSAs of other routers from the last LSDB snapshot.
+
+    This is called once the routing table and the name prefix table listen to the LSDB, so
+    that routes are calculated from the snapshot at once. Sync later replaces the loaded
+    LSAs as it announces newer sequence numbers.
+   */
+  void
+  loadSnapshot();
+
+  /*! \brief Writes a last LSDB snapshot at shutdown and waits until it is written.
+
+    This does nothing if snapshots are disabled.
+   */
+  void
+  flushSnapshot();
+
   /*! \brief Returns whether the LSDB contains some LSA.
    */
   bool
   doesLsaExist(const ndn::Name& router, Lsa::Type lsaType)
   {
-    return m_lsdb.get<byName>().find(std::make_tuple(router, lsaType)) != m_lsdb.end();
+    return findLsaIterator(router, lsaType) != m_lsdb.end();
   }
 
   /*! \brief Builds a name LSA for this router and then installs it
       into the LSDB.
+
+      With aggregation rules, no LSA is built if the advertised names have not changed.
   */
   void
   buildAndInstallOwnNameLsa();
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Returns the names advertised in the own name LSA after the aggregation rules.
+
+    A name strictly under a rule is replaced by the shortest such rule and recorded in
+    m_suppressedNames; an aggregate is advertised as long as it suppresses a name.
+   */
+  NamePrefixList
+  aggregateOwnNames();
+
+  /*! \brief Records that the own name LSA went from \p baseSeqNo to the sequence number of
+             \p nameLsa by adding \p addedNames and removing \p removedNames.
+
+    The history keeps the last NAME_LSA_DELTA_HISTORY changes; a change that does not start
+    where the last one ended restarts it.
+   */
+  void
+  recordOwnNameLsaDelta(const Lsa& nameLsa, uint64_t baseSeqNo,
+                        const std::list<ndn::Name>& addedNames,
+                        const std::list<ndn::Name>& removedNames);
+
+  /*! \brief Returns the changes of the own name LSA since \p baseSeqNo.
+
+    No delta is built when the history does not reach back to \p baseSeqNo, or when the
+    delta would not be smaller than the name LSA itself.
+   */
+  ndn::optional<NameLsaDelta>
+  buildOwnNameLsaDelta(uint64_t baseSeqNo) const;
+
+  /*! \brief Writes the LSAs of other routers to the snapshot file in the state directory.
+
+    The file is the concatenation of the TLV wire encodings of the LSAs, which include their
+    expiration time points. It is written to a temporary file first, synced if state-fsync
+    is on, and then renamed, so a crash never leaves a partial snapshot behind.
+
+    Only the wire encodings are collected here; most LSAs already hold theirs. The file is
+    written on m_snapshotWriter, or right away if that has no thread.
+   */
+  void
+  writeSnapshot();
+
+  void
+  scheduleSnapshot();
+
+  std::string
+  getSnapshotFileName() const;
+
   /*! \brief Builds a cor. LSA for this router and installs it into the LSDB. */
   void
   buildAndInstallOwnCoordinateLsa();
 
+  /*! \brief Builds the summary LSA of an area border router and installs it into the LSDB.
+
+    The summary advertises every name prefix and router prefix of the routers in this
+    router's area, other than the area border routers, which the backbone reaches directly.
+    No LSA is built if the summary has not changed.
+   */
+  void
+  buildAndInstallOwnSummaryLsa();
+
+  /*! \brief Schedules a build of the summary LSA if \p lsa changes the prefixes of the area.
+   */
+  void
+  scheduleSummaryLsaBuild(const Lsa& lsa);
+
 public:
   /*! \brief Schedules a build of this router's LSA. */
   void
@@ -100,6 +183,8 @@ public:
    *    /localhop/<network>/nlsr/LSA/<site>/<router>/<lsaType>/<seqNo>
    * 2) Interest containing segment number:
    *    /localhop/<network>/nlsr/LSA/<site>/<router>/<lsaType>/<seqNo>/<version>/<segmentNo>
+   * A name LSA delta is asked for with NAME-DELTA/<seqNo>/<baseSeqNo> in place of
+   * <lsaType>/<seqNo>.
   */
   void
   processInterest(const ndn::Name& name, const ndn::Interest& interest);
@@ -123,13 +208,6 @@ public:
     return std::static_pointer_cast<T>(findLsa(router, T::type()));
   }
 
-  struct name_hash {
-    int
-    operator()(const ndn::Name& name) const {
-      return std::hash<ndn::Name>{}(name);
-    }
-  };
-
   struct enum_class_hash {
     template<typename T>
     int
@@ -138,20 +216,20 @@ public:
     }
   };
 
-  struct byName{};
+  struct byRouterId{};
   struct byType{};
 
   using LsaContainer = boost::multi_index_container<
     std::shared_ptr<Lsa>,
     bmi::indexed_by<
       bmi::hashed_unique<
-        bmi::tag<byName>,
+        bmi::tag<byRouterId>,
         bmi::composite_key<
           Lsa,
-          bmi::const_mem_fun<Lsa, ndn::Name, &Lsa::getOriginRouterCopy>,
+          bmi::const_mem_fun<Lsa, RouterId, &Lsa::getOriginRouterId>,
           bmi::const_mem_fun<Lsa, Lsa::Type, &Lsa::getType>
         >,
-        bmi::composite_key_hash<name_hash, enum_class_hash>
+        bmi::composite_key_hash<std::hash<RouterId>, enum_class_hash>
       >,
       bmi::hashed_non_unique<
         bmi::tag<byType>,
@@ -173,10 +251,22 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::shared_ptr<Lsa>
   findLsa(const ndn::Name& router, Lsa::Type lsaType) const
   {
-    auto it = m_lsdb.get<byName>().find(std::make_tuple(router, lsaType));
+    auto it = findLsaIterator(router, lsaType);
     return it != m_lsdb.end() ? *it : nullptr;
   }
 
+  /*! \brief Finds an LSA by the router ID of its origin router.
+
+    A router that has never been given an ID cannot have an LSA in the LSDB.
+   */
+  LsaContainer::index<Lsdb::byRouterId>::type::iterator
+  findLsaIterator(const ndn::Name& router, Lsa::Type lsaType) const
+  {
+    auto&& index = m_lsdb.get<byRouterId>();
+    ndn::optional<RouterId> id = RouterIdTable::get().find(router);
+    return id ? index.find(std::make_tuple(*id, lsaType)) : index.end();
+  }
+
   void
   incrementDataSentStats(Lsa::Type lsaType) {
     if (lsaType == Lsa::Type::NAME) {
@@ -244,7 +334,7 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   removeLsa(const ndn::Name& router, Lsa::Type lsaType);
 
   void
-  removeLsa(const LsaContainer::index<Lsdb::byName>::type::iterator& lsaIt);
+  removeLsa(const LsaContainer::index<Lsdb::byRouterId>::type::iterator& lsaIt);
 
   /*! \brief Attempts to construct an adj. LSA.
 
@@ -273,14 +363,63 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   expireOrRefreshLsa(std::shared_ptr<Lsa> lsa);
 
+  /*! \brief Publishes the own LSA of \p lsaType if its sequence number is \p seqNo.
+
+    With \p baseSeqNo, a name LSA is published as a delta from that sequence number when
+    possible, and as the full LSA otherwise.
+   */
   bool
   processInterestForLsa(const ndn::Interest& interest, const ndn::Name& originRouter,
-                        Lsa::Type lsaType, uint64_t seqNo);
+                        Lsa::Type lsaType, uint64_t seqNo,
+                        ndn::optional<uint64_t> baseSeqNo = ndn::nullopt);
 
   void
   expressInterest(const ndn::Name& interestName, uint32_t timeoutCount,
                   ndn::time::steady_clock::TimePoint deadline = DEFAULT_LSA_RETRIEVAL_DEADLINE);
 
+  /*! \brief Returns the name under which the LSAs of \p originRouter of \p lsaType are
+             published, without the sequence number.
+   */
+  ndn::Name
+  getLsaName(const ndn::Name& originRouter, Lsa::Type lsaType) const;
+
+  /*! \brief Records \p seqNo as the highest known sequence number of \p lsaName.
+      \retval false \p seqNo is older than the highest known one, so the LSA is outdated.
+   */
+  bool
+  updateHighestSeqNo(const ndn::Name& lsaName, uint64_t seqNo);
+
+  /*! \brief Forgets the highest sequence number of \p lsaName after a while.
+
+    The entry stays as a tombstone for an LSA refresh time, so that older copies still in
+    flight are not installed, unless a newer sequence number revives it.
+   */
+  void
+  schedulePruneHighestSeqNo(const ndn::Name& lsaName);
+
+  /*! \brief Returns the name under which the changes of a name LSA are fetched.
+
+    A router that holds the name LSA at \p baseSeqNo asks for the changes up to \p seqNo with
+    /<lsa-prefix>/<site>/<router>/NAME-DELTA/<seqNo>/<baseSeqNo>. The name is not under the
+    name of the full LSA, so an Interest for the full LSA is never answered with a delta.
+
+    \param lsaName The name of the name LSA without the sequence number.
+   */
+  ndn::Name
+  getNameLsaDeltaName(const ndn::Name& lsaName, uint64_t seqNo, uint64_t baseSeqNo) const;
+
+  /*! \brief Turns a name LSA delta Interest name into the name of the full LSA.
+      \return The base sequence number, or nullopt if \p interestName does not ask for a delta.
+   */
+  ndn::optional<uint64_t>
+  toFullLsaName(ndn::Name& interestName) const;
+
+  /*! \brief Applies \p delta to the name LSA of its origin router in place.
+      \retval false The LSDB does not hold the name LSA at the base sequence number.
+   */
+  bool
+  applyNameLsaDelta(const NameLsaDelta& delta);
+
   /*!
      \brief Error callback when SegmentFetcher fails to return an LSA
 
@@ -343,9 +482,22 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::time::seconds m_adjLsaBuildInterval;
   const ndn::Name& m_thisRouterPrefix;
 
+  struct HighestSeqNo
+  {
+    uint64_t seqNo;
+    // Set while the entry is a tombstone of an LSA that is gone
+    ndn::scheduler::ScopedEventId pruneEvent;
+  };
+
   // Maps the name of an LSA to its highest known sequence number from sync;
   // Used to stop NLSR from trying to fetch outdated LSAs
-  std::map<ndn::Name, uint64_t> m_highestSeqNo;
+  std::unordered_map<ndn::Name, HighestSeqNo, NameHash> m_highestSeqNo;
+
+  // Maps each aggregate advertised in the own name LSA to the names that it suppresses
+  std::map<ndn::Name, std::set<ndn::Name>> m_suppressedNames;
+
+  // The last changes of the own name LSA, oldest first, each starting where the previous ends
+  std::deque<NameLsaDelta> m_ownNameLsaDeltas;
 
   SequencingManager m_sequencingManager;
 
@@ -357,11 +509,18 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   bool m_isBuildAdjLsaScheduled;
   int64_t m_adjBuildCount;
   ndn::scheduler::ScopedEventId m_scheduledAdjLsaBuild;
+  ndn::scheduler::ScopedEventId m_scheduledSummaryLsaBuild;
+  ndn::scheduler::ScopedEventId m_snapshotEvent;
 
   ndn::InMemoryStoragePersistent m_lsaStorage;
 
   const ndn::Name::Component NAME_COMPONENT = ndn::Name::Component("lsdb");
+  const ndn::Name::Component DELTA_COMPONENT = ndn::Name::Component("NAME-DELTA");
+  static constexpr size_t NAME_LSA_DELTA_HISTORY = 32;
   static const ndn::time::steady_clock::TimePoint DEFAULT_LSA_RETRIEVAL_DEADLINE;
+
+  // Has a thread only if snapshots are enabled
+  util::WorkerPool m_snapshotWriter;
 };
 
 } // namespace nlsr
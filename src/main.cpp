@@ -24,7 +24,10 @@
 #include "security/certificate-store.hpp"
 #include "version.hpp"
 
+#include <boost/asio/signal_set.hpp>
 #include <boost/exception/diagnostic_information.hpp>
+
+#include <csignal>
 #include <iostream>
 
 static void
@@ -86,6 +89,15 @@ main(int argc, char** argv)
     certStore.insert(*certificate);
   }
 
+  // Shut down cleanly, so that the last LSDB snapshot is written
+  boost::asio::signal_set terminationSignals(ioService, SIGINT, SIGTERM);
+  terminationSignals.async_wait([&] (const boost::system::error_code& error, int) {
+    if (!error) {
+      nlsr.getLsdb().flushSnapshot();
+      ioService.stop();
+    }
+  });
+
   try {
     face.processEvents();
   }
@@ -43,8 +43,8 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_namePrefixList(confParam.getNamePrefixList())
   , m_fib(m_face, m_scheduler, m_adjacencyList, m_confParam, keyChain)
   , m_lsdb(m_face, keyChain, m_confParam)
-  , m_routingTable(m_scheduler, m_lsdb, m_confParam)
-  , m_namePrefixTable(confParam.getRouterPrefix(), m_fib, m_routingTable,
+  , m_routingTable(m_face.getIoService(), m_scheduler, m_lsdb, m_confParam)
+  , m_namePrefixTable(confParam, m_fib, m_routingTable,
                       m_routingTable.afterRoutingChange, m_lsdb.onLsdbModified)
   , m_helloProtocol(m_face, keyChain, confParam, m_routingTable, m_lsdb)
   , m_onNewLsaConnection(m_lsdb.getSync().onNewLsa->connect(
@@ -62,6 +62,11 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
         if (it != m_adjacencyList.end()) {
           m_fib.registerPrefix(m_confParam.getSyncPrefix(), it->getFaceUri(), it->getLinkCost(),
                                ndn::time::milliseconds::max(), ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+          if (m_confParam.isAreaBorderRouter()) {
+            m_fib.registerPrefix(m_confParam.getAreaSyncPrefix(ConfParameter::BACKBONE_AREA),
+                                 it->getFaceUri(), it->getLinkCost(),
+                                 ndn::time::milliseconds::max(), ndn::nfd::ROUTE_FLAG_CAPTURE, 0);
+          }
         }
       }))
   , m_dispatcher(m_face, keyChain)
@@ -76,7 +81,7 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
   , m_nfdRibCommandProcessor(m_dispatcher,
       m_namePrefixList,
       m_lsdb)
-  , m_statsCollector(m_lsdb, m_helloProtocol)
+  , m_statsCollector(m_lsdb, m_helloProtocol, m_routingTable)
   , m_faceMonitor(m_face)
 {
   NLSR_LOG_DEBUG("Initializing Nlsr");
@@ -86,6 +91,10 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
 
   m_fib.setStrategy(m_confParam.getLsaPrefix(), Fib::MULTICAST_STRATEGY, 0);
   m_fib.setStrategy(m_confParam.getSyncPrefix(), Fib::MULTICAST_STRATEGY, 0);
+  if (m_confParam.isAreaBorderRouter()) {
+    m_fib.setStrategy(m_confParam.getAreaSyncPrefix(ConfParameter::BACKBONE_AREA),
+                      Fib::MULTICAST_STRATEGY, 0);
+  }
 
   NLSR_LOG_DEBUG("Default NLSR identity: " << m_confParam.getSigningInfo().getSignerName());
 
@@ -107,6 +116,11 @@ Nlsr::Nlsr(ndn::Face& face, ndn::KeyChain& keyChain, ConfParameter& confParam)
       neighbor.setLinkCost(0);
     }
   }
+
+  // Routes from the last snapshot are available before sync has fetched every LSA again
+  if (m_confParam.getLsdbSnapshotInterval() > 0) {
+    m_lsdb.loadSnapshot();
+  }
 }
 
 void
@@ -186,6 +200,11 @@ Nlsr::onFaceEventNotification(const ndn::nfd::FaceEventNotification& faceEventNo
 
         adjacent->setFaceId(0);
 
+        // Fall back on the alternate next hops until the routing table is recalculated
+        if (m_confParam.getFastReroute()) {
+          m_fib.rerouteAroundFace(adjacent->getFaceUri());
+        }
+
         // Only trigger an Adjacency LSA build if this node is changing
         // from ACTIVE to INACTIVE since this rebuild will effectively
         // cancel the previous Adjacency LSA refresh event and schedule
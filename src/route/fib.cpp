@@ -56,6 +56,7 @@ Fib::remove(const ndn::Name& name)
   if (it != m_table.end() && isNotNeighbor((it->second).name)) {
     for (const auto& nexthop : (it->second).nexthopSet) {
       unregisterPrefix((it->second).name, nexthop.getConnectingFaceUri());
+      removeFromFaceIndex((it->second).name, nexthop.getConnectingFaceUri());
     }
     m_table.erase(it);
   }
@@ -73,6 +74,7 @@ Fib::addNextHopsToFibEntryAndNfd(FibEntry& entry, const NextHopsUriSortedSet& ho
     // Add nexthop to FIB entry
     NLSR_LOG_DEBUG("Adding " << hop.getConnectingFaceUri() << " to " << entry.name);
     entry.nexthopSet.addNextHop(hop);
+    m_namesByFaceUri[hop.getConnectingFaceUri()].insert(name);
 
     if (shouldRegister) {
       // Add nexthop to NDN-FIB
@@ -97,10 +99,19 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
   unsigned int nFaces = 0;
 
   // Create a list of next hops to be installed with length == maxFaces
-  for (auto it = allHops.cbegin(); it != allHops.cend() && nFaces < maxFaces; ++it, ++nFaces) {
+  auto it = allHops.cbegin();
+  for (; it != allHops.cend() && nFaces < maxFaces; ++it, ++nFaces) {
     hopsToAdd.addNextHop(*it);
   }
 
+  // Keep the others to fall back on when the face of an installed next hop goes down
+  NexthopList alternates;
+  if (m_confParameter.getFastReroute()) {
+    for (; it != allHops.cend(); ++it) {
+      alternates.addNextHop(*it);
+    }
+  }
+
   auto entryIt = m_table.find(name);
 
   // New FIB entry that has nextHops
@@ -109,6 +120,7 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
 
     FibEntry entry;
     entry.name = name;
+    entry.alternates = std::move(alternates);
 
     addNextHopsToFibEntryAndNfd(entry, hopsToAdd);
 
@@ -128,6 +140,7 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
     }
 
     FibEntry& entry = (entryIt->second);
+    entry.alternates = std::move(alternates);
     addNextHopsToFibEntryAndNfd(entry, hopsToAdd);
 
     std::set<NextHop, NextHopUriSortedComparator> hopsToRemove;
@@ -144,6 +157,7 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
       }
       NLSR_LOG_DEBUG("Removing " << hop.getConnectingFaceUri() << " from " << entry.name);
       entry.nexthopSet.removeNextHop(hop);
+      removeFromFaceIndex(entry.name, hop.getConnectingFaceUri());
     }
 
     // Increment sequence number
@@ -158,6 +172,63 @@ Fib::update(const ndn::Name& name, const NexthopList& allHops)
   }
 }
 
+size_t
+Fib::rerouteAroundFace(const ndn::FaceUri& faceUri)
+{
+  const std::string lostFaceUri = faceUri.toString();
+  auto indexIt = m_namesByFaceUri.find(lostFaceUri);
+  if (indexIt == m_namesByFaceUri.end()) {
+    return 0;
+  }
+  std::set<ndn::Name> names = std::move(indexIt->second);
+  m_namesByFaceUri.erase(indexIt);
+
+  size_t nRerouted = 0;
+  for (const auto& name : names) {
+    auto entryIt = m_table.find(name);
+    if (entryIt == m_table.end()) {
+      continue;
+    }
+    FibEntry& entry = entryIt->second;
+
+    // NFD removes the routes through a destroyed face by itself
+    auto lostHop = std::find_if(entry.nexthopSet.begin(), entry.nexthopSet.end(),
+                                [&] (const NextHop& hop) {
+                                  return hop.getConnectingFaceUri() == lostFaceUri;
+                                });
+    if (lostHop == entry.nexthopSet.end()) {
+      continue;
+    }
+    NextHop lost = *lostHop;
+    entry.nexthopSet.removeNextHop(lost);
+
+    // Take the place of the lost next hop with the best alternate that can still be used
+    auto alternate = std::find_if(entry.alternates.begin(), entry.alternates.end(),
+                                  [&] (const NextHop& hop) {
+                                    const std::string& uri = hop.getConnectingFaceUri();
+                                    return uri != lostFaceUri &&
+                                           m_adjacencyList.getFaceId(ndn::FaceUri(uri)) != 0;
+                                  });
+    if (alternate == entry.alternates.end()) {
+      NLSR_LOG_DEBUG("No alternate for " << name << " around " << lostFaceUri);
+      continue;
+    }
+
+    NLSR_LOG_DEBUG("Rerouting " << name << " from " << lostFaceUri << " to " <<
+                   alternate->getConnectingFaceUri());
+    NextHopsUriSortedSet hopsToAdd;
+    hopsToAdd.addNextHop(*alternate);
+    entry.alternates.removeNextHop(*alternate);
+    addNextHopsToFibEntryAndNfd(entry, hopsToAdd);
+    entry.seqNo += 1;
+    ++nRerouted;
+  }
+
+  NLSR_LOG_INFO("Rerouted " << nRerouted << " of " << names.size() << " FIB entries around " <<
+                lostFaceUri);
+  return nRerouted;
+}
+
 void
 Fib::clean()
 {
@@ -179,6 +250,18 @@ Fib::getNumberOfFacesForName(const NexthopList& nextHopList)
   return nMaxFaces == 0 ? nNextHops : std::min(nNextHops, nMaxFaces);
 }
 
+void
+Fib::removeFromFaceIndex(const ndn::Name& name, const std::string& faceUri)
+{
+  auto it = m_namesByFaceUri.find(faceUri);
+  if (it != m_namesByFaceUri.end()) {
+    it->second.erase(name);
+    if (it->second.empty()) {
+      m_namesByFaceUri.erase(it);
+    }
+  }
+}
+
 bool
 Fib::isNotNeighbor(const ndn::Name& name)
 {
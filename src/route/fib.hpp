@@ -38,6 +38,8 @@ struct FibEntry {
   ndn::scheduler::ScopedEventId refreshEventId;
   int32_t seqNo = 1;
   NextHopsUriSortedSet nexthopSet;
+  /*! The next hops beyond max-faces-per-prefix, best first, kept when fast reroute is on */
+  NexthopList alternates;
 };
 
 typedef std::function<void(FibEntry&)> afterRefreshCallback;
@@ -89,6 +91,19 @@ public:
   void
   update(const ndn::Name& name, const NexthopList& allHops);
 
+  /*! \brief Moves the FIB entries that use a face that went down to their alternates.
+   *
+   * Every entry with a next hop through \p faceUri loses it, and its best alternate whose
+   * face is up is registered in NFD in its place. This repairs forwarding as soon as the
+   * face is gone, instead of after the adjacency LSA is rebuilt and the routing table is
+   * recalculated; the next Fib::update of each entry then installs the converged next hops.
+   *
+   * \return The number of entries that got an alternate.
+   * \sa ConfParameter::getFastReroute
+   */
+  size_t
+  rerouteAroundFace(const ndn::FaceUri& faceUri);
+
   /*! \brief Remove all entries from the FIB.
    *
    * This method is called before terminating NLSR to minimize the
@@ -160,6 +175,10 @@ private:
   unsigned int
   getNumberOfFacesForName(const NexthopList& nextHopList);
 
+  /*! \brief Removes \p name from the entries indexed under \p faceUri. */
+  void
+  removeFromFaceIndex(const ndn::Name& name, const std::string& faceUri);
+
   /*! \brief Unregisters a prefix from NFD's RIB.
    *
    */
@@ -229,6 +248,8 @@ private:
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   std::map<ndn::Name, FibEntry> m_table;
+  /*! The names of the entries that have a next hop through each face URI */
+  std::map<std::string, std::set<ndn::Name>> m_namesByFaceUri;
 
 private:
   AdjacencyList& m_adjacencyList;
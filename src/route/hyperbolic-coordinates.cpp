@@ -0,0 +1,90 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hyperbolic-coordinates.hpp"
+#include "lsa/coordinate-lsa.hpp"
+#include "logger.hpp"
+
+#include <boost/math/constants/constants.hpp>
+
+#include <cmath>
+
+namespace nlsr {
+
+INIT_LOGGER(route.HyperbolicCoordinates);
+
+HyperbolicCoordinates
+HyperbolicCoordinates::fromPolar(double radius, const std::vector<double>& angles)
+{
+  HyperbolicCoordinates coordinates;
+  coordinates.radius = radius;
+  coordinates.coshRadius = std::cosh(radius);
+  coordinates.sinhRadius = std::sinh(radius);
+
+  // It is not possible for angle vector size to be zero as ensured by conf-file-processor
+  if (angles.empty()) {
+    return coordinates;
+  }
+
+  double lastAngle = angles.back();
+  if (lastAngle > 2. * boost::math::constants::pi<double>() || lastAngle < 0.0) {
+    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
+    return coordinates;
+  }
+
+  // https://en.wikipedia.org/wiki/N-sphere#Spherical_coordinates
+  // x_0 = cos(a_0), x_m = sin(a_0)...sin(a_m-1) cos(a_m), x_n = sin(a_0)...sin(a_n-1)
+  coordinates.point.reserve(angles.size() + 1);
+  double sinProduct = 1.0;
+  for (double angle : angles) {
+    coordinates.point.push_back(sinProduct * std::cos(angle));
+    sinProduct *= std::sin(angle);
+  }
+  coordinates.point.push_back(sinProduct);
+  return coordinates;
+}
+
+void
+HyperbolicCoordinateCache::update(const CoordinateLsa& lsa)
+{
+  RouterId router = lsa.getOriginRouterId();
+  if (router >= m_coordinates.size()) {
+    m_coordinates.resize(router + 1);
+  }
+  m_coordinates[router] = HyperbolicCoordinates::fromPolar(lsa.getCorRadius(),
+                                                           lsa.getCorTheta());
+}
+
+void
+HyperbolicCoordinateCache::erase(RouterId router)
+{
+  if (router < m_coordinates.size()) {
+    m_coordinates[router] = HyperbolicCoordinates();
+  }
+}
+
+const HyperbolicCoordinates&
+HyperbolicCoordinateCache::find(RouterId router) const
+{
+  static const HyperbolicCoordinates NONE;
+  return router < m_coordinates.size() ? m_coordinates[router] : NONE;
+}
+
+} // namespace nlsr
@@ -0,0 +1,86 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_HYPERBOLIC_COORDINATES_HPP
+#define NLSR_HYPERBOLIC_COORDINATES_HPP
+
+#include "router-id.hpp"
+
+#include <vector>
+
+namespace nlsr {
+
+class CoordinateLsa;
+
+/*! \brief The position of a router in the hyperbolic space.
+
+  The angles of a Coordinate LSA are converted once into a point on the
+  unit sphere, and the hyperbolic functions of the radius are computed
+  once, so that the distance between two routers only needs an inner
+  product and a few multiplications.
+ */
+struct HyperbolicCoordinates
+{
+  /*! \brief Converts the polar coordinates of a Coordinate LSA.
+
+    The result is not valid if the last angle is outside [0, 2PI].
+   */
+  static HyperbolicCoordinates
+  fromPolar(double radius, const std::vector<double>& angles);
+
+  bool
+  isValid() const
+  {
+    return !point.empty();
+  }
+
+  double radius = 0.0;
+  double coshRadius = 0.0;
+  double sinhRadius = 0.0;
+  /*! The point on the unit sphere given by the angles, in Cartesian coordinates. */
+  std::vector<double> point;
+};
+
+/*! \brief The coordinates of every router with a Coordinate LSA, indexed by router ID.
+
+  Router IDs are dense, so the coordinates are kept in a plain vector.
+  They are converted when a Coordinate LSA is installed or updated, not
+  on every routing table calculation.
+ */
+class HyperbolicCoordinateCache
+{
+public:
+  void
+  update(const CoordinateLsa& lsa);
+
+  void
+  erase(RouterId router);
+
+  /*! \brief Returns the coordinates of \p router, which are not valid if it has none. */
+  const HyperbolicCoordinates&
+  find(RouterId router) const;
+
+private:
+  std::vector<HyperbolicCoordinates> m_coordinates;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_HYPERBOLIC_COORDINATES_HPP
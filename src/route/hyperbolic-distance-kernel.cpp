@@ -0,0 +1,210 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "hyperbolic-distance-kernel.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#if defined(__AVX__)
+#include <immintrin.h>
+#elif defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+
+namespace nlsr {
+
+INIT_LOGGER(route.HyperbolicDistanceKernel);
+
+namespace {
+
+// A minimal SIMD layer over packed doubles; each width has the same operations
+#if defined(__AVX__)
+struct Simd
+{
+  using Vec = __m256d;
+  static constexpr size_t WIDTH = 4;
+
+  static Vec load(const double* p) { return _mm256_loadu_pd(p); }
+  static void store(double* p, Vec v) { _mm256_storeu_pd(p, v); }
+  static Vec broadcast(double x) { return _mm256_set1_pd(x); }
+  static Vec add(Vec a, Vec b) { return _mm256_add_pd(a, b); }
+  static Vec sub(Vec a, Vec b) { return _mm256_sub_pd(a, b); }
+  static Vec mul(Vec a, Vec b) { return _mm256_mul_pd(a, b); }
+  static Vec max(Vec a, Vec b) { return _mm256_max_pd(a, b); }
+};
+#elif defined(__SSE2__)
+struct Simd
+{
+  using Vec = __m128d;
+  static constexpr size_t WIDTH = 2;
+
+  static Vec load(const double* p) { return _mm_loadu_pd(p); }
+  static void store(double* p, Vec v) { _mm_storeu_pd(p, v); }
+  static Vec broadcast(double x) { return _mm_set1_pd(x); }
+  static Vec add(Vec a, Vec b) { return _mm_add_pd(a, b); }
+  static Vec sub(Vec a, Vec b) { return _mm_sub_pd(a, b); }
+  static Vec mul(Vec a, Vec b) { return _mm_mul_pd(a, b); }
+  static Vec max(Vec a, Vec b) { return _mm_max_pd(a, b); }
+};
+#else
+struct Simd
+{
+  using Vec = double;
+  static constexpr size_t WIDTH = 1;
+
+  static Vec load(const double* p) { return *p; }
+  static void store(double* p, Vec v) { *p = v; }
+  static Vec broadcast(double x) { return x; }
+  static Vec add(Vec a, Vec b) { return a + b; }
+  static Vec sub(Vec a, Vec b) { return a - b; }
+  static Vec mul(Vec a, Vec b) { return a * b; }
+  static Vec max(Vec a, Vec b) { return std::max(a, b); }
+};
+#endif
+
+// out[j] += s * row[j]
+void
+multiplyAdd(double* out, const double* row, double s, size_t n)
+{
+  Simd::Vec vs = Simd::broadcast(s);
+  size_t j = 0;
+  for (; j + Simd::WIDTH <= n; j += Simd::WIDTH) {
+    Simd::store(out + j, Simd::add(Simd::load(out + j), Simd::mul(vs, Simd::load(row + j))));
+  }
+  for (; j < n; ++j) {
+    out[j] += s * row[j];
+  }
+}
+
+// out[j] = coshSrc * cosh[j] - sinhSrc * sinh[j] * max(out[j], -1), where out holds the
+// cosine of the angular distance on input and the argument of acosh on output
+void
+computeAcoshArguments(double* out, const double* cosh, const double* sinh,
+                      double coshSrc, double sinhSrc, size_t n)
+{
+  Simd::Vec vc = Simd::broadcast(coshSrc);
+  Simd::Vec vs = Simd::broadcast(sinhSrc);
+  Simd::Vec minusOne = Simd::broadcast(-1.0);
+  size_t j = 0;
+  for (; j + Simd::WIDTH <= n; j += Simd::WIDTH) {
+    Simd::Vec cosDeltaTheta = Simd::max(Simd::load(out + j), minusOne);
+    Simd::Vec product = Simd::mul(Simd::mul(vs, Simd::load(sinh + j)), cosDeltaTheta);
+    Simd::store(out + j, Simd::sub(Simd::mul(vc, Simd::load(cosh + j)), product));
+  }
+  for (; j < n; ++j) {
+    out[j] = coshSrc * cosh[j] - sinhSrc * sinh[j] * std::max(out[j], -1.0);
+  }
+}
+
+} // anonymous namespace
+
+const double HyperbolicDistanceKernel::UNKNOWN_DISTANCE = -1.0;
+
+HyperbolicDistanceKernel::HyperbolicDistanceKernel(
+  const std::vector<HyperbolicCoordinates>& coordinates)
+  : m_nRouters(coordinates.size())
+  , m_dimensions(m_nRouters)
+  , m_radius(m_nRouters)
+  , m_coshRadius(m_nRouters)
+  , m_sinhRadius(m_nRouters)
+{
+  size_t maxDimension = 0;
+  for (const auto& c : coordinates) {
+    maxDimension = std::max(maxDimension, c.point.size());
+  }
+  m_points.assign(maxDimension * m_nRouters, 0.0);
+
+  for (size_t j = 0; j < m_nRouters; ++j) {
+    const HyperbolicCoordinates& c = coordinates[j];
+    m_dimensions[j] = static_cast<uint32_t>(c.point.size());
+    m_radius[j] = c.radius;
+    m_coshRadius[j] = c.coshRadius;
+    m_sinhRadius[j] = c.sinhRadius;
+    for (size_t k = 0; k < c.point.size(); ++k) {
+      m_points[k * m_nRouters + j] = c.point[k];
+    }
+  }
+}
+
+void
+HyperbolicDistanceKernel::computeDistances(const HyperbolicCoordinates& src,
+                                           std::vector<double>& distances) const
+{
+  distances.assign(m_nRouters, UNKNOWN_DISTANCE);
+  if (!src.isValid() || src.radius <= 0.0 || src.point.size() * m_nRouters > m_points.size()) {
+    return;
+  }
+
+  // The cosine of the angular distance is the inner product of the points on the unit sphere
+  std::vector<double> cosDeltaTheta(m_nRouters, 0.0);
+  for (size_t k = 0; k < src.point.size(); ++k) {
+    multiplyAdd(cosDeltaTheta.data(), m_points.data() + k * m_nRouters, src.point[k], m_nRouters);
+  }
+
+  std::vector<double> arguments(cosDeltaTheta);
+  computeAcoshArguments(arguments.data(), m_coshRadius.data(), m_sinhRadius.data(),
+                        src.coshRadius, src.sinhRadius, m_nRouters);
+
+  for (size_t j = 0; j < m_nRouters; ++j) {
+    // Routers without coordinates, with other dimensions, or (almost) at the same position
+    if (m_dimensions[j] != src.point.size() || m_radius[j] <= 0.0 || cosDeltaTheta[j] >= 1.0 ||
+        !(arguments[j] >= 1.0)) {
+      continue;
+    }
+    distances[j] = std::acosh(arguments[j]);
+  }
+}
+
+double
+HyperbolicDistanceKernel::computeDistance(const HyperbolicCoordinates& src,
+                                          const HyperbolicCoordinates& dest)
+{
+  // Coordinate LSAs do not exist for these routers, or their angles are out of range
+  if (!src.isValid() || !dest.isValid()) {
+    return UNKNOWN_DISTANCE;
+  }
+
+  if (src.point.size() != dest.point.size()) {
+    NLSR_LOG_ERROR("Angle vector sizes do not match");
+    return UNKNOWN_DISTANCE;
+  }
+
+  // The inner product of the points on the unit sphere is the cosine of the angular distance
+  double cosDeltaTheta = std::inner_product(src.point.begin(), src.point.end(),
+                                            dest.point.begin(), 0.0);
+
+  // The curvature zeta is always 1, so the radii need no scaling
+  double argument = src.coshRadius * dest.coshRadius -
+                    src.sinhRadius * dest.sinhRadius * std::max(cosDeltaTheta, -1.0);
+
+  // Rounding can push the argument of almost identical coordinates below 1
+  if (cosDeltaTheta >= 1.0 || src.radius <= 0.0 || dest.radius <= 0.0 || !(argument >= 1.0)) {
+    NLSR_LOG_ERROR("Delta theta or rI or rJ is <= 0");
+    NLSR_LOG_ERROR("Please make sure that no two nodes have the exact same HR coordinates");
+    return UNKNOWN_DISTANCE;
+  }
+
+  return std::acosh(argument);
+}
+
+} // namespace nlsr
@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_HYPERBOLIC_DISTANCE_KERNEL_HPP
+#define NLSR_HYPERBOLIC_DISTANCE_KERNEL_HPP
+
+#include "hyperbolic-coordinates.hpp"
+
+#include <cstdint>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Computes the hyperbolic distances from one router to all routers in a batch.
+
+  The coordinates are kept in structure-of-arrays layout, one array per
+  Cartesian dimension, so that the inner products and the cosh/sinh
+  terms are computed for several routers at a time with SIMD
+  instructions (AVX or SSE2, whichever the compiler targets), with a
+  scalar fallback on other platforms.
+ */
+class HyperbolicDistanceKernel
+{
+public:
+  /*! \param coordinates The coordinates of every router, indexed by mapping number. */
+  explicit
+  HyperbolicDistanceKernel(const std::vector<HyperbolicCoordinates>& coordinates);
+
+  size_t
+  size() const
+  {
+    return m_nRouters;
+  }
+
+  /*! \brief Computes the distance from \p src to every router.
+    \param[out] distances The distance to each router, indexed by mapping number, or
+                          UNKNOWN_DISTANCE if it cannot be calculated.
+   */
+  void
+  computeDistances(const HyperbolicCoordinates& src, std::vector<double>& distances) const;
+
+  /*! \brief Computes a single distance with scalar code.
+    \return The distance from \p src to \p dest, or UNKNOWN_DISTANCE if it cannot be calculated.
+   */
+  static double
+  computeDistance(const HyperbolicCoordinates& src, const HyperbolicCoordinates& dest);
+
+public:
+  static const double UNKNOWN_DISTANCE;
+
+private:
+  size_t m_nRouters;
+  /*! The number of Cartesian coordinates of each router; 0 if its coordinates are not valid. */
+  std::vector<uint32_t> m_dimensions;
+  std::vector<double> m_radius;
+  std::vector<double> m_coshRadius;
+  std::vector<double> m_sinhRadius;
+  /*! Coordinate k of router j is at k * m_nRouters + j; missing coordinates are 0. */
+  std::vector<double> m_points;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_HYPERBOLIC_DISTANCE_KERNEL_HPP
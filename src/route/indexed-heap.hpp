@@ -0,0 +1,189 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_INDEXED_HEAP_HPP
+#define NLSR_INDEXED_HEAP_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief A binary min-heap over the dense integer range [0, capacity).
+ *
+ * Each item may be present at most once. The heap keeps the position of every item so
+ * that its key can be lowered in O(log n), which is what Dijkstra's algorithm needs when a
+ * shorter path to an already queued router is found.
+ *
+ * Items with equal keys are ordered by their index, so the order in which they are popped
+ * does not depend on the order in which they were pushed.
+ */
+template<typename Key>
+class IndexedMinHeap
+{
+public:
+  explicit
+  IndexedMinHeap(size_t capacity)
+    : m_position(capacity, NOT_IN_HEAP)
+  {
+    m_heap.reserve(capacity);
+  }
+
+  bool
+  empty() const
+  {
+    return m_heap.empty();
+  }
+
+  size_t
+  size() const
+  {
+    return m_heap.size();
+  }
+
+  bool
+  contains(int32_t item) const
+  {
+    return m_position[item] != NOT_IN_HEAP;
+  }
+
+  /*! \brief Inserts \p item with \p key, or lowers its key if it is already queued.
+   *
+   * If \p item is queued with a key not greater than \p key, nothing changes.
+   */
+  void
+  pushOrDecrease(int32_t item, const Key& key)
+  {
+    size_t pos = m_position[item];
+    if (pos == NOT_IN_HEAP) {
+      pos = m_heap.size();
+      m_heap.emplace_back(key, item);
+      m_position[item] = pos;
+    }
+    else if (key < m_heap[pos].first) {
+      m_heap[pos].first = key;
+    }
+    else {
+      return;
+    }
+    siftUp(pos);
+  }
+
+  const Key&
+  topKey() const
+  {
+    return m_heap.front().first;
+  }
+
+  /*! \brief Removes the item with the smallest key and returns it.
+   *  \pre !empty()
+   */
+  int32_t
+  pop()
+  {
+    int32_t item = m_heap.front().second;
+    m_position[item] = NOT_IN_HEAP;
+
+    if (m_heap.size() > 1) {
+      m_heap.front() = m_heap.back();
+      m_position[m_heap.front().second] = 0;
+      m_heap.pop_back();
+      siftDown(0);
+    }
+    else {
+      m_heap.pop_back();
+    }
+    return item;
+  }
+
+  void
+  clear()
+  {
+    for (const auto& entry : m_heap) {
+      m_position[entry.second] = NOT_IN_HEAP;
+    }
+    m_heap.clear();
+  }
+
+private:
+  bool
+  isBefore(size_t a, size_t b) const
+  {
+    return m_heap[a] < m_heap[b];
+  }
+
+  void
+  swapEntries(size_t a, size_t b)
+  {
+    std::swap(m_heap[a], m_heap[b]);
+    m_position[m_heap[a].second] = a;
+    m_position[m_heap[b].second] = b;
+  }
+
+  void
+  siftUp(size_t pos)
+  {
+    while (pos > 0) {
+      size_t parent = (pos - 1) / 2;
+      if (!isBefore(pos, parent)) {
+        break;
+      }
+      swapEntries(pos, parent);
+      pos = parent;
+    }
+  }
+
+  void
+  siftDown(size_t pos)
+  {
+    const size_t size = m_heap.size();
+    while (true) {
+      size_t smallest = pos;
+      size_t left = 2 * pos + 1;
+      size_t right = left + 1;
+      if (left < size && isBefore(left, smallest)) {
+        smallest = left;
+      }
+      if (right < size && isBefore(right, smallest)) {
+        smallest = right;
+      }
+      if (smallest == pos) {
+        break;
+      }
+      swapEntries(pos, smallest);
+      pos = smallest;
+    }
+  }
+
+private:
+  static constexpr size_t NOT_IN_HEAP = static_cast<size_t>(-1);
+
+  std::vector<std::pair<Key, int32_t>> m_heap;
+  std::vector<size_t> m_position;
+};
+
+template<typename Key>
+constexpr size_t IndexedMinHeap<Key>::NOT_IN_HEAP;
+
+} // namespace nlsr
+
+#endif // NLSR_INDEXED_HEAP_HPP
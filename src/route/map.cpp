@@ -32,41 +32,52 @@ INIT_LOGGER(route.Map);
 void
 Map::addEntry(const ndn::Name& rtrName)
 {
-  MapEntry me {rtrName, m_mappingIndex};
-  if (addEntry(me)) {
-    m_mappingIndex++;
-  }
+  addEntry(RouterIdTable::get().intern(rtrName));
 }
 
 bool
-Map::addEntry(MapEntry& mpe)
+Map::addEntry(RouterId router)
 {
-  return m_entries.insert(mpe).second;
+  if (!m_mappingNos.emplace(router, static_cast<int32_t>(m_routers.size())).second) {
+    return false;
+  }
+  m_routers.push_back(router);
+  return true;
+}
+
+void
+Map::addEntries(std::vector<RouterId>& routers)
+{
+  std::sort(routers.begin(), routers.end());
+  routers.erase(std::unique(routers.begin(), routers.end()), routers.end());
+  m_routers.reserve(m_routers.size() + routers.size());
+  m_mappingNos.reserve(m_mappingNos.size() + routers.size());
+  for (RouterId router : routers) {
+    addEntry(router);
+  }
 }
 
 ndn::optional<ndn::Name>
 Map::getRouterNameByMappingNo(int32_t mn) const
 {
-  auto&& mappingNumberView = m_entries.get<detail::byMappingNumber>();
-  auto it = mappingNumberView.find(mn);
-  return it == mappingNumberView.end() ? ndn::nullopt : ndn::optional<ndn::Name>(it->router);
+  ndn::optional<RouterId> router = getRouterIdByMappingNo(mn);
+  return router ? ndn::optional<ndn::Name>(RouterIdTable::get().getName(*router)) : ndn::nullopt;
 }
 
 ndn::optional<int32_t>
-Map::getMappingNoByRouterName(const ndn::Name& rName)
+Map::getMappingNoByRouterName(const ndn::Name& rName) const
 {
-  auto&& routerNameView = m_entries.get<detail::byRouterName>();
-  auto it = routerNameView.find(rName);
-  return it == routerNameView.end() ? ndn::nullopt : ndn::optional<int32_t>(it->mappingNumber);
+  ndn::optional<RouterId> router = RouterIdTable::get().find(rName);
+  return router ? getMappingNoByRouterId(*router) : ndn::nullopt;
 }
 
 void
 Map::writeLog()
 {
   NLSR_LOG_DEBUG("---------------Map----------------------");
-  for (const auto& entry : m_entries.get<detail::byRouterName>()) {
-    NLSR_LOG_DEBUG("MapEntry: ( Router: " << entry.router << " Mapping No: " <<
-                    entry.mappingNumber << " )");
+  for (size_t i = 0; i < m_routers.size(); ++i) {
+    NLSR_LOG_DEBUG("MapEntry: ( Router: " << RouterIdTable::get().getName(m_routers[i]) <<
+                   " Mapping No: " << i << " )");
   }
 }
 
@@ -22,47 +22,24 @@
 #define NLSR_MAP_HPP
 
 #include "common.hpp"
+#include "router-id.hpp"
 #include "lsa/adj-lsa.hpp"
 
-#include <boost/multi_index_container.hpp>
-#include <boost/multi_index/hashed_index.hpp>
-#include <boost/multi_index/member.hpp>
-#include <boost/multi_index/tag.hpp>
+#include <algorithm>
+#include <unordered_map>
+#include <vector>
 
 namespace nlsr {
 
-struct MapEntry {
-  ndn::Name router;
-  int32_t mappingNumber = -1;
-};
-
-namespace detail {
-
-  using namespace boost::multi_index;
-  // Define tags so that we can search by different indices.
-  struct byRouterName {};
-  struct byMappingNumber{};
-  using entryContainer = multi_index_container<
-    MapEntry,
-    indexed_by<
-      hashed_unique<tag<byRouterName>,
-                    member<MapEntry, ndn::Name, &MapEntry::router>,
-                    std::hash<ndn::Name>>,
-      hashed_unique<tag<byMappingNumber>,
-                    member<MapEntry, int32_t, &MapEntry::mappingNumber>>
-      >
-    >;
-
-} // namespace detail
-
+/*! \brief Numbers the routers of one routing calculation densely from 0.
+ *
+ * Routers are identified by their process-wide RouterId. When the map is populated from
+ * the LSDB, mapping numbers are given out in ascending RouterId order, so that the same
+ * set of routers always gets the same mapping numbers.
+ */
 class Map
 {
 public:
-  Map()
-    : m_mappingIndex(0)
-  {
-  }
-
   /*! \brief Add a map entry to this map.
     \param rtrName The name of the router.
 
@@ -81,13 +58,15 @@ public:
   createFromAdjLsdb(IteratorType begin, IteratorType end)
   {
     BOOST_STATIC_ASSERT_MSG(is_iterator<IteratorType>::value, "IteratorType must be an iterator!");
+    std::vector<RouterId> routers;
     for (auto lsa = begin; lsa != end; lsa++) {
       auto adjLsa = std::static_pointer_cast<AdjLsa>(*lsa);
-      addEntry(adjLsa->getOriginRouter());
+      routers.push_back(adjLsa->getOriginRouterId());
       for (const auto& adjacent : adjLsa->getAdl().getAdjList()) {
-        addEntry(adjacent.getName());
+        routers.push_back(adjacent.getNameId());
       }
     }
+    addEntries(routers);
   }
 
   /*! Populates the Map with CoordinateLsas.
@@ -99,32 +78,62 @@ public:
   createFromCoordinateLsdb(IteratorType begin, IteratorType end)
   {
     BOOST_STATIC_ASSERT_MSG(is_iterator<IteratorType>::value, "IteratorType must be an iterator!");
+    std::vector<RouterId> routers;
     for (auto lsa = begin; lsa != end; lsa++) {
-      addEntry((*lsa)->getOriginRouter());
+      routers.push_back((*lsa)->getOriginRouterId());
     }
+    addEntries(routers);
   }
 
   ndn::optional<ndn::Name>
   getRouterNameByMappingNo(int32_t mn) const;
 
   ndn::optional<int32_t>
-  getMappingNoByRouterName(const ndn::Name& rName);
+  getMappingNoByRouterName(const ndn::Name& rName) const;
+
+  ndn::optional<RouterId>
+  getRouterIdByMappingNo(int32_t mn) const
+  {
+    if (mn < 0 || static_cast<size_t>(mn) >= m_routers.size()) {
+      return ndn::nullopt;
+    }
+    return m_routers[mn];
+  }
+
+  ndn::optional<int32_t>
+  getMappingNoByRouterId(RouterId id) const
+  {
+    auto it = m_mappingNos.find(id);
+    return it == m_mappingNos.end() ? ndn::nullopt : ndn::optional<int32_t>(it->second);
+  }
 
   size_t
   getMapSize() const
   {
-    return m_entries.size();
+    return m_routers.size();
+  }
+
+  /*! \brief Returns whether both maps give every router the same mapping number. */
+  bool
+  operator==(const Map& other) const
+  {
+    return m_routers == other.m_routers;
   }
 
   void
   writeLog();
 
 private:
+  /*! \brief Adds the routers in \p routers that are not in the map yet, in ascending order. */
+  void
+  addEntries(std::vector<RouterId>& routers);
+
   bool
-  addEntry(MapEntry& mpe);
+  addEntry(RouterId router);
 
-  int32_t m_mappingIndex;
-  detail::entryContainer m_entries;
+  // Indexed by mapping number
+  std::vector<RouterId> m_routers;
+  std::unordered_map<RouterId, int32_t> m_mappingNos;
 };
 
 } // namespace nlsr
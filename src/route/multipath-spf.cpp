@@ -0,0 +1,92 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "multipath-spf.hpp"
+
+#include <algorithm>
+#include <queue>
+#include <tuple>
+
+namespace nlsr {
+
+namespace {
+
+struct Label
+{
+  RouteCost cost;
+  uint32_t rank;
+  int32_t router;
+  int32_t nextHop;
+};
+
+struct LabelAfter
+{
+  bool
+  operator()(const Label& a, const Label& b) const
+  {
+    return std::tie(a.cost, a.rank, a.router) > std::tie(b.cost, b.rank, b.router);
+  }
+};
+
+} // anonymous namespace
+
+MultipathSpf::MultipathSpf(const TopologyGraph& graph, int32_t source, size_t maxNextHops,
+                           const std::vector<uint32_t>& nextHopRanks)
+  : m_maxNextHops(std::min(maxNextHops, graph.getDegree(source)))
+  , m_routes(graph.getNRouters() * m_maxNextHops)
+  , m_nRoutes(graph.getNRouters(), 0)
+{
+  if (m_maxNextHops == 0) {
+    return;
+  }
+
+  auto isSettled = [this] (int32_t router, int32_t nextHop) {
+    return m_nRoutes[router] == m_maxNextHops ||
+           std::any_of(routesBegin(router), routesEnd(router),
+                       [nextHop] (const Route& route) { return route.nextHop == nextHop; });
+  };
+
+  std::priority_queue<Label, std::vector<Label>, LabelAfter> queue;
+  for (auto link = graph.linksBegin(source); link != graph.linksEnd(source); ++link) {
+    queue.push({link->cost, nextHopRanks[link->router], link->router, link->router});
+  }
+
+  while (!queue.empty()) {
+    Label label = queue.top();
+    queue.pop();
+    if (isSettled(label.router, label.nextHop)) {
+      continue;
+    }
+    m_routes[label.router * m_maxNextHops + m_nRoutes[label.router]++] = {label.nextHop,
+                                                                          label.cost};
+
+    for (auto link = graph.linksBegin(label.router); link != graph.linksEnd(label.router);
+         ++link) {
+      // Paths never go back through the source
+      RouteCost cost = addRouteCost(label.cost, link->cost);
+      if (link->router != source && cost != INFINITE_ROUTE_COST &&
+          !isSettled(link->router, label.nextHop)) {
+        queue.push({cost, label.rank, link->router, label.nextHop});
+      }
+    }
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,91 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_MULTIPATH_SPF_HPP
+#define NLSR_MULTIPATH_SPF_HPP
+
+#include "topology-graph.hpp"
+
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief Computes, in a single traversal, the best route to every router through each
+ *         neighbor of the source.
+ *
+ * The result is the same as running one Dijkstra's calculation per neighbor of the source
+ * with only that neighbor's link usable: the route to a destination through neighbor \c N
+ * costs the link to \c N plus the shortest distance from \c N to the destination without
+ * crossing the source again.
+ *
+ * Instead of separate runs, a single priority queue holds labels (cost, first hop, router).
+ * A router settles at most one label per first hop, and at most \c maxNextHops labels in
+ * total: once a router has settled that many, any later label is no better than all of
+ * them, and neither is any route extending it. Routes are ordered by cost and then by the
+ * rank of the first hop, which mirrors how NexthopList orders next hops by cost and face
+ * URI, so the routes kept are exactly the best ones a FIB entry would use. Costs are fixed
+ * point, so routes of equal cost tie exactly, as they do in NexthopList.
+ */
+class MultipathSpf
+{
+public:
+  struct Route
+  {
+    int32_t nextHop;
+    RouteCost cost;
+  };
+
+  /*! \param graph The topology graph to compute paths over.
+    \param source The mapping number of the source router.
+    \param maxNextHops The maximum number of routes to keep per destination.
+    \param nextHopRanks The rank of each neighbor of \p source, indexed by mapping number,
+                        used to order routes of equal cost.
+  */
+  MultipathSpf(const TopologyGraph& graph, int32_t source, size_t maxNextHops,
+               const std::vector<uint32_t>& nextHopRanks);
+
+  size_t
+  getNRouters() const
+  {
+    return m_nRoutes.size();
+  }
+
+  /*! \brief Returns the first of the routes to \p dest, ordered from best to worst. */
+  const Route*
+  routesBegin(int32_t dest) const
+  {
+    return m_routes.data() + dest * m_maxNextHops;
+  }
+
+  const Route*
+  routesEnd(int32_t dest) const
+  {
+    return routesBegin(dest) + m_nRoutes[dest];
+  }
+
+private:
+  size_t m_maxNextHops;
+  std::vector<Route> m_routes;
+  std::vector<uint32_t> m_nRoutes;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_MULTIPATH_SPF_HPP
@@ -33,17 +33,20 @@ namespace nlsr {
 
 INIT_LOGGER(route.NamePrefixTable);
 
-NamePrefixTable::NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib,
+const ndn::Name NamePrefixTable::DEFAULT_ROUTE("/");
+
+NamePrefixTable::NamePrefixTable(const ConfParameter& confParam, Fib& fib,
                                  RoutingTable& routingTable,
                                  AfterRoutingChange& afterRoutingChangeSignal,
                                  Lsdb::AfterLsdbModified& afterLsdbModifiedSignal)
-  : m_ownRouterName(ownRouterName)
+  : m_confParam(confParam)
+  , m_ownRouterName(confParam.getRouterPrefix())
   , m_fib(fib)
   , m_routingTable(routingTable)
 {
   m_afterRoutingChangeConnection = afterRoutingChangeSignal.connect(
-    [this] (const std::list<RoutingTableEntry>& entries) {
-      updateWithNewRoute(entries);
+    [this] (const RoutingTableDelta& delta) {
+      updateWithRouteDelta(delta);
     });
 
   m_afterLsdbModified = afterLsdbModifiedSignal.connect(
@@ -52,6 +55,14 @@ NamePrefixTable::NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib,
       updateFromLsdb(lsa, updateType, namesToAdd, namesToRemove);
     }
   );
+
+  if (m_confParam.isStubRouter()) {
+    // The next hops toward the neighbors arrive with the routing table deltas
+    for (const auto& adjacent : m_confParam.getAdjacencyList().getAdjList()) {
+      NLSR_LOG_DEBUG("Adding stub default route through " << adjacent.getName());
+      addEntry(DEFAULT_ROUTE, adjacent.getName());
+    }
+  }
 }
 
 NamePrefixTable::~NamePrefixTable()
@@ -73,45 +84,76 @@ NamePrefixTable::updateFromLsdb(std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
   if (updateType == LsdbUpdate::INSTALLED) {
     addEntry(lsa->getOriginRouter(), lsa->getOriginRouter());
 
-    if (lsa->getType() == Lsa::Type::NAME) {
+    if (isAdvertisingNames(*lsa)) {
       auto nlsa = std::static_pointer_cast<NameLsa>(lsa);
       for (const auto& name : nlsa->getNpl().getNames()) {
-        if (name != m_ownRouterName) {
+        if (isInstallingName(name)) {
           addEntry(name, lsa->getOriginRouter());
         }
       }
     }
+    else if (isFromOwnAreaBorderRouter(*lsa)) {
+      NLSR_LOG_DEBUG("Adding default route through area border router "
+                     << lsa->getOriginRouter());
+      addEntry(DEFAULT_ROUTE, lsa->getOriginRouter());
+    }
   }
   else if (updateType == LsdbUpdate::UPDATED) {
-    if (lsa->getType() != Lsa::Type::NAME) {
+    if (!isAdvertisingNames(*lsa)) {
       return;
     }
 
     for (const auto& name : namesToAdd) {
-      if (name != m_ownRouterName) {
+      if (isInstallingName(name)) {
         addEntry(name, lsa->getOriginRouter());
       }
     }
 
     for (const auto& name : namesToRemove) {
-      if (name != m_ownRouterName) {
+      if (isInstallingName(name)) {
         removeEntry(name, lsa->getOriginRouter());
       }
     }
   }
   else {
     removeEntry(lsa->getOriginRouter(), lsa->getOriginRouter());
-    if (lsa->getType() == Lsa::Type::NAME) {
+    if (isAdvertisingNames(*lsa)) {
       auto nlsa = std::static_pointer_cast<NameLsa>(lsa);
       for (const auto& name : nlsa->getNpl().getNames()) {
-        if (name != m_ownRouterName) {
+        if (isInstallingName(name)) {
           removeEntry(name, lsa->getOriginRouter());
         }
       }
     }
+    else if (isFromOwnAreaBorderRouter(*lsa)) {
+      removeEntry(DEFAULT_ROUTE, lsa->getOriginRouter());
+    }
   }
 }
 
+bool
+NamePrefixTable::isAdvertisingNames(const Lsa& lsa) const
+{
+  return lsa.getType() == Lsa::Type::NAME ||
+         (lsa.getType() == Lsa::Type::SUMMARY && !m_confParam.isInArea(lsa.getArea()));
+}
+
+bool
+NamePrefixTable::isFromOwnAreaBorderRouter(const Lsa& lsa) const
+{
+  // Border routers reach the backbone themselves; so do the routers of the backbone
+  return lsa.getType() == Lsa::Type::SUMMARY && !m_confParam.isAreaBorderRouter() &&
+         lsa.getArea() == m_confParam.getArea() &&
+         m_confParam.getArea() != ConfParameter::BACKBONE_AREA;
+}
+
+bool
+NamePrefixTable::isInstallingName(const ndn::Name& name) const
+{
+  return name != m_ownRouterName &&
+         (!m_confParam.isStubRouter() || m_confParam.isStubPrefix(name));
+}
+
 void
 NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
 {
@@ -124,7 +166,9 @@ NamePrefixTable::addEntry(const ndn::Name& name, const ndn::Name& destRouter)
                  });
 
   // Attempt to find a routing table pool entry (RTPE) we can use.
-  RoutingTableEntryPool::iterator rtpeItr = m_rtpool.find(destRouter);
+  ndn::optional<RouterId> destRouterId = RouterIdTable::get().find(destRouter);
+  RoutingTableEntryPool::iterator rtpeItr = destRouterId ? m_rtpool.find(*destRouterId) :
+                                                           m_rtpool.end();
 
   // These declarations just to make the compiler happy...
   RoutingTablePoolEntry rtpe;
@@ -206,7 +250,9 @@ NamePrefixTable::removeEntry(const ndn::Name& name, const ndn::Name& destRouter)
   NLSR_LOG_DEBUG("Removing origin: " << destRouter << " from " << name);
 
   // Fetch an iterator to the appropriate pair object in the pool.
-  RoutingTableEntryPool::iterator rtpeItr = m_rtpool.find(destRouter);
+  ndn::optional<RouterId> destRouterId = RouterIdTable::get().find(destRouter);
+  RoutingTableEntryPool::iterator rtpeItr = destRouterId ? m_rtpool.find(*destRouterId) :
+                                                           m_rtpool.end();
 
   // Simple error checking to prevent any unusual behavior in the case
   // that we try to remove an entry that isn't there.
@@ -273,30 +319,28 @@ NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
 {
   NLSR_LOG_DEBUG("Updating table with newly calculated routes");
 
+  std::unordered_map<RouterId, const RoutingTableEntry*> entriesByDestination;
+  entriesByDestination.reserve(entries.size());
+  for (const auto& entry : entries) {
+    entriesByDestination.emplace(entry.getDestinationId(), &entry);
+  }
+
   // Iterate over each pool entry we have
   for (auto&& poolEntryPair : m_rtpool) {
     auto&& poolEntry = poolEntryPair.second;
-    auto sourceEntry = std::find_if(entries.begin(), entries.end(),
-                                    [&poolEntry] (const RoutingTableEntry& entry) {
-                                      return poolEntry->getDestination() == entry.getDestination();
-                                    });
+    auto it = entriesByDestination.find(poolEntryPair.first);
+    const RoutingTableEntry* sourceEntry = it != entriesByDestination.end() ? it->second : nullptr;
     // If this pool entry has a corresponding entry in the routing table now
-    if (sourceEntry != entries.end()
+    if (sourceEntry != nullptr
         && poolEntry->getNexthopList() != sourceEntry->getNexthopList()) {
       NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " has changed next-hops.");
       poolEntry->setNexthopList(sourceEntry->getNexthopList());
-      for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
-        auto nameEntryFullPtr = nameEntry.second.lock();
-        addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
-      }
+      updateNamePrefixes(*poolEntry);
     }
-    else if (sourceEntry == entries.end()) {
+    else if (sourceEntry == nullptr) {
       NLSR_LOG_DEBUG("Routing entry: " << poolEntry->getDestination() << " now has no next-hops.");
       poolEntry->getNexthopList().clear();
-      for (const auto& nameEntry : poolEntry->namePrefixTableEntries) {
-        auto nameEntryFullPtr = nameEntry.second.lock();
-        addEntry(nameEntryFullPtr->getNamePrefix(), poolEntry->getDestination());
-      }
+      updateNamePrefixes(*poolEntry);
     }
     else {
       NLSR_LOG_TRACE("No change in routing entry:" << poolEntry->getDestination()
@@ -305,6 +349,54 @@ NamePrefixTable::updateWithNewRoute(const std::list<RoutingTableEntry>& entries)
   }
 }
 
+void
+NamePrefixTable::updateWithRouteDelta(const RoutingTableDelta& delta)
+{
+  NLSR_LOG_DEBUG("Updating table with " << delta.changed.size() << " changed and "
+                 << delta.removed.size() << " removed routes");
+
+  for (const RoutingTableEntry* entry : delta.changed) {
+    auto it = m_rtpool.find(entry->getDestinationId());
+    if (it == m_rtpool.end() || it->second->getNexthopList() == entry->getNexthopList()) {
+      continue;
+    }
+    NLSR_LOG_DEBUG("Routing entry: " << entry->getDestination() << " has changed next-hops.");
+    it->second->setNexthopList(entry->getNexthopList());
+    updateNamePrefixes(*it->second);
+  }
+
+  for (RouterId destination : delta.removed) {
+    auto it = m_rtpool.find(destination);
+    if (it == m_rtpool.end() || it->second->getNexthopList().size() == 0) {
+      continue;
+    }
+    NLSR_LOG_DEBUG("Routing entry: " << it->second->getDestination() << " now has no next-hops.");
+    it->second->getNexthopList().clear();
+    updateNamePrefixes(*it->second);
+  }
+}
+
+void
+NamePrefixTable::updateNamePrefixes(const RoutingTablePoolEntry& poolEntry)
+{
+  for (const auto& nameEntry : poolEntry.namePrefixTableEntries) {
+    auto npte = nameEntry.second.lock();
+    if (npte == nullptr) {
+      continue;
+    }
+
+    npte->generateNhlfromRteList();
+    if (npte->getNexthopList().size() > 0) {
+      NLSR_LOG_TRACE("Updating FIB with next hops for " << *npte);
+      m_fib.update(npte->getNamePrefix(), npte->getNexthopList());
+    }
+    else {
+      NLSR_LOG_TRACE(npte->getNamePrefix() << " has no next hops; removing from FIB");
+      m_fib.remove(npte->getNamePrefix());
+    }
+  }
+}
+
   // Inserts the routing table pool entry into the NPT's RTE storage
   // pool.  This cannot fail, so the pool is guaranteed to contain the
   // item after this occurs.
@@ -312,7 +404,7 @@ std::shared_ptr<RoutingTablePoolEntry>
 NamePrefixTable::addRtpeToPool(RoutingTablePoolEntry& rtpe)
 {
   RoutingTableEntryPool::iterator poolItr =
-    m_rtpool.insert(std::make_pair(rtpe.getDestination(),
+    m_rtpool.insert(std::make_pair(rtpe.getDestinationId(),
                                    std::make_shared<RoutingTablePoolEntry>
                                    (rtpe)))
     .first;
@@ -328,7 +420,7 @@ NamePrefixTable::addRtpeToPool(RoutingTablePoolEntry& rtpe)
 void
 NamePrefixTable::deleteRtpeFromPool(std::shared_ptr<RoutingTablePoolEntry> rtpePtr)
 {
-  if (m_rtpool.erase(rtpePtr->getDestination()) != 1) {
+  if (m_rtpool.erase(rtpePtr->getDestinationId()) != 1) {
     NLSR_LOG_DEBUG("Attempted to delete non-existent origin: "
                << rtpePtr->getDestination()
                << " from NPT routing table entry storage pool.");
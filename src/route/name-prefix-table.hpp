@@ -38,11 +38,11 @@ class NamePrefixTable
 {
 public:
   using RoutingTableEntryPool =
-    std::unordered_map<ndn::Name, std::shared_ptr<RoutingTablePoolEntry>>;
+    std::unordered_map<RouterId, std::shared_ptr<RoutingTablePoolEntry>>;
   using NptEntryList = std::list<std::shared_ptr<NamePrefixTableEntry>>;
   using const_iterator = NptEntryList::const_iterator;
 
-  NamePrefixTable(const ndn::Name& ownRouterName, Fib& fib, RoutingTable& routingTable,
+  NamePrefixTable(const ConfParameter& confParam, Fib& fib, RoutingTable& routingTable,
                   AfterRoutingChange& afterRoutingChangeSignal,
                   Lsdb::AfterLsdbModified& afterLsdbModifiedSignal);
 
@@ -59,6 +59,29 @@ public:
                  const std::list<ndn::Name>& namesToAdd,
                  const std::list<ndn::Name>& namesToRemove);
 
+  /*! \brief Returns whether the name prefixes advertised by \p lsa are reachable through
+             its origin router.
+
+    The prefixes of a summary LSA are only used outside the area that they summarize;
+    inside that area they are reached directly.
+   */
+  bool
+  isAdvertisingNames(const Lsa& lsa) const;
+
+  /*! \brief Returns whether \p lsa comes from a border router of this router's area, which
+             is then a default route to everything outside the area.
+   */
+  bool
+  isFromOwnAreaBorderRouter(const Lsa& lsa) const;
+
+  /*! \brief Returns whether a route to \p name learned from another router is installed.
+
+    A stub router only installs the names under its stub prefixes and reaches
+    everything else through the default route toward its neighbors.
+   */
+  bool
+  isInstallingName(const ndn::Name& name) const;
+
   /*! \brief Adds a destination to the specified name prefix.
     \param name The name prefix
     \param destRouter The destination router prefix
@@ -100,6 +123,15 @@ public:
   void
   updateWithNewRoute(const std::list<RoutingTableEntry>& entries);
 
+  /*! \brief Updates the routing information of the destinations in \p delta.
+
+    Only the pool entries of changed or removed destinations, and the
+    name prefixes that use them, are touched; the work is proportional
+    to the size of the change rather than to the size of the tables.
+   */
+  void
+  updateWithRouteDelta(const RoutingTableDelta& delta);
+
   /*! \brief Adds a pool entry to the pool.
     \param rtpe The entry.
 
@@ -132,12 +164,25 @@ public:
   const_iterator
   end() const;
 
+private:
+  /*! \brief Recomputes the next hops of the name prefixes that use \p poolEntry
+             and updates the FIB.
+   */
+  void
+  updateNamePrefixes(const RoutingTablePoolEntry& poolEntry);
+
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   RoutingTableEntryPool m_rtpool;
 
   NptEntryList m_table;
 
+public:
+  /*! The name prefix that is routed to the border routers of this router's area, or to
+      the neighbors of a stub router. */
+  static const ndn::Name DEFAULT_ROUTE;
+
 private:
+  const ConfParameter& m_confParam;
   const ndn::Name& m_ownRouterName;
   Fib& m_fib;
   RoutingTable& m_routingTable;
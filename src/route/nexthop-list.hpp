@@ -34,10 +34,10 @@ namespace nlsr {
 struct NextHopComparator {
   bool
   operator() (const NextHop& nh1, const NextHop& nh2) const {
-    if (nh1.getRouteCostAsAdjustedInteger() < nh2.getRouteCostAsAdjustedInteger()) {
+    if (nh1.getFixedRouteCost() < nh2.getFixedRouteCost()) {
       return true;
     }
-    else if (nh1.getRouteCostAsAdjustedInteger() == nh2.getRouteCostAsAdjustedInteger()) {
+    else if (nh1.getFixedRouteCost() == nh2.getFixedRouteCost()) {
       return nh1.getConnectingFaceUri() < nh2.getConnectingFaceUri();
     }
     else {
@@ -63,7 +63,7 @@ static inline bool
 nexthopRemoveCompare(const NextHop& nh1, const NextHop& nh2)
 {
   return (nh1.getConnectingFaceUri() == nh2.getConnectingFaceUri() &&
-          nh1.getRouteCostAsAdjustedInteger() == nh2.getRouteCostAsAdjustedInteger()) ;
+          nh1.getFixedRouteCost() == nh2.getFixedRouteCost()) ;
 }
 
 template<typename T = NextHopComparator>
@@ -87,7 +87,7 @@ public:
     if (it == m_nexthopList.end()) {
       m_nexthopList.insert(nh);
     }
-    else if (it->getRouteCost() > nh.getRouteCost()) {
+    else if (it->getFixedRouteCost() > nh.getFixedRouteCost()) {
       removeNextHop(*it);
       m_nexthopList.insert(nh);
     }
@@ -31,7 +31,7 @@ NextHop::wireEncode(ndn::EncodingImpl<TAG>& block) const
 {
   size_t totalLength = 0;
 
-  totalLength += ndn::encoding::prependDoubleBlock(block, ndn::tlv::nlsr::CostDouble, m_routeCost);
+  totalLength += ndn::encoding::prependDoubleBlock(block, ndn::tlv::nlsr::CostDouble, getRouteCost());
   totalLength += ndn::encoding::prependStringBlock(block, ndn::tlv::nlsr::Uri, m_connectingFaceUri);
 
   totalLength += block.prependVarNumber(totalLength);
@@ -85,7 +85,7 @@ NextHop::wireDecode(const ndn::Block& wire)
   }
 
   if (val != m_wire.elements_end() && val->type() == ndn::tlv::nlsr::CostDouble) {
-    m_routeCost = ndn::encoding::readDouble(*val);
+    m_routeCost = toRouteCost(ndn::encoding::readDouble(*val));
     ++val;
   }
   else {
@@ -96,7 +96,7 @@ NextHop::wireDecode(const ndn::Block& wire)
 bool
 operator==(const NextHop& lhs, const NextHop& rhs)
 {
-  return (lhs.getRouteCostAsAdjustedInteger() == rhs.getRouteCostAsAdjustedInteger()) &&
+  return (lhs.getFixedRouteCost() == rhs.getFixedRouteCost()) &&
          (lhs.getConnectingFaceUri() == rhs.getConnectingFaceUri());
 }
 
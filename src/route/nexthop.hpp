@@ -21,6 +21,7 @@
 #ifndef NLSR_ROUTE_NEXTHOP_HPP
 #define NLSR_ROUTE_NEXTHOP_HPP
 
+#include "route-cost.hpp"
 #include "test-access-control.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
@@ -38,6 +39,9 @@ namespace nlsr {
  *                Uri
  *                Cost
  *
+ * The route cost is kept as a fixed-point RouteCost; it is only converted to a double on the
+ * wire and for display.
+ *
  * \sa https://redmine.named-data.net/projects/nlsr/wiki/Routing_Table_Dataset
  */
 class NextHop
@@ -54,7 +58,7 @@ public:
 
   NextHop(const std::string& cfu, double rc)
     : m_connectingFaceUri(cfu)
-    , m_routeCost(rc)
+    , m_routeCost(toRouteCost(rc))
     , m_isHyperbolic(false)
   {
   }
@@ -76,28 +80,48 @@ public:
     m_connectingFaceUri = cfu;
   }
 
+  /*! \brief Returns the cost to register in NFD's FIB. */
   uint64_t
   getRouteCostAsAdjustedInteger() const
   {
     if (m_isHyperbolic) {
-      // Round the cost to better preserve decimal cost differences
-      // e.g. Without rounding: 12.3456 > 12.3454 -> 12345 = 12345
-      //      With rounding:    12.3456 > 12.3454 -> 12346 > 12345
-      return static_cast<uint64_t>(round(m_routeCost*HYPERBOLIC_COST_ADJUSTMENT_FACTOR));
+      return adjustHyperbolicCost(getRouteCost());
     }
     else {
-      return static_cast<uint64_t>(m_routeCost);
+      return m_routeCost / ROUTE_COST_SCALE;
     }
   }
 
+  /*! \brief Returns the integer cost of a hyperbolic next hop with cost \p cost. */
+  static uint64_t
+  adjustHyperbolicCost(double cost)
+  {
+    // Round the cost to better preserve decimal cost differences
+    // e.g. Without rounding: 12.3456 > 12.3454 -> 12345 = 12345
+    //      With rounding:    12.3456 > 12.3454 -> 12346 > 12345
+    return static_cast<uint64_t>(round(cost*HYPERBOLIC_COST_ADJUSTMENT_FACTOR));
+  }
+
   double
   getRouteCost() const
   {
-    return m_routeCost;
+    return fromRouteCost(m_routeCost);
   }
 
   void
   setRouteCost(const double rc)
+  {
+    m_routeCost = toRouteCost(rc);
+  }
+
+  RouteCost
+  getFixedRouteCost() const
+  {
+    return m_routeCost;
+  }
+
+  void
+  setFixedRouteCost(RouteCost rc)
   {
     m_routeCost = rc;
   }
@@ -126,7 +150,7 @@ public:
 
 private:
   std::string m_connectingFaceUri;
-  double m_routeCost;
+  RouteCost m_routeCost;
   bool m_isHyperbolic;
 
   mutable ndn::Block m_wire;
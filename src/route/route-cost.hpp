@@ -0,0 +1,93 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTE_COST_HPP
+#define NLSR_ROUTE_COST_HPP
+
+#include "config.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <limits>
+
+#ifndef NLSR_ROUTE_COST_SCALE
+#define NLSR_ROUTE_COST_SCALE 1000
+#endif
+
+namespace nlsr {
+
+/*! \brief A link or route cost in fixed point.
+ *
+ * Costs are advertised as doubles, but are converted once, when they enter the routing
+ * pipeline, to integers counting 1/ROUTE_COST_SCALE units. Path costs then add up exactly,
+ * so equal-cost paths compare equal and sorting or queueing them needs no rounding.
+ */
+using RouteCost = uint64_t;
+
+/*! \brief The number of fixed-point units in a cost of 1.
+
+  Set with the --route-cost-scale configure option.
+*/
+const RouteCost ROUTE_COST_SCALE = NLSR_ROUTE_COST_SCALE;
+
+/*! \brief The cost of a missing or broken link, and the distance to an unreachable router. */
+const RouteCost INFINITE_ROUTE_COST = std::numeric_limits<RouteCost>::max();
+
+/*! \brief The highest cost of a link.
+
+  Larger advertised costs are clamped to it, so that a path of fewer than 2^16 such links
+  still costs less than INFINITE_ROUTE_COST.
+*/
+const RouteCost MAX_LINK_COST = RouteCost(1) << 48;
+
+/*! \brief Converts an advertised cost to fixed point.
+    \return The rounded cost clamped to MAX_LINK_COST, or INFINITE_ROUTE_COST if \p cost is
+            negative or not a finite number.
+*/
+inline RouteCost
+toRouteCost(double cost)
+{
+  if (!std::isfinite(cost) || cost < 0) {
+    return INFINITE_ROUTE_COST;
+  }
+  double scaled = std::round(cost * ROUTE_COST_SCALE);
+  if (scaled >= static_cast<double>(MAX_LINK_COST)) {
+    return MAX_LINK_COST;
+  }
+  return static_cast<RouteCost>(scaled);
+}
+
+/*! \brief Adds two costs, saturating at INFINITE_ROUTE_COST. */
+inline RouteCost
+addRouteCost(RouteCost a, RouteCost b)
+{
+  return a >= INFINITE_ROUTE_COST - b ? INFINITE_ROUTE_COST : a + b;
+}
+
+/*! \brief Converts a fixed-point cost back to the unit it is advertised in. */
+inline double
+fromRouteCost(RouteCost cost)
+{
+  return static_cast<double>(cost) / ROUTE_COST_SCALE;
+}
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTE_COST_HPP
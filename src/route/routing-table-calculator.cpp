@@ -23,611 +23,413 @@
 #include "lsdb.hpp"
 #include "map.hpp"
 #include "nexthop.hpp"
-#include "nlsr.hpp"
+#include "routing-table.hpp"
 #include "logger.hpp"
 #include "adjacent.hpp"
+#include "hyperbolic-distance-kernel.hpp"
+#include "multipath-spf.hpp"
 
-#include <boost/math/constants/constants.hpp>
-#include <ndn-cxx/util/logger.hpp>
+#include <algorithm>
 #include <cmath>
 
 namespace nlsr {
 
 INIT_LOGGER(route.RoutingTableCalculator);
 
-const int LinkStateRoutingTableCalculator::EMPTY_PARENT = -12345;
-const double LinkStateRoutingTableCalculator::INF_DISTANCE = 2147483647;
-const int LinkStateRoutingTableCalculator::NO_MAPPING_NUM = -1;
-const int LinkStateRoutingTableCalculator::NO_NEXT_HOP = -12345;
-
-void
-RoutingTableCalculator::allocateAdjMatrix()
-{
-  adjMatrix = new double*[m_nRouters];
-
-  for (size_t i = 0; i < m_nRouters; ++i) {
-    adjMatrix[i] = new double[m_nRouters];
-  }
-}
-
-void
-RoutingTableCalculator::initMatrix()
-{
-  for (size_t i = 0; i < m_nRouters; i++) {
-    for (size_t j = 0; j < m_nRouters; j++) {
-      adjMatrix[i][j] = Adjacent::NON_ADJACENT_COST;
-    }
-  }
-}
-
-void
-RoutingTableCalculator::makeAdjMatrix(const Lsdb& lsdb, Map& pMap)
-{
-  // For each LSA represented in the map
-  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
-  for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; ++lsaIt) {
-    auto adjLsa = std::static_pointer_cast<AdjLsa>(*lsaIt);
-    ndn::optional<int32_t> row = pMap.getMappingNoByRouterName(adjLsa->getOriginRouter());
-
-    std::list<Adjacent> adl = adjLsa->getAdl().getAdjList();
-    // For each adjacency represented in the LSA
-    for (const auto& adjacent : adl) {
-      ndn::optional<int32_t> col = pMap.getMappingNoByRouterName(adjacent.getName());
-      double cost = adjacent.getLinkCost();
-
-      if (row && col && *row < static_cast<int32_t>(m_nRouters)
-          && *col < static_cast<int32_t>(m_nRouters))
-      {
-        adjMatrix[*row][*col] = cost;
-      }
-    }
-  }
-
-  // Links that do not have the same cost for both directions should
-  // have their costs corrected:
-  //
-  //   If the cost of one side of the link is NON_ADJACENT_COST (i.e. broken) or negative,
-  //   both direction of the link should have their cost corrected to NON_ADJACENT_COST.
-  //
-  //   Otherwise, both sides of the link should use the larger of the two costs.
-  //
-  // Additionally, this means that we can halve the amount of space
-  // that the matrix uses by only maintaining a triangle.
-  // - But that is not yet implemented.
-  for (size_t row = 0; row < m_nRouters; ++row) {
-    for (size_t col = 0; col < m_nRouters; ++col) {
-      double toCost = adjMatrix[row][col];
-      double fromCost = adjMatrix[col][row];
-
-      if (fromCost != toCost) {
-        double correctedCost = Adjacent::NON_ADJACENT_COST;
-
-        if (toCost >= 0 && fromCost >= 0) {
-          // If both sides of the link are up, use the larger cost else break the link
-          correctedCost = std::max(toCost, fromCost);
-        }
-
-        NLSR_LOG_WARN("Cost between [" << row << "][" << col << "] and [" << col << "][" << row <<
-                  "] are not the same (" << toCost << " != " << fromCost << "). " <<
-                  "Correcting to cost: " << correctedCost);
-
-        adjMatrix[row][col] = correctedCost;
-        adjMatrix[col][row] = correctedCost;
-      }
-    }
-  }
-}
-
 void
-RoutingTableCalculator::writeAdjMatrixLog(const Map& map) const
+LinkStateRoutingTableCalculator::calculatePath(const TopologyGraph& graph, const Map& pMap,
+                                               RoutingTableStatus& rt,
+                                               const ndn::Name& routerPrefix,
+                                               uint32_t maxFacesPerPrefix,
+                                               AdjacencyList& adjacencies,
+                                               bool withAlternates)
 {
-  if (!ndn_cxx_getLogger().isLevelEnabled(ndn::util::LogLevel::DEBUG)) {
+  NLSR_LOG_DEBUG("LinkStateRoutingTableCalculator::calculatePath Called");
+  graph.writeLog(pMap);
+  ndn::optional<int32_t> sourceRouter = pMap.getMappingNoByRouterName(routerPrefix);
+  // We only bother to do the calculation if we have a router by that name.
+  if (!sourceRouter) {
     return;
   }
 
-  NLSR_LOG_DEBUG("-----------Legend (routerName -> index)------");
-  std::string routerIndex;
-  std::string indexToNameMapping;
-  std::string lengthOfDash = "--";
-
-  for (size_t i = 0; i < m_nRouters; i++) {
-      routerIndex += boost::lexical_cast<std::string>(i);
-      routerIndex += " ";
-      lengthOfDash += "--";
-      NLSR_LOG_DEBUG("Router:" + map.getRouterNameByMappingNo(i)->toUri() +
-                     " Index:" + boost::lexical_cast<std::string>(i));
+  if (maxFacesPerPrefix == 1 && !withAlternates) {
+    // In the single path case we can simply run Dijkstra's algorithm.
+    ShortestPathTree tree(graph, *sourceRouter);
+    // Inform the routing table of the new next hops.
+    addAllLsNextHopsToRoutingTable(tree, adjacencies, rt, pMap);
   }
-  NLSR_LOG_DEBUG(" |" + routerIndex);
-  NLSR_LOG_DEBUG(lengthOfDash);
-
-  for (size_t i = 0; i < m_nRouters; i++) {
-    std::string line;
-    for (size_t j = 0; j < m_nRouters; j++) {
-      if (adjMatrix[i][j] == LinkStateRoutingTableCalculator::NO_NEXT_HOP) {
-        line += "0 ";
-      }
-      else {
-        line += boost::lexical_cast<std::string>(adjMatrix[i][j]);
-        line += " ";
-      }
-    }
-    line = boost::lexical_cast<std::string>(i) + "|" + line;
-    NLSR_LOG_DEBUG(line);
+  else {
+    // Multi Path
+    calculateMultiPath(graph, pMap, rt, maxFacesPerPrefix, adjacencies, *sourceRouter,
+                       withAlternates);
   }
 }
 
 void
-RoutingTableCalculator::adjustAdMatrix(int source, int link, double linkCost)
+LinkStateRoutingTableCalculator::calculateMultiPath(const TopologyGraph& graph, const Map& pMap,
+                                                    RoutingTableStatus& rt,
+                                                    uint32_t maxFacesPerPrefix,
+                                                    AdjacencyList& adjacencies,
+                                                    int32_t sourceRouter, bool withAlternates)
 {
-  for (int i = 0; i < static_cast<int>(m_nRouters); i++) {
-    if (i == link) {
-      adjMatrix[source][i] = linkCost;
-    }
-    else {
-      // if "i" is not a link to the source, set it's cost to a non adjacent value.
-      adjMatrix[source][i] = Adjacent::NON_ADJACENT_COST;
+  // Rank the neighbors by face URI, the way NexthopList orders next hops of equal cost
+  std::vector<std::string> faceUris = getNeighborFaceUris(adjacencies, pMap);
+  std::vector<std::pair<std::string, int32_t>> neighbors;
+  for (auto link = graph.linksBegin(sourceRouter); link != graph.linksEnd(sourceRouter); ++link) {
+    neighbors.emplace_back(faceUris[link->router], link->router);
+  }
+  std::sort(neighbors.begin(), neighbors.end());
+  std::vector<uint32_t> ranks(m_nRouters, 0);
+  for (size_t i = 0; i < neighbors.size(); ++i) {
+    ranks[neighbors[i].second] = i;
+  }
+
+  // 0 == all faces
+  size_t maxNextHops = maxFacesPerPrefix == 0 ? neighbors.size() : maxFacesPerPrefix;
+  // Alternates are looked for among the routes through all the other neighbors
+  size_t nRoutes = withAlternates ? neighbors.size() : maxNextHops;
+  MultipathSpf spf(graph, sourceRouter, nRoutes, ranks);
+
+  size_t nAlternates = 0;
+  for (size_t dest = 0; dest < spf.getNRouters(); ++dest) {
+    if (spf.routesBegin(dest) == spf.routesEnd(dest)) {
+      continue;
     }
-  }
-}
-
-int
-RoutingTableCalculator::getNumOfLinkfromAdjMatrix(int sRouter)
-{
-  int noLink = 0;
-
-  for (size_t i = 0; i < m_nRouters; i++) {
-    if (adjMatrix[sRouter][i] >= 0 && i != static_cast<size_t>(sRouter)) { // make sure "i" is not self
-      noLink++;
+    ndn::optional<ndn::Name> destName = pMap.getRouterNameByMappingNo(dest);
+    auto addRoute = [&] (const MultipathSpf::Route& route) {
+      NextHop nh;
+      nh.setConnectingFaceUri(faceUris[route.nextHop]);
+      nh.setFixedRouteCost(route.cost);
+      rt.addNextHop(*destName, nh);
+    };
+
+    auto primariesEnd = std::min(spf.routesEnd(dest), spf.routesBegin(dest) + maxNextHops);
+    std::for_each(spf.routesBegin(dest), primariesEnd, addRoute);
+
+    // An alternate comes after every primary route in the order of NexthopList, so the FIB
+    // only installs it in place of one of them
+    if (withAlternates) {
+      const MultipathSpf::Route* alternate = findLoopFreeAlternate(graph, sourceRouter, spf,
+                                                                   dest, maxNextHops);
+      if (alternate != nullptr) {
+        addRoute(*alternate);
+        ++nAlternates;
+      }
     }
   }
-  return noLink;
-}
 
-void
-RoutingTableCalculator::getLinksFromAdjMatrix(int* links,
-                                              double* linkCosts, int source)
-{
-  int j = 0;
-
-  for (size_t i = 0; i < m_nRouters; i++) {
-    if (adjMatrix[source][i] >= 0 && i != static_cast<size_t>(source)) {// make sure "i" is not self
-      links[j] = i;
-      linkCosts[j] = adjMatrix[source][i];
-      j++;
-    }
+  if (withAlternates) {
+    NLSR_LOG_DEBUG("Found loop-free alternates for " << nAlternates << " destination(s)");
   }
 }
 
-void
-RoutingTableCalculator::freeAdjMatrix()
+const MultipathSpf::Route*
+LinkStateRoutingTableCalculator::findLoopFreeAlternate(const TopologyGraph& graph,
+                                                       int32_t sourceRouter,
+                                                       const MultipathSpf& spf, int32_t dest,
+                                                       size_t nPrimaries)
 {
-  for (size_t i = 0; i < m_nRouters; ++i) {
-    delete [] adjMatrix[i];
+  if (static_cast<size_t>(spf.routesEnd(dest) - spf.routesBegin(dest)) <= nPrimaries) {
+    return nullptr;
   }
-  delete [] adjMatrix;
-}
-
-void
-RoutingTableCalculator::allocateLinks()
-{
-  links = new int[vNoLink];
-}
-
-void
-RoutingTableCalculator::allocateLinkCosts()
-{
-  linkCosts = new double[vNoLink];
-}
-
-void
-RoutingTableCalculator::freeLinks()
-{
-  delete [] links;
-}
-void
-RoutingTableCalculator::freeLinksCosts()
-{
-  delete [] linkCosts;
-}
 
-void
-LinkStateRoutingTableCalculator::calculatePath(Map& pMap, RoutingTable& rt,
-                                               ConfParameter& confParam,
-                                               const Lsdb& lsdb)
-{
-  NLSR_LOG_DEBUG("LinkStateRoutingTableCalculator::calculatePath Called");
-  allocateAdjMatrix();
-  initMatrix();
-  makeAdjMatrix(lsdb, pMap);
-  writeAdjMatrixLog(pMap);
-  ndn::optional<int32_t> sourceRouter =
-    pMap.getMappingNoByRouterName(confParam.getRouterPrefix());
-  allocateParent(); // These two matrices are used in Dijkstra's algorithm.
-  allocateDistance(); //
-  // We only bother to do the calculation if we have a router by that name.
-  if (sourceRouter && confParam.getMaxFacesPerPrefix() == 1) {
-    // In the single path case we can simply run Dijkstra's algorithm.
-    doDijkstraPathCalculation(*sourceRouter);
-    // Inform the routing table of the new next hops.
-    addAllLsNextHopsToRoutingTable(confParam.getAdjacencyList(), rt, pMap, *sourceRouter);
-  }
-  else {
-    // Multi Path
-    setNoLink(getNumOfLinkfromAdjMatrix(*sourceRouter));
-    allocateLinks();
-    allocateLinkCosts();
-    // Gets a sparse listing of adjacencies for path calculation
-    getLinksFromAdjMatrix(links, linkCosts, *sourceRouter);
-    for (int i = 0 ; i < vNoLink; i++) {
-      // Simulate that only the current neighbor is accessible
-      adjustAdMatrix(*sourceRouter, links[i], linkCosts[i]);
-      writeAdjMatrixLog(pMap);
-      // Do Dijkstra's algorithm using the current neighbor as your start.
-      doDijkstraPathCalculation(*sourceRouter);
-      // Update the routing table with the calculations.
-      addAllLsNextHopsToRoutingTable(confParam.getAdjacencyList(), rt, pMap, *sourceRouter);
+  // The first route to a router is its shortest one
+  RouteCost destDistance = spf.routesBegin(dest)->cost;
+  for (auto route = spf.routesBegin(dest) + nPrimaries; route != spf.routesEnd(dest); ++route) {
+    RouteCost neighborDistance = spf.routesBegin(route->nextHop)->cost;
+    RouteCost avoidingSource = route->cost - graph.getLinkCost(sourceRouter, route->nextHop);
+    if (avoidingSource < neighborDistance + destDistance) {
+      return route;
     }
-    freeLinks();
-    freeLinksCosts();
   }
-  freeParent();
-  freeDistance();
-  freeAdjMatrix();
+  return nullptr;
 }
 
-void
-LinkStateRoutingTableCalculator::doDijkstraPathCalculation(int sourceRouter)
+std::vector<std::string>
+LinkStateRoutingTableCalculator::getNeighborFaceUris(const AdjacencyList& adjacencies,
+                                                     const Map& pMap) const
 {
-  int i;
-  int v, u;
-  int* Q = new int[m_nRouters]; // Each cell represents the router with that mapping no.
-  int head = 0;
-  // Initiate the parent
-  for (i = 0 ; i < static_cast<int>(m_nRouters); i++) {
-    m_parent[i] = EMPTY_PARENT;
-    // Array where the ith element is the distance to the router with mapping no i.
-    m_distance[i] = INF_DISTANCE;
-    Q[i] = i;
-  }
-  if (sourceRouter != NO_MAPPING_NUM) {
-    // Distance to source from source is always 0.
-    m_distance[sourceRouter] = 0;
-    sortQueueByDistance(Q, m_distance, head, m_nRouters);
-    // While we haven't visited every node.
-    while (head < static_cast<int>(m_nRouters)) {
-      u = Q[head]; // Set u to be the current node pointed to by head.
-      if (m_distance[u] == INF_DISTANCE) {
-        break; // This can only happen when there are no accessible nodes.
-      }
-      // Iterate over the adjacent nodes to u.
-      for (v = 0 ; v < static_cast<int>(m_nRouters); v++) {
-        // If the current node is accessible.
-        if (adjMatrix[u][v] >= 0) {
-          // And we haven't visited it yet.
-          if (isNotExplored(Q, v, head + 1, m_nRouters)) {
-            // And if the distance to this node + from this node to v
-            // is less than the distance from our source node to v
-            // that we got when we built the adj LSAs
-            if (m_distance[u] + adjMatrix[u][v] <  m_distance[v]) {
-              // Set the new distance
-              m_distance[v] = m_distance[u] + adjMatrix[u][v] ;
-              // Set how we get there.
-              m_parent[v] = u;
-            }
-          }
-        }
-      }
-      // Increment the head position, resort the list by distance from where we are.
-      head++;
-      sortQueueByDistance(Q, m_distance, head, m_nRouters);
+  // Routers that are not neighbors get the face URI of an unknown Adjacent
+  std::vector<std::string> faceUris(pMap.getMapSize(), ndn::FaceUri().toString());
+  for (const auto& adjacent : adjacencies.getAdjList()) {
+    ndn::optional<int32_t> router = pMap.getMappingNoByRouterId(adjacent.getNameId());
+    if (router) {
+      faceUris[*router] = adjacent.getFaceUri().toString();
     }
   }
-  delete [] Q;
+  return faceUris;
 }
 
 void
-LinkStateRoutingTableCalculator::addAllLsNextHopsToRoutingTable(AdjacencyList& adjacencies,
-                                                                RoutingTable& rt, Map& pMap,
-                                                                uint32_t sourceRouter)
+LinkStateRoutingTableCalculator::addAllLsNextHopsToRoutingTable(const ShortestPathTree& tree,
+                                                                AdjacencyList& adjacencies,
+                                                                RoutingTableStatus& rt,
+                                                                const Map& pMap)
 {
   NLSR_LOG_DEBUG("LinkStateRoutingTableCalculator::addAllNextHopsToRoutingTable Called");
 
-  int nextHopRouter = 0;
-
+  std::vector<std::string> faceUris = getNeighborFaceUris(adjacencies, pMap);
   // For each router we have
-  for (size_t i = 0; i < m_nRouters ; i++) {
-    if (i != sourceRouter) {
-
-      // Obtain the next hop that was determined by the algorithm
-      nextHopRouter = getLsNextHop(i, sourceRouter);
-      // If this router is accessible at all
-      if (nextHopRouter != NO_NEXT_HOP) {
-
-        // Fetch its distance
-        double routeCost = m_distance[i];
-        // Fetch its actual name
-        ndn::optional<ndn::Name> nextHopRouterName= pMap.getRouterNameByMappingNo(nextHopRouter);
-        if (nextHopRouterName) {
-          std::string nextHopFace =
-            adjacencies.getAdjacent(*nextHopRouterName).getFaceUri().toString();
-          // Add next hop to routing table
-          NextHop nh(nextHopFace, routeCost);
-          rt.addNextHop(*(pMap.getRouterNameByMappingNo(i)), nh);
-
-        }
-      }
-    }
+  for (size_t i = 0; i < tree.getNRouters(); i++) {
+    addLsNextHopToRoutingTable(tree, i, faceUris, rt, pMap);
   }
 }
 
-int
-LinkStateRoutingTableCalculator::getLsNextHop(int dest, int source)
+bool
+LinkStateRoutingTableCalculator::addLsNextHopToRoutingTable(
+  const ShortestPathTree& tree, int32_t dest, const std::vector<std::string>& faceUris,
+  RoutingTableStatus& rt, const Map& pMap)
 {
-  int nextHop = NO_NEXT_HOP;
-  while (m_parent[dest] != EMPTY_PARENT) {
-    nextHop = dest;
-    dest = m_parent[dest];
-  }
-  if (dest != source) {
-    nextHop = NO_NEXT_HOP;
-  }
-  return nextHop;
+  // Obtain the next hop that was determined by the algorithm
+  int32_t nextHopRouter = tree.getNextHop(dest);
+  // If this router is accessible at all
+  if (nextHopRouter == ShortestPathTree::NO_NEXT_HOP) {
+    return false;
+  }
+
+  // Add next hop to routing table with its distance
+  NextHop nh;
+  nh.setConnectingFaceUri(faceUris[nextHopRouter]);
+  nh.setFixedRouteCost(tree.getDistance(dest));
+  rt.addNextHop(*(pMap.getRouterNameByMappingNo(dest)), nh);
+  return true;
 }
 
 void
-LinkStateRoutingTableCalculator::sortQueueByDistance(int* Q,
-                                                     double* dist,
-                                                     int start, int element)
+HyperbolicRoutingCalculator::calculatePath(Map& map, RoutingTableStatus& rt,
+                                           Lsdb& lsdb, AdjacencyList& adjacencies)
 {
-  for (int i = start ; i < element ; i++) {
-    for (int j = i + 1; j < element; j++) {
-      if (dist[Q[j]] < dist[Q[i]]) {
-        int tempU = Q[j];
-        Q[j] = Q[i];
-        Q[i] = tempU;
-      }
-    }
-  }
+  calculatePath(map, rt, getCoordinates(map, lsdb), adjacencies);
 }
 
-int
-LinkStateRoutingTableCalculator::isNotExplored(int* Q,
-                                               int u, int start, int element)
+std::vector<HyperbolicCoordinates>
+HyperbolicRoutingCalculator::getCoordinates(const Map& map, const Lsdb& lsdb)
 {
-  int ret = 0;
-  for (int i = start; i < element; i++) {
-    if (Q[i] == u) {
-      ret = 1;
-      break;
+  std::vector<HyperbolicCoordinates> coordinates(map.getMapSize());
+  for (size_t i = 0; i < coordinates.size(); ++i) {
+    auto lsa = lsdb.findLsa<CoordinateLsa>(*map.getRouterNameByMappingNo(i));
+    // Routers without a Coordinate LSA keep invalid coordinates
+    if (lsa != nullptr) {
+      coordinates[i] = HyperbolicCoordinates::fromPolar(lsa->getCorRadius(), lsa->getCorTheta());
     }
   }
-  return ret;
-}
-
-void
-LinkStateRoutingTableCalculator::allocateParent()
-{
-  m_parent = new int[m_nRouters];
+  return coordinates;
 }
 
-void
-LinkStateRoutingTableCalculator::allocateDistance()
+std::vector<HyperbolicCoordinates>
+HyperbolicRoutingCalculator::getCoordinates(const Map& map, const HyperbolicCoordinateCache& cache)
 {
-  m_distance = new double[m_nRouters];
+  std::vector<HyperbolicCoordinates> coordinates;
+  coordinates.reserve(map.getMapSize());
+  for (size_t i = 0; i < map.getMapSize(); ++i) {
+    coordinates.push_back(cache.find(*map.getRouterIdByMappingNo(i)));
+  }
+  return coordinates;
 }
 
 void
-LinkStateRoutingTableCalculator::freeParent()
+HyperbolicRoutingCalculator::calculatePath(const Map& map, RoutingTableStatus& rt,
+                                           const std::vector<HyperbolicCoordinates>& coordinates,
+                                           AdjacencyList& adjacencies)
 {
-  delete [] m_parent;
+  State state;
+  updateDistances(map, coordinates, adjacencies, state);
+  addNextHops(state, rt);
 }
 
-void LinkStateRoutingTableCalculator::freeDistance()
+static bool
+isSamePosition(const HyperbolicCoordinates& a, const HyperbolicCoordinates& b)
 {
-  delete [] m_distance;
+  return a.radius == b.radius && a.point == b.point;
 }
 
-const double HyperbolicRoutingCalculator::MATH_PI = boost::math::constants::pi<double>();
-
-const double HyperbolicRoutingCalculator::UNKNOWN_DISTANCE = -1.0;
-const double HyperbolicRoutingCalculator::UNKNOWN_RADIUS   = -1.0;
-
-void
-HyperbolicRoutingCalculator::calculatePath(Map& map, RoutingTable& rt,
-                                           Lsdb& lsdb, AdjacencyList& adjacencies)
+ndn::optional<std::vector<int32_t>>
+HyperbolicRoutingCalculator::updateDistances(const Map& map,
+                                             const std::vector<HyperbolicCoordinates>& coordinates,
+                                             AdjacencyList& adjacencies, State& state)
 {
   NLSR_LOG_TRACE("Calculating hyperbolic paths");
 
   ndn::optional<int32_t> thisRouter = map.getMappingNoByRouterName(m_thisRouterName);
 
-  // Iterate over directly connected neighbors
-  std::list<Adjacent> neighbors = adjacencies.getAdjList();
-  for (std::list<Adjacent>::iterator adj = neighbors.begin(); adj != neighbors.end(); ++adj) {
+  // The distances of the last calculation can only be reused for the same routers
+  bool isSameMap = state.map == map && state.coordinates.size() == coordinates.size() &&
+                   state.isDryRun == m_isDryRun;
+  std::vector<int32_t> movedRouters;
+  std::vector<bool> isMoved(coordinates.size(), !isSameMap);
+  if (isSameMap) {
+    for (size_t i = 0; i < coordinates.size(); ++i) {
+      if (!isSamePosition(coordinates[i], state.coordinates[i])) {
+        movedRouters.push_back(static_cast<int32_t>(i));
+        isMoved[i] = true;
+      }
+    }
+  }
+
+  std::unique_ptr<HyperbolicDistanceKernel> kernel;
+  bool isRowRecomputed = false;
+  std::vector<Neighbor> neighbors;
 
+  // Iterate over directly connected neighbors
+  for (const auto& adj : adjacencies.getAdjList()) {
     // Don't calculate nexthops using an inactive router
-    if (adj->getStatus() == Adjacent::STATUS_INACTIVE) {
-      NLSR_LOG_TRACE(adj->getName() << " is inactive; not using it as a nexthop");
+    if (adj.getStatus() == Adjacent::STATUS_INACTIVE) {
+      NLSR_LOG_TRACE(adj.getName() << " is inactive; not using it as a nexthop");
       continue;
     }
 
-    ndn::Name srcRouterName = adj->getName();
-
     // Don't calculate nexthops for this router to other routers
-    if (srcRouterName == m_thisRouterName) {
+    if (adj.getName() == m_thisRouterName) {
       continue;
     }
 
-    std::string srcFaceUri = adj->getFaceUri().toString();
-
-    // Install nexthops for this router to the neighbor; direct neighbors have a 0 cost link
-    addNextHop(srcRouterName, srcFaceUri, 0, rt);
-
-    ndn::optional<int32_t> src = map.getMappingNoByRouterName(srcRouterName);
-
-    if (!src) {
-      NLSR_LOG_WARN(adj->getName() << " does not exist in the router map!");
-      continue;
+    Neighbor neighbor{adj.getName(), adj.getFaceUri().toString(),
+                      map.getMappingNoByRouterId(adj.getNameId()), {}};
+    if (!neighbor.mappingNo) {
+      NLSR_LOG_WARN(adj.getName() << " does not exist in the router map!");
     }
-
-    // Get hyperbolic distance from direct neighbor to every other router
-    for (int dest = 0; dest < static_cast<int>(m_nRouters); ++dest) {
-      // Don't calculate nexthops to this router or from a router to itself
-      if (thisRouter && dest != *thisRouter && dest != *src) {
-
-        ndn::optional<ndn::Name> destRouterName = map.getRouterNameByMappingNo(dest);
-        if (destRouterName) {
-          double distance = getHyperbolicDistance(lsdb, srcRouterName, *destRouterName);
-
-          // Could not compute distance
-          if (distance == UNKNOWN_DISTANCE) {
-            NLSR_LOG_WARN("Could not calculate hyperbolic distance from " << srcRouterName
-                           << " to " << *destRouterName);
-            continue;
-          }
-          addNextHop(*destRouterName, srcFaceUri, distance, rt);
+    else if (thisRouter) {
+      auto previous = std::find_if(state.neighbors.begin(), state.neighbors.end(),
+                                   [&] (const Neighbor& n) { return n.name == neighbor.name; });
+      const HyperbolicCoordinates& src = coordinates.at(*neighbor.mappingNo);
+
+      // Only the distances to the routers that moved change
+      if (previous != state.neighbors.end() && !previous->distances.empty() &&
+          !isMoved[*neighbor.mappingNo]) {
+        neighbor.distances = std::move(previous->distances);
+        for (int32_t dest : movedRouters) {
+          neighbor.distances[dest] = HyperbolicDistanceKernel::computeDistance(src,
+                                                                              coordinates[dest]);
         }
       }
+      else {
+        if (kernel == nullptr) {
+          kernel = std::make_unique<HyperbolicDistanceKernel>(coordinates);
+        }
+        // Get hyperbolic distance from direct neighbor to every other router
+        kernel->computeDistances(src, neighbor.distances);
+        isRowRecomputed = true;
+      }
     }
+    neighbors.push_back(std::move(neighbor));
   }
-}
-
-double
-HyperbolicRoutingCalculator::getHyperbolicDistance(Lsdb& lsdb, ndn::Name src, ndn::Name dest)
-{
-  NLSR_LOG_TRACE("Calculating hyperbolic distance from " << src << " to " << dest);
-
-  double distance = UNKNOWN_DISTANCE;
 
-  auto srcLsa  = lsdb.findLsa<CoordinateLsa>(src);
-  auto destLsa = lsdb.findLsa<CoordinateLsa>(dest);
+  bool isSameNeighbors = isSameMap && !isRowRecomputed &&
+    std::equal(neighbors.begin(), neighbors.end(), state.neighbors.begin(), state.neighbors.end(),
+               [] (const Neighbor& a, const Neighbor& b) {
+                 return a.name == b.name && a.faceUri == b.faceUri;
+               });
 
-  // Coordinate LSAs do not exist for these routers
-  if (srcLsa == nullptr || destLsa == nullptr) {
-    return UNKNOWN_DISTANCE;
+  // Rank the neighbors by face URI, the way NexthopList orders next hops of equal cost
+  std::vector<Neighbor*> byFaceUri;
+  for (auto& neighbor : neighbors) {
+    byFaceUri.push_back(&neighbor);
   }
-
-  std::vector<double> srcTheta = srcLsa->getCorTheta();
-  std::vector<double> destTheta = destLsa->getCorTheta();
-
-  double srcRadius = srcLsa->getCorRadius();
-  double destRadius = destLsa->getCorRadius();
-
-  double diffTheta = calculateAngularDistance(srcTheta, destTheta);
-
-  if (srcRadius == UNKNOWN_RADIUS || destRadius == UNKNOWN_RADIUS ||
-      diffTheta == UNKNOWN_DISTANCE) {
-    return UNKNOWN_DISTANCE;
+  std::sort(byFaceUri.begin(), byFaceUri.end(),
+            [] (const Neighbor* a, const Neighbor* b) { return a->faceUri < b->faceUri; });
+  for (size_t i = 0; i < byFaceUri.size(); ++i) {
+    byFaceUri[i]->rank = static_cast<uint32_t>(i);
   }
 
-  // double r_i, double r_j, double delta_theta, double zeta = 1 (default)
-  distance = calculateHyperbolicDistance(srcRadius, destRadius, diffTheta);
-
-  NLSR_LOG_TRACE("Distance from " << src << " to " << dest << " is " << distance);
+  state.map = map;
+  state.thisRouter = thisRouter;
+  state.isDryRun = m_isDryRun;
+  state.coordinates = coordinates;
+  state.neighbors = std::move(neighbors);
 
-  return distance;
+  if (!isSameNeighbors) {
+    return ndn::nullopt;
+  }
+  NLSR_LOG_DEBUG("Recalculated hyperbolic distances to " << movedRouters.size() << " routers");
+  return movedRouters;
 }
 
-double
-HyperbolicRoutingCalculator::calculateAngularDistance(std::vector<double> angleVectorI,
-                                                      std::vector<double> angleVectorJ)
+void
+HyperbolicRoutingCalculator::addNextHops(const State& state, RoutingTableStatus& rt)
 {
-  // It is not possible for angle vector size to be zero as ensured by conf-file-processor
-
-  // https://en.wikipedia.org/wiki/N-sphere#Spherical_coordinates
+  // Neighbors outside the map are only reachable directly
+  for (const auto& neighbor : state.neighbors) {
+    if (!neighbor.mappingNo) {
+      addNextHop(neighbor.name, neighbor.faceUri, 0, rt);
+    }
+  }
 
-  // Check if two vector lengths are the same
-  if (angleVectorI.size() != angleVectorJ.size()) {
-    NLSR_LOG_ERROR("Angle vector sizes do not match");
-    return UNKNOWN_DISTANCE;
+  for (int dest = 0; dest < static_cast<int>(m_nRouters); ++dest) {
+    addNextHops(state, dest, rt);
   }
+}
 
-  // Check if all angles are within the [0, PI] and [0, 2PI] ranges
-  if (angleVectorI.size() > 1) {
-    for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
-      if ((angleVectorI[k] > M_PI && angleVectorI[k] < 0.0) ||
-          (angleVectorJ[k] > M_PI && angleVectorJ[k] < 0.0)) {
-        NLSR_LOG_ERROR("Angle outside [0, PI]");
-        return UNKNOWN_DISTANCE;
-      }
+void
+HyperbolicRoutingCalculator::addNextHops(const State& state, int32_t dest, RoutingTableStatus& rt)
+{
+  struct Candidate
+  {
+    RouteCost cost;
+    uint32_t rank;
+    const Neighbor* neighbor;
+
+    bool
+    operator<(const Candidate& other) const
+    {
+      return std::tie(cost, rank) < std::tie(other.cost, other.rank);
     }
-  }
-  if (angleVectorI[angleVectorI.size()-1] > 2.*M_PI ||
-      angleVectorI[angleVectorI.size()-1] < 0.0) {
-    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
-    return UNKNOWN_DISTANCE;
-  }
+  };
 
-  if (angleVectorI[angleVectorI.size()-1] > 2.*M_PI ||
-      angleVectorI[angleVectorI.size()-1] < 0.0) {
-    NLSR_LOG_ERROR("Angle not within [0, 2PI]");
-    return UNKNOWN_DISTANCE;
+  ndn::optional<ndn::Name> destRouterName = state.map.getRouterNameByMappingNo(dest);
+  if (!destRouterName) {
+    return;
   }
 
-  // deltaTheta = arccos(vectorI . vectorJ) -> do the inner product
-  double innerProduct = 0.0;
-
-  // Calculate x0 of the vectors
-  double x0i = std::cos(angleVectorI[0]);
-  double x0j = std::cos(angleVectorJ[0]);
+  std::vector<Candidate> candidates;
+  candidates.reserve(state.neighbors.size());
+  for (const auto& neighbor : state.neighbors) {
+    // Direct neighbors have a 0 cost link
+    if (neighbor.mappingNo == dest) {
+      candidates.push_back({0, neighbor.rank, &neighbor});
+      continue;
+    }
 
-  // Calculate xn of the vectors
-  double xni = std::sin(angleVectorI[angleVectorI.size() - 1]);
-  double xnj = std::sin(angleVectorJ[angleVectorJ.size() - 1]);
+    // Don't calculate nexthops to this router or from a router to itself
+    if (!state.thisRouter || dest == *state.thisRouter || !neighbor.mappingNo ||
+        static_cast<size_t>(dest) >= neighbor.distances.size()) {
+      continue;
+    }
 
-  // Do the aggregation of the (n-1) coordinates (if there is more than one angle)
-  // i.e contraction of all (n-1)-dimensional angular coordinates to one variable
-  for (unsigned int k = 0; k < angleVectorI.size() - 1; k++) {
-    xni *= std::sin(angleVectorI[k]);
-    xnj *= std::sin(angleVectorJ[k]);
-  }
-  innerProduct += (x0i * x0j) + (xni * xnj);
-
-  // If d > 1
-  if (angleVectorI.size() > 1) {
-    for (unsigned int m = 1; m < angleVectorI.size(); m++) {
-      // calculate euclidean coordinates given the angles and assuming R_sphere = 1
-      double xmi = std::cos(angleVectorI[m]);
-      double xmj = std::cos(angleVectorJ[m]);
-      for (unsigned int l = 0; l < m; l++) {
-        xmi *= std::sin(angleVectorI[l]);
-        xmj *= std::sin(angleVectorJ[l]);
-      }
-      innerProduct += xmi * xmj;
+    double distance = neighbor.distances[dest];
+    // Could not compute distance
+    if (distance == HyperbolicDistanceKernel::UNKNOWN_DISTANCE) {
+      NLSR_LOG_WARN("Could not calculate hyperbolic distance from " << neighbor.name
+                     << " to " << *destRouterName);
+      continue;
     }
+    candidates.push_back({toRouteCost(distance), neighbor.rank, &neighbor});
   }
 
-  // ArcCos of the inner product gives the angular distance
-  // between two points on a d-dimensional sphere
-  return std::acos(innerProduct);
-}
-
-double
-HyperbolicRoutingCalculator::calculateHyperbolicDistance(double rI, double rJ,
-                                                         double deltaTheta)
-{
-  if (deltaTheta == UNKNOWN_DISTANCE) {
-    return UNKNOWN_DISTANCE;
+  if (candidates.empty()) {
+    return;
   }
 
-  // Usually, we set zeta = 1 in all experiments
-  double zeta = 1;
-
-  if (deltaTheta <= 0.0 || rI <= 0.0 || rJ <= 0.0) {
-    NLSR_LOG_ERROR("Delta theta or rI or rJ is <= 0");
-    NLSR_LOG_ERROR("Please make sure that no two nodes have the exact same HR coordinates");
-    return UNKNOWN_DISTANCE;
+  // Only materialize the next hops that the FIB can use
+  if (m_maxFacesPerPrefix != 0 && candidates.size() > m_maxFacesPerPrefix) {
+    std::partial_sort(candidates.begin(), candidates.begin() + m_maxFacesPerPrefix,
+                      candidates.end());
+    candidates.resize(m_maxFacesPerPrefix);
   }
 
-  double xij = (1. / zeta) * std::acosh(std::cosh(zeta*rI) * std::cosh(zeta*rJ) -
-               std::sinh(zeta*rI)*std::sinh(zeta*rJ)*std::cos(deltaTheta));
-  return xij;
+  for (const auto& candidate : candidates) {
+    NLSR_LOG_TRACE("Distance from " << candidate.neighbor->name << " to " << *destRouterName <<
+                   " is " << fromRouteCost(candidate.cost));
+    addNextHop(*destRouterName, candidate.neighbor->faceUri, candidate.cost, rt);
+  }
 }
 
 void
 HyperbolicRoutingCalculator::addNextHop(ndn::Name dest, std::string faceUri,
-                                        double cost, RoutingTable& rt)
+                                        RouteCost cost, RoutingTableStatus& rt)
 {
-  NextHop hop(faceUri, cost);
+  NextHop hop;
+  hop.setConnectingFaceUri(faceUri);
+  hop.setFixedRouteCost(cost);
   hop.setHyperbolic(true);
 
   NLSR_LOG_TRACE("Calculated " << hop << " for destination: " << dest);
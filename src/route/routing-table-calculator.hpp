@@ -26,13 +26,17 @@
 #include "lsa/adj-lsa.hpp"
 #include "lsdb.hpp"
 #include "conf-parameter.hpp"
+#include "hyperbolic-coordinates.hpp"
+#include "map.hpp"
+#include "multipath-spf.hpp"
+#include "shortest-path-tree.hpp"
+#include "topology-graph.hpp"
 
 #include <list>
 
 namespace nlsr {
 
-class Map;
-class RoutingTable;
+class RoutingTableStatus;
 
 class RoutingTableCalculator
 {
@@ -43,85 +47,7 @@ public:
   }
 
 protected:
-  /*! \brief Allocate the space needed for the adj. matrix. */
-  void
-  allocateAdjMatrix();
-
-  /*! \brief set NON_ADJACENT_COST i.e. -12345 to every cell of the matrix to
-    ensure that the memory is safe. This is also to incorporate zero cost links */
-  void
-  initMatrix();
-
-  /*! \brief Constructs an adj. matrix to calculate with.
-    \param lsdb Reference to the Lsdb
-    \param pMap The map to populate with the adj. data.
-  */
-  void
-  makeAdjMatrix(const Lsdb& lsdb, Map& pMap);
-
-  /*! \brief Writes a formated adjacent matrix to DEBUG log
-    \param map The map containing adjacent matrix data
-  */
-  void
-  writeAdjMatrixLog(const Map& map) const;
-
-  /*! \brief Returns how many links a router in the matrix has.
-    \param sRouter The router to count the links of.
-  */
-  int
-  getNumOfLinkfromAdjMatrix(int sRouter);
-
-  void
-  freeAdjMatrix();
-  /*! \brief Adjust a link cost in the adj. matrix
-    \param source The source router whose adjacency to adjust.
-    \param link The adjacency of the source to adjust.
-    \param linkCost The cost to change to.
-  */
-  void
-  adjustAdMatrix(int source, int link, double linkCost);
-
-  /*! \brief Populates temp. variables with the link costs for some router.
-    \param source The router whose values are to be adjusted.
-    \param links An integer pointer array for the link mappingNos.
-    \param linkCosts A double pointer array that stores the link costs.
-
-    Obtains a sparse list of adjacencies and link costs for some
-    router. Since this is sparse, that means while generating these
-    arrays, if there is no adjacency at i in the matrix, these
-    temporary variables will not contain a NON_ADJACENT_COST (-12345) at i,
-    but rather will contain the values for the next valid adjacency.
-  */
-  void
-  getLinksFromAdjMatrix(int* links, double* linkCosts, int source);
-
-  /*! Allocates an array large enough to hold multipath calculation temps. */
-  void
-  allocateLinks();
-
-  void
-  allocateLinkCosts();
-
-  void
-  freeLinks();
-
-  void
-  freeLinksCosts();
-
-  void
-  setNoLink(int nl)
-  {
-    vNoLink = nl;
-  }
-
-protected:
-  double** adjMatrix;
   size_t m_nRouters;
-
-  int vNoLink;
-  int* links;
-  double* linkCosts;
-
 };
 
 class LinkStateRoutingTableCalculator: public RoutingTableCalculator
@@ -132,74 +58,62 @@ public:
   {
   }
 
-  void
-  calculatePath(Map& pMap, RoutingTable& rt, ConfParameter& confParam,
-                const Lsdb& lsdb);
-
-private:
-  /*! \brief Performs a Dijkstra's calculation over the adjacency matrix.
-    \param sourceRouter The origin router to compute paths from.
+  /*! \brief Calculates paths over \p graph without reading the configuration, so that the
+             calculation can run off the main thread.
+    \param graph The topology graph; its routers are numbered by \p pMap.
+    \param adjacencies A copy of the adjacency list of this router.
+    \param withAlternates Whether to also add a loop-free alternate next hop to every
+                          destination, for fast reroute.
   */
   void
-  doDijkstraPathCalculation(int sourceRouter);
-
-  /*! \brief Sort the elements of a list.
-    \param Q The array that contains the elements to sort.
-    \param dist The array that contains the distances.
-    \param start The first element in the list to sort.
-    \param element The last element in the list to sort through.
-
-    Sorts the list based on distance. The distances are indexed by
-    their mappingNo in dist. Currently uses an insertion sort.
+  calculatePath(const TopologyGraph& graph, const Map& pMap, RoutingTableStatus& rt,
+                const ndn::Name& routerPrefix, uint32_t maxFacesPerPrefix,
+                AdjacencyList& adjacencies, bool withAlternates = false);
 
-    The cost between two nodes can be zero or greater than zero.
-
-  */
+  /*! \brief Adds the next hop towards every router reachable in \p tree to the routing table. */
   void
-  sortQueueByDistance(int* Q, double* dist, int start, int element);
+  addAllLsNextHopsToRoutingTable(const ShortestPathTree& tree, AdjacencyList& adjacencies,
+                                 RoutingTableStatus& rt, const Map& pMap);
 
-  /*! \brief Returns whether an element has been visited yet.
-    \param Q The list of elements to look through.
-    \param u The element to check.
-    \param start The start of list to look through.
-    \param element The end of the list to look through.
+  /*! \brief Adds the next hop towards \p dest in \p tree to the routing table, if any.
+    \param faceUris The face URIs of the neighbors, as returned by getNeighborFaceUris.
+    \return Whether \p dest is reachable.
   */
-  int
-  isNotExplored(int* Q, int u, int start, int element);
+  bool
+  addLsNextHopToRoutingTable(const ShortestPathTree& tree, int32_t dest,
+                             const std::vector<std::string>& faceUris, RoutingTableStatus& rt,
+                             const Map& pMap);
 
-  void
-  addAllLsNextHopsToRoutingTable(AdjacencyList& adjacencies, RoutingTable& rt,
-                                 Map& pMap, uint32_t sourceRouter);
-
-  /*! \brief Determines a destination's next hop.
-    \param dest The router whose next hop we want to determine.
-    \param source The router to determine a next path to.
+  /*! \brief Returns the face URI of every neighbor in \p adjacencies, indexed by its
+             mapping number in \p pMap.
   */
-  int
-  getLsNextHop(int dest, int source);
-
-  void
-  allocateParent();
+  std::vector<std::string>
+  getNeighborFaceUris(const AdjacencyList& adjacencies, const Map& pMap) const;
 
-  void
-  allocateDistance();
-
-  void
-  freeParent();
+private:
+  /*! \brief Calculates the routes through every neighbor in a single traversal.
 
+    At most max-faces-per-prefix routes are kept per destination, since the FIB never
+    uses more, plus the best loop-free alternate among the others if \p withAlternates.
+  */
   void
-  freeDistance();
-
-private:
-  int* m_parent;
-  double* m_distance;
+  calculateMultiPath(const TopologyGraph& graph, const Map& pMap, RoutingTableStatus& rt,
+                     uint32_t maxFacesPerPrefix, AdjacencyList& adjacencies,
+                     int32_t sourceRouter, bool withAlternates);
 
-  static const int EMPTY_PARENT;
-  static const double INF_DISTANCE;
-  static const int NO_MAPPING_NUM;
-public:
-  static const int NO_NEXT_HOP;
+  /*! \brief Returns the best route to \p dest after the first \p nPrimaries that is a
+             loop-free alternate, or nullptr if there is none.
 
+    The neighbor N of a route is a loop-free alternate if its own shortest path to \p dest
+    does not come back through the source S, that is if d(N, dest) < d(N, S) + d(S, dest)
+    (RFC 5286). The route through N in \p spf costs c(S, N) plus N's shortest distance to
+    \p dest avoiding S, so this holds exactly when that route minus c(S, N) is shorter than
+    the right-hand side.
+    \pre \p spf kept the routes through every neighbor of the source.
+  */
+  static const MultipathSpf::Route*
+  findLoopFreeAlternate(const TopologyGraph& graph, int32_t sourceRouter,
+                        const MultipathSpf& spf, int32_t dest, size_t nPrimaries);
 };
 
 class AdjacencyList;
@@ -208,38 +122,95 @@ class Lsdb;
 class HyperbolicRoutingCalculator
 {
 public:
-  HyperbolicRoutingCalculator(size_t nRouters, bool isDryRun, ndn::Name thisRouterName)
+  /*! \param maxFacesPerPrefix The number of next hops kept per destination; 0 keeps all. */
+  HyperbolicRoutingCalculator(size_t nRouters, bool isDryRun, ndn::Name thisRouterName,
+                              uint32_t maxFacesPerPrefix = 0)
     : m_nRouters(nRouters)
     , m_isDryRun(isDryRun)
     , m_thisRouterName(thisRouterName)
+    , m_maxFacesPerPrefix(maxFacesPerPrefix)
   {
   }
 
   void
-  calculatePath(Map& map, RoutingTable& rt, Lsdb& lsdb, AdjacencyList& adjacencies);
+  calculatePath(Map& map, RoutingTableStatus& rt, Lsdb& lsdb, AdjacencyList& adjacencies);
 
-private:
-  double
-  getHyperbolicDistance(Lsdb& lsdb, ndn::Name src, ndn::Name dest);
+  /*! \brief Calculates paths from coordinates that were copied out of the LSDB.
+    \param coordinates The coordinates of every router, indexed by mapping number in \p map.
+  */
+  void
+  calculatePath(const Map& map, RoutingTableStatus& rt,
+                const std::vector<HyperbolicCoordinates>& coordinates,
+                AdjacencyList& adjacencies);
+
+  /*! \brief A neighbor used as a next hop, with its distances to every router. */
+  struct Neighbor
+  {
+    ndn::Name name;
+    std::string faceUri;
+    ndn::optional<int32_t> mappingNo;
+    /*! Indexed by mapping number; empty if the neighbor is not in the map. */
+    std::vector<double> distances;
+    /*! The position of the face URI among the neighbors, which breaks cost ties the way
+        NexthopList does. */
+    uint32_t rank = 0;
+  };
+
+  /*! \brief The distances of the last calculation, kept so that the next one only
+             recomputes the pairs whose coordinates changed.
+  */
+  struct State
+  {
+    Map map;
+    /*! The mapping number of this router, if it is in the map. */
+    ndn::optional<int32_t> thisRouter;
+    /*! Whether the next hops went to the dry-run routing table. */
+    bool isDryRun = false;
+    std::vector<HyperbolicCoordinates> coordinates;
+    std::vector<Neighbor> neighbors;
+  };
+
+  /*! \brief Updates the distances in \p state to new coordinates and neighbors.
+    \param coordinates The coordinates of every router, indexed by mapping number in \p map.
+    \return The mapping numbers of the destinations whose next hops may have changed, or
+            nullopt if all of them may have.
+
+    If the map is the same as in \p state, only the distances to routers whose coordinates
+    changed are recomputed, plus the distances from neighbors that are new or moved.
+  */
+  ndn::optional<std::vector<int32_t>>
+  updateDistances(const Map& map, const std::vector<HyperbolicCoordinates>& coordinates,
+                  AdjacencyList& adjacencies, State& state);
 
+  /*! \brief Adds the next hops of every destination in \p state to \p rt. */
   void
-  addNextHop(ndn::Name destinationRouter, std::string faceUri, double cost, RoutingTable& rt);
+  addNextHops(const State& state, RoutingTableStatus& rt);
 
-  double
-  calculateHyperbolicDistance(double rI, double rJ, double deltaTheta);
+  /*! \brief Adds the next hops of destination \p dest in \p state to \p rt.
 
-  double
-  calculateAngularDistance(std::vector<double> angleVectorI,
-                           std::vector<double> angleVectorJ);
+    Only the best max-faces-per-prefix candidates are added, since the FIB never uses more.
+  */
+  void
+  addNextHops(const State& state, int32_t dest, RoutingTableStatus& rt);
+
+  /*! \brief Converts the coordinates of every router in \p map out of the LSDB. */
+  static std::vector<HyperbolicCoordinates>
+  getCoordinates(const Map& map, const Lsdb& lsdb);
+
+  /*! \brief Copies the coordinates of every router in \p map out of \p cache. */
+  static std::vector<HyperbolicCoordinates>
+  getCoordinates(const Map& map, const HyperbolicCoordinateCache& cache);
+
+private:
+  void
+  addNextHop(ndn::Name destinationRouter, std::string faceUri, RouteCost cost,
+             RoutingTableStatus& rt);
 
 private:
   const size_t m_nRouters;
   const bool m_isDryRun;
   const ndn::Name m_thisRouterName;
-
-  static const double MATH_PI;
-  static const double UNKNOWN_DISTANCE;
-  static const double UNKNOWN_RADIUS;
+  const uint32_t m_maxFacesPerPrefix;
 };
 
 } // namespace nlsr
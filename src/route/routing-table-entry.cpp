@@ -66,6 +66,7 @@ void
 RoutingTableEntry::wireDecode(const ndn::Block& wire)
 {
   m_nexthopList.clear();
+  m_destinationId.reset();
 
   m_wire = wire;
 
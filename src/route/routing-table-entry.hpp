@@ -22,12 +22,15 @@
 #define NLSR_ROUTING_TABLE_ENTRY_HPP
 
 #include "nexthop-list.hpp"
+#include "router-id.hpp"
 
 #include <ndn-cxx/encoding/block.hpp>
 #include <ndn-cxx/encoding/encoding-buffer.hpp>
 #include <ndn-cxx/encoding/tlv.hpp>
 #include <ndn-cxx/name.hpp>
 
+#include <vector>
+
 namespace nlsr {
 
 /*! \brief Data abstraction for RouteTableInfo
@@ -61,6 +64,13 @@ public:
     return m_destination;
   }
 
+  /*! \brief Returns the router ID of the destination, interning it on first use. */
+  RouterId
+  getDestinationId() const
+  {
+    return m_destinationId.intern(m_destination);
+  }
+
   NexthopList&
   getNexthopList()
   {
@@ -95,6 +105,9 @@ protected:
   NexthopList m_nexthopList;
 
   mutable ndn::Block m_wire;
+
+private:
+  mutable RouterIdRef m_destinationId;
 };
 
 NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(RoutingTableEntry);
@@ -102,6 +115,28 @@ NDN_CXX_DECLARE_WIRE_ENCODE_INSTANTIATIONS(RoutingTableEntry);
 std::ostream&
 operator<<(std::ostream& os, const RoutingTableEntry& rte);
 
+/*! \brief The destinations whose routes changed in a routing table calculation.
+ *
+ *  The entries point into the routing table and are only valid while the change is
+ *  being signalled.
+ */
+struct RoutingTableDelta
+{
+  /*! \brief Entries of destinations that were added or whose next hops changed. */
+  std::vector<const RoutingTableEntry*> changed;
+  /*! \brief Destinations that are no longer in the routing table.
+   *
+   *  The IDs are held, so they are not given to other routers while the change is pending.
+   */
+  std::vector<RouterIdRef> removed;
+
+  bool
+  empty() const
+  {
+    return changed.empty() && removed.empty();
+  }
+};
+
 } // namespace nlsr
 
 #endif // NLSR_ROUTING_TABLE_ENTRY_HPP
@@ -27,23 +27,45 @@
 #include "logger.hpp"
 #include "tlv-nlsr.hpp"
 
+#include <algorithm>
+
 namespace nlsr {
 
 INIT_LOGGER(route.RoutingTable);
 
-RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter& confParam)
-  : m_scheduler(scheduler)
+RoutingTable::RoutingTable(boost::asio::io_service& io, ndn::Scheduler& scheduler, Lsdb& lsdb,
+                           ConfParameter& confParam)
+  : m_io(io)
+  , m_scheduler(scheduler)
   , m_lsdb(lsdb)
   , m_routingCalcInterval{confParam.getRoutingCalcInterval()}
+  , m_routingCalcInitialDelay{confParam.getRoutingCalcInitialDelay()}
+  , m_routingCalcInitialHoldTime{confParam.getRoutingCalcHoldTime()}
+  , m_routingCalcHoldTime{m_routingCalcInitialHoldTime}
   , m_isRoutingTableCalculating(false)
   , m_isRouteCalculationScheduled(false)
   , m_confParam(confParam)
   , m_hyperbolicState(m_confParam.getHyperbolicState())
+  , m_workerPool(confParam.getRoutingCalcThreads())
 {
+  auto coordinateLsas = lsdb.getLsdbIterator<CoordinateLsa>();
+  for (auto it = coordinateLsas.first; it != coordinateLsas.second; ++it) {
+    m_coordinateCache.update(static_cast<const CoordinateLsa&>(**it));
+  }
+
   m_afterLsdbModified = lsdb.onLsdbModified.connect(
     [this] (std::shared_ptr<Lsa> lsa, LsdbUpdate updateType,
             const auto& namesToAdd, const auto& namesToRemove) {
       auto type = lsa->getType();
+      if (type == Lsa::Type::COORDINATE) {
+        if (updateType == LsdbUpdate::REMOVED) {
+          m_coordinateCache.erase(lsa->getOriginRouterId());
+        }
+        else {
+          m_coordinateCache.update(static_cast<const CoordinateLsa&>(*lsa));
+        }
+      }
+
       bool updateForOwnAdjacencyLsa = lsa->getOriginRouter() == m_confParam.getRouterPrefix() &&
                                       type == Lsa::Type::ADJACENCY;
       bool scheduleCalculation = false;
@@ -54,10 +76,15 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
         // in HelloProtocol. The routing table calculator for HR takes into account
         // the INACTIVE status of the link).
         NLSR_LOG_DEBUG("No Adj LSA of router itself, routing table can not be calculated :(");
+        cancelCalculation();
+        RoutingTableDelta delta;
+        for (const auto& rte : m_rTable) {
+          delta.removed.emplace_back(rte.getDestinationId());
+        }
         clearRoutingTable();
         clearDryRoutingTable();
         NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-        afterRoutingChange(m_rTable);
+        afterRoutingChange(delta);
         NLSR_LOG_DEBUG(*this);
         m_ownAdjLsaExist = false;
       }
@@ -72,6 +99,11 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
             (type == Lsa::Type::COORDINATE && m_hyperbolicState != HYPERBOLIC_STATE_OFF)) {
           scheduleCalculation = true;
         }
+        // A new border router joins the backbone topology of the other border routers
+        if (type == Lsa::Type::SUMMARY && updateType == LsdbUpdate::INSTALLED &&
+            m_confParam.isAreaBorderRouter() && m_hyperbolicState != HYPERBOLIC_STATE_ON) {
+          scheduleCalculation = true;
+        }
       }
 
       if (scheduleCalculation) {
@@ -81,170 +113,500 @@ RoutingTable::RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter&
   );
 }
 
+RoutingTable::~RoutingTable()
+{
+  m_afterLsdbModified.disconnect();
+  // Queued calculations are skipped while the workers are being joined
+  cancelCalculation();
+}
+
 void
 RoutingTable::calculate()
 {
   m_lsdb.writeLog();
   NLSR_LOG_TRACE("Calculating routing table");
 
-  if (m_isRoutingTableCalculating == false) {
-    m_isRoutingTableCalculating = true;
+  m_isRouteCalculationScheduled = false;
+  m_lastCalculationTime = ndn::time::steady_clock::now();
+  calculationIncrementSignal(Statistics::PacketType::ROUTING_CALC);
+  std::shared_ptr<Calculation> calculation = makeCalculation();
+
+  if (m_workerPool.getNThreads() == 0) {
+    runCalculation(*calculation);
+    publishCalculation(*calculation);
+    return;
+  }
+
+  // A calculation that is still running works on an older LSDB
+  cancelCalculation();
+  m_pendingCalculation = calculation;
+  m_isRoutingTableCalculating = true;
 
-    if (m_hyperbolicState == HYPERBOLIC_STATE_OFF) {
-      calculateLsRoutingTable();
+  m_workerPool.post([this, calculation] {
+    if (!calculation->isCancelled) {
+      try {
+        runCalculation(*calculation);
+      }
+      catch (const std::exception& e) {
+        NLSR_LOG_ERROR("Routing table calculation failed: " << e.what());
+        calculation->isCancelled = true;
+      }
     }
-    else if (m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN) {
-      calculateLsRoutingTable();
-      calculateHypRoutingTable(true);
+
+    // Only the routing table owns the calculation once this job is done, so a calculation
+    // that was cancelled or whose routing table is gone cannot be locked any more.
+    std::weak_ptr<Calculation> weakCalculation = calculation;
+    m_io.post([this, weakCalculation] {
+      std::shared_ptr<Calculation> finished = weakCalculation.lock();
+      if (finished == nullptr || finished != m_pendingCalculation) {
+        return;
+      }
+      m_pendingCalculation.reset();
+      m_isRoutingTableCalculating = false;
+      if (!finished->isCancelled) {
+        publishCalculation(*finished);
+      }
+    });
+  });
+}
+
+std::shared_ptr<RoutingTable::Calculation>
+RoutingTable::makeCalculation()
+{
+  auto calculation = std::make_shared<Calculation>();
+  calculation->routerPrefix = m_confParam.getRouterPrefix();
+  calculation->maxFacesPerPrefix = m_confParam.getMaxFacesPerPrefix();
+  calculation->isFastRerouteEnabled = m_confParam.getFastReroute();
+  calculation->adjacencies = m_confParam.getAdjacencyList();
+
+  if (m_hyperbolicState != HYPERBOLIC_STATE_ON) {
+    if (m_lsdb.getIsBuildAdjLsaScheduled()) {
+      NLSR_LOG_DEBUG("Adjacency build is scheduled, routing table can not be calculated :(");
     }
-    else if (m_hyperbolicState == HYPERBOLIC_STATE_ON) {
-      calculateHypRoutingTable(false);
+    // We only check this in LS since we never remove our own Coordinate LSA,
+    // whereas we remove our own Adjacency LSA if we don't have any neighbors
+    else if (m_ownAdjLsaExist) {
+      calculation->isLsCalculated = true;
+      auto lsaRange = m_lsdb.getLsdbIterator<AdjLsa>();
+      calculation->lsMap.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+      if (m_confParam.isAreaBorderRouter()) {
+        // The routes to the backbone must not go through this router's area, whose routers
+        // send everything outside the area back to their nearest border router
+        calculation->isAreaBorderRouter = true;
+        const std::string& area = m_confParam.getArea();
+        calculation->lsGraph = TopologyGraph(m_lsdb, calculation->lsMap,
+          [&area] (const AdjLsa& lsa) { return lsa.getArea() == area; });
+        calculation->lsBackboneGraph = TopologyGraph(m_lsdb, calculation->lsMap,
+          [this] (const AdjLsa& lsa) {
+            return lsa.getArea() == ConfParameter::BACKBONE_AREA ||
+                   m_lsdb.doesLsaExist(lsa.getOriginRouter(), Lsa::Type::SUMMARY);
+          });
+      }
+      else {
+        calculation->lsGraph = TopologyGraph(m_lsdb, calculation->lsMap);
+      }
+      calculation->lsSpfState = std::move(m_lsSpfState);
     }
+  }
 
-    m_isRouteCalculationScheduled = false;
-    m_isRoutingTableCalculating = false;
+  if (m_hyperbolicState != HYPERBOLIC_STATE_OFF) {
+    calculation->isHypCalculated = true;
+    calculation->isHypDryRun = m_hyperbolicState == HYPERBOLIC_STATE_DRY_RUN;
+    calculation->hypState = std::move(m_hypState);
+    auto lsaRange = m_lsdb.getLsdbIterator<CoordinateLsa>();
+    calculation->hypMap.createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+    calculation->coordinates = HyperbolicRoutingCalculator::getCoordinates(calculation->hypMap,
+                                                                           m_coordinateCache);
   }
-  else {
-    scheduleRoutingTableCalculation();
+
+  // An incremental update changes a copy of the current routing table
+  if (calculation->lsSpfState != nullptr || calculation->hypState != nullptr) {
+    calculation->result = *this;
+  }
+
+  return calculation;
+}
+
+void
+RoutingTable::runCalculation(Calculation& calculation)
+{
+  if (calculation.isLsCalculated) {
+    calculateLsRoutingTable(calculation);
+  }
+
+  if (calculation.isHypCalculated && !calculation.isCancelled) {
+    calculateHypRoutingTable(calculation);
   }
 }
 
 void
-RoutingTable::calculateLsRoutingTable()
+RoutingTable::calculateLsRoutingTable(Calculation& calculation)
 {
   NLSR_LOG_TRACE("CalculateLsRoutingTable Called");
 
-  if (m_lsdb.getIsBuildAdjLsaScheduled()) {
-    NLSR_LOG_DEBUG("Adjacency build is scheduled, routing table can not be calculated :(");
+  Map& map = calculation.lsMap;
+  map.writeLog();
+
+  size_t nRouters = map.getMapSize();
+  ndn::optional<int32_t> sourceRouter = map.getMappingNoByRouterName(calculation.routerPrefix);
+  // Loop-free alternates need the routes through every neighbor, not just a single tree
+  bool isSinglePath = calculation.maxFacesPerPrefix == 1 && !calculation.isFastRerouteEnabled &&
+                      !calculation.isAreaBorderRouter && sourceRouter;
+
+  if (isSinglePath && updateLsRoutingTableIncrementally(calculation, *sourceRouter)) {
     return;
   }
 
-  // We only check this in LS since we never remove our own Coordinate LSA,
-  // whereas we remove our own Adjacency LSA if we don't have any neighbors
-  if (!m_ownAdjLsaExist) {
-    return;
+  calculation.result.clearEntries();
+  calculation.lsSpfState.reset();
+
+  LinkStateRoutingTableCalculator calculator(nRouters);
+
+  if (isSinglePath) {
+    calculation.lsGraph.writeLog(map);
+    ShortestPathTree tree(calculation.lsGraph, *sourceRouter);
+    calculator.addAllLsNextHopsToRoutingTable(tree, calculation.adjacencies, calculation.result,
+                                              map);
+    calculation.lsSpfState = std::make_unique<LsSpfState>(LsSpfState{std::move(map),
+                                                                     std::move(calculation.lsGraph),
+                                                                     std::move(tree)});
+  }
+  else {
+    calculator.calculatePath(calculation.lsGraph, map, calculation.result,
+                             calculation.routerPrefix, calculation.maxFacesPerPrefix,
+                             calculation.adjacencies, calculation.isFastRerouteEnabled);
+    // The border routers of the area are reached through both
+    if (calculation.isAreaBorderRouter) {
+      calculator.calculatePath(calculation.lsBackboneGraph, map, calculation.result,
+                               calculation.routerPrefix, calculation.maxFacesPerPrefix,
+                               calculation.adjacencies, calculation.isFastRerouteEnabled);
+    }
+  }
+}
+
+bool
+RoutingTable::updateLsRoutingTableIncrementally(Calculation& calculation, int32_t source)
+{
+  std::unique_ptr<LsSpfState>& state = calculation.lsSpfState;
+  const Map& map = calculation.lsMap;
+  TopologyGraph& graph = calculation.lsGraph;
+
+  // The previous tree can only be reused if it covers the same routers with the same
+  // mapping numbers; routers joining or leaving require a full calculation.
+  if (state == nullptr || state->tree.getSource() != source || !(state->map == map)) {
+    state.reset();
+    return false;
   }
 
-  clearRoutingTable();
+  NLSR_LOG_TRACE("Updating the shortest path tree incrementally");
+  graph.writeLog(map);
+  ShortestPathTree& tree = state->tree;
+  std::vector<int32_t> changed = tree.update(state->graph, graph);
 
-  Map map;
-  auto lsaRange = m_lsdb.getLsdbIterator<AdjLsa>();
-  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  state->graph = std::move(graph);
+  NLSR_LOG_DEBUG("Incremental SPF changed " << changed.size() << " destination(s)");
+
+  RoutingTableStatus& result = calculation.result;
+  LinkStateRoutingTableCalculator calculator(map.getMapSize());
+  std::vector<std::string> faceUris = calculator.getNeighborFaceUris(calculation.adjacencies, map);
+  for (int32_t dest : changed) {
+    result.removeEntry(*map.getRouterIdByMappingNo(dest));
+    calculator.addLsNextHopToRoutingTable(tree, dest, faceUris, result, map);
+  }
+  return true;
+}
+
+void
+RoutingTable::calculateHypRoutingTable(Calculation& calculation)
+{
+  RoutingTableStatus& result = calculation.result;
+  Map& map = calculation.hypMap;
   map.writeLog();
 
   size_t nRouters = map.getMapSize();
 
-  LinkStateRoutingTableCalculator calculator(nRouters);
+  HyperbolicRoutingCalculator calculator(nRouters, calculation.isHypDryRun,
+                                         calculation.routerPrefix, calculation.maxFacesPerPrefix);
 
-  calculator.calculatePath(map, *this, m_confParam, m_lsdb);
+  // Without the state of the previous calculation, the table is not a copy of its result
+  bool hasPreviousState = calculation.hypState != nullptr;
+  if (!hasPreviousState) {
+    calculation.hypState = std::make_unique<HyperbolicRoutingCalculator::State>();
+  }
 
-  NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-  afterRoutingChange(m_rTable);
-  NLSR_LOG_DEBUG(*this);
+  auto changedDestinations = calculator.updateDistances(map, calculation.coordinates,
+                                                        calculation.adjacencies,
+                                                        *calculation.hypState);
+  if (!hasPreviousState || !changedDestinations) {
+    if (calculation.isHypDryRun) {
+      result.clearDryEntries();
+    }
+    else {
+      result.clearEntries();
+    }
+    calculator.addNextHops(*calculation.hypState, result);
+    return;
+  }
+
+  NLSR_LOG_DEBUG("Updating the hyperbolic routes of " << changedDestinations->size()
+                 << " destinations");
+  for (int32_t dest : *changedDestinations) {
+    RouterId destId = *map.getRouterIdByMappingNo(dest);
+    if (calculation.isHypDryRun) {
+      result.removeDryEntry(destId);
+    }
+    else {
+      result.removeEntry(destId);
+    }
+    calculator.addNextHops(*calculation.hypState, dest, result);
+  }
 }
 
 void
-RoutingTable::calculateHypRoutingTable(bool isDryRun)
+RoutingTable::publishCalculation(Calculation& calculation)
 {
-  if (isDryRun) {
-    clearDryRoutingTable();
-  }
-  else {
-    clearRoutingTable();
+  if (calculation.isHypCalculated) {
+    m_hypState = std::move(calculation.hypState);
   }
 
-  Map map;
-  auto lsaRange = m_lsdb.getLsdbIterator<CoordinateLsa>();
-  map.createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
-  map.writeLog();
+  if (calculation.isHypCalculated && calculation.isHypDryRun) {
+    swapDryEntries(calculation.result);
+  }
 
-  size_t nRouters = map.getMapSize();
+  if (!calculation.isLsCalculated && !(calculation.isHypCalculated && !calculation.isHypDryRun)) {
+    return;
+  }
 
-  HyperbolicRoutingCalculator calculator(nRouters, isDryRun, m_confParam.getRouterPrefix());
+  // The changed entries move into m_rTable with the swap
+  RoutingTableDelta delta = diffEntries(calculation.result);
+  swapEntries(calculation.result);
+  if (calculation.isLsCalculated) {
+    m_lsSpfState = std::move(calculation.lsSpfState);
+  }
 
-  calculator.calculatePath(map, *this, m_lsdb, m_confParam.getAdjacencyList());
+  NLSR_LOG_DEBUG("Calling Update NPT With new Route (" << delta.changed.size() << " changed, "
+                 << delta.removed.size() << " removed)");
+  afterRoutingChange(delta);
+  NLSR_LOG_DEBUG(*this);
+}
 
-  if (!isDryRun) {
-    NLSR_LOG_DEBUG("Calling Update NPT With new Route");
-    afterRoutingChange(m_rTable);
-    NLSR_LOG_DEBUG(*this);
+void
+RoutingTable::cancelCalculation()
+{
+  if (m_pendingCalculation != nullptr) {
+    NLSR_LOG_DEBUG("Cancelling the routing table calculation in progress");
+    m_pendingCalculation->isCancelled = true;
+    m_pendingCalculation.reset();
+    m_isRoutingTableCalculating = false;
   }
 }
 
 void
 RoutingTable::scheduleRoutingTableCalculation()
 {
-  if (!m_isRouteCalculationScheduled) {
-    NLSR_LOG_DEBUG("Scheduling routing table calculation in " << m_routingCalcInterval);
-    m_scheduler.schedule(m_routingCalcInterval, [this] { calculate(); });
-    m_isRouteCalculationScheduled = true;
+  cancelCalculation();
+
+  if (m_isRouteCalculationScheduled) {
+    // The scheduled calculation will see this change as well
+    calculationIncrementSignal(Statistics::PacketType::COALESCED_ROUTING_CALC);
+    return;
+  }
+
+  ndn::time::milliseconds delay = getCalculationDelay();
+  NLSR_LOG_DEBUG("Scheduling routing table calculation in " << delay);
+  m_scheduler.schedule(delay, [this] { calculate(); });
+  m_isRouteCalculationScheduled = true;
+}
+
+ndn::time::milliseconds
+RoutingTable::getCalculationDelay()
+{
+  using namespace ndn::time;
+
+  milliseconds maxDelay = m_routingCalcInterval;
+  milliseconds delay;
+  steady_clock::TimePoint now = steady_clock::now();
+
+  if (!m_lastCalculationTime || now - *m_lastCalculationTime >= 2 * m_routingCalcHoldTime) {
+    m_routingCalcHoldTime = m_routingCalcInitialHoldTime;
+    delay = m_routingCalcInitialDelay;
   }
+  else {
+    milliseconds elapsed = duration_cast<milliseconds>(now - *m_lastCalculationTime);
+    delay = std::max(m_routingCalcHoldTime - elapsed, milliseconds::zero());
+    m_routingCalcHoldTime = std::min(2 * m_routingCalcHoldTime, maxDelay);
+  }
+
+  return std::min(delay, maxDelay);
 }
 
-static bool
-routingTableEntryCompare(RoutingTableEntry& rte, ndn::Name& destRouter)
+RoutingTableStatus::RoutingTableStatus(const RoutingTableStatus& other)
+  : m_dryTable(other.m_dryTable)
+  , m_rTable(other.m_rTable)
+  , m_wire(other.m_wire)
 {
-  return rte.getDestination() == destRouter;
+  rebuildIndexes();
+}
+
+RoutingTableStatus&
+RoutingTableStatus::operator=(const RoutingTableStatus& other)
+{
+  if (this != &other) {
+    m_dryTable = other.m_dryTable;
+    m_rTable = other.m_rTable;
+    m_wire = other.m_wire;
+    rebuildIndexes();
+  }
+  return *this;
+}
+
+void
+RoutingTableStatus::rebuildIndexes()
+{
+  m_rTableIndex.clear();
+  for (auto it = m_rTable.begin(); it != m_rTable.end(); ++it) {
+    m_rTableIndex.emplace(it->getDestinationId(), it);
+  }
+  m_dryTableIndex.clear();
+  for (auto it = m_dryTable.begin(); it != m_dryTable.end(); ++it) {
+    m_dryTableIndex.emplace(it->getDestinationId(), it);
+  }
 }
 
 void
-RoutingTable::addNextHop(const ndn::Name& destRouter, NextHop& nh)
+RoutingTableStatus::addNextHop(const ndn::Name& destRouter, NextHop& nh)
 {
   NLSR_LOG_DEBUG("Adding " << nh << " for destination: " << destRouter);
 
-  RoutingTableEntry* rteChk = findRoutingTableEntry(destRouter);
-  if (rteChk == nullptr) {
-    RoutingTableEntry rte(destRouter);
-    rte.getNexthopList().addNextHop(nh);
-    m_rTable.push_back(rte);
-  }
-  else {
-    rteChk->getNexthopList().addNextHop(nh);
+  RoutingTableEntry* rte = findRoutingTableEntry(destRouter);
+  if (rte == nullptr) {
+    auto it = m_rTable.emplace(m_rTable.end(), destRouter);
+    rte = &*it;
+    // Keyed by the ID the entry holds, so the key cannot be reclaimed under the index
+    m_rTableIndex.emplace(rte->getDestinationId(), it);
   }
+  rte->getNexthopList().addNextHop(nh);
   m_wire.reset();
 }
 
 RoutingTableEntry*
-RoutingTable::findRoutingTableEntry(const ndn::Name& destRouter)
+RoutingTableStatus::findRoutingTableEntry(const ndn::Name& destRouter)
 {
-  auto it = std::find_if(m_rTable.begin(), m_rTable.end(),
-                         std::bind(&routingTableEntryCompare, _1, destRouter));
-  if (it != m_rTable.end()) {
-    return &(*it);
+  ndn::optional<RouterId> id = RouterIdTable::get().find(destRouter);
+  if (!id) {
+    return nullptr;
   }
-  return nullptr;
+  auto it = m_rTableIndex.find(*id);
+  return it != m_rTableIndex.end() ? &*it->second : nullptr;
 }
 
 void
-RoutingTable::addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh)
+RoutingTableStatus::addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh)
 {
   NLSR_LOG_DEBUG("Adding " << nh << " to dry table for destination: " << destRouter);
 
-  auto it = std::find_if(m_dryTable.begin(), m_dryTable.end(),
-                         std::bind(&routingTableEntryCompare, _1, destRouter));
-  if (it == m_dryTable.end()) {
-    RoutingTableEntry rte(destRouter);
-    rte.getNexthopList().addNextHop(nh);
-    m_dryTable.push_back(rte);
-  }
-  else {
-    it->getNexthopList().addNextHop(nh);
+  ndn::optional<RouterId> id = RouterIdTable::get().find(destRouter);
+  auto it = id ? m_dryTableIndex.find(*id) : m_dryTableIndex.end();
+  RoutingTableEntry* rte = it != m_dryTableIndex.end() ? &*it->second : nullptr;
+  if (rte == nullptr) {
+    auto entryIt = m_dryTable.emplace(m_dryTable.end(), destRouter);
+    rte = &*entryIt;
+    m_dryTableIndex.emplace(rte->getDestinationId(), entryIt);
   }
+  rte->getNexthopList().addNextHop(nh);
   m_wire.reset();
 }
 
 void
-RoutingTable::clearRoutingTable()
+RoutingTableStatus::clearEntries()
 {
   m_rTable.clear();
+  m_rTableIndex.clear();
   m_wire.reset();
 }
 
 void
-RoutingTable::clearDryRoutingTable()
+RoutingTableStatus::clearDryEntries()
 {
   m_dryTable.clear();
+  m_dryTableIndex.clear();
+  m_wire.reset();
+}
+
+void
+RoutingTableStatus::removeEntry(RouterId destRouter)
+{
+  auto it = m_rTableIndex.find(destRouter);
+  if (it == m_rTableIndex.end()) {
+    return;
+  }
+  m_rTable.erase(it->second);
+  m_rTableIndex.erase(it);
+  m_wire.reset();
+}
+
+void
+RoutingTableStatus::removeDryEntry(RouterId destRouter)
+{
+  auto it = m_dryTableIndex.find(destRouter);
+  if (it == m_dryTableIndex.end()) {
+    return;
+  }
+  m_dryTable.erase(it->second);
+  m_dryTableIndex.erase(it);
+  m_wire.reset();
+}
+
+void
+RoutingTableStatus::swapEntries(RoutingTableStatus& other)
+{
+  // Swapping lists keeps their elements in place, so the indexes stay valid
+  m_rTable.swap(other.m_rTable);
+  m_rTableIndex.swap(other.m_rTableIndex);
   m_wire.reset();
+  other.m_wire.reset();
+}
+
+void
+RoutingTableStatus::swapDryEntries(RoutingTableStatus& other)
+{
+  m_dryTable.swap(other.m_dryTable);
+  m_dryTableIndex.swap(other.m_dryTableIndex);
+  m_wire.reset();
+  other.m_wire.reset();
+}
+
+RoutingTableDelta
+RoutingTableStatus::diffEntries(const RoutingTableStatus& next) const
+{
+  RoutingTableDelta delta;
+  for (const auto& rte : next.m_rTable) {
+    auto it = m_rTableIndex.find(rte.getDestinationId());
+    if (it == m_rTableIndex.end() || it->second->getNexthopList() != rte.getNexthopList()) {
+      delta.changed.push_back(&rte);
+    }
+  }
+  for (const auto& rte : m_rTable) {
+    if (next.m_rTableIndex.count(rte.getDestinationId()) == 0) {
+      delta.removed.emplace_back(rte.getDestinationId());
+    }
+  }
+  return delta;
+}
+
+void
+RoutingTable::clearRoutingTable()
+{
+  clearEntries();
+  m_lsSpfState.reset();
+  m_hypState.reset();
+}
+
+void
+RoutingTable::clearDryRoutingTable()
+{
+  clearDryEntries();
+  m_hypState.reset();
 }
 
 template<ndn::encoding::Tag TAG>
@@ -317,6 +679,8 @@ RoutingTableStatus::wireDecode(const ndn::Block& wire)
   if (val != m_wire.elements_end()) {
     NDN_THROW(Error("Unrecognized TLV of type " + ndn::to_string(val->type()) + " in RoutingTable"));
   }
+
+  rebuildIndexes();
 }
 
 std::ostream&
@@ -24,13 +24,22 @@
 #include "conf-parameter.hpp"
 #include "routing-table-entry.hpp"
 #include "signals.hpp"
+#include "statistics.hpp"
 #include "lsdb.hpp"
 #include "route/fib.hpp"
 #include "test-access-control.hpp"
 #include "route/name-prefix-table.hpp"
+#include "route/map.hpp"
+#include "route/routing-table-calculator.hpp"
+#include "route/shortest-path-tree.hpp"
+#include "route/topology-graph.hpp"
+#include "utility/worker-pool.hpp"
 
 #include <ndn-cxx/util/scheduler.hpp>
 
+#include <atomic>
+#include <unordered_map>
+
 namespace nlsr {
 
 class NextHop;
@@ -54,6 +63,16 @@ public:
     wireDecode(block);
   }
 
+  RoutingTableStatus(const RoutingTableStatus& other);
+
+  RoutingTableStatus(RoutingTableStatus&&) = default;
+
+  RoutingTableStatus&
+  operator=(const RoutingTableStatus& other);
+
+  RoutingTableStatus&
+  operator=(RoutingTableStatus&&) = default;
+
   const std::list<RoutingTableEntry>&
   getRoutingTableEntry() const
   {
@@ -69,6 +88,23 @@ public:
   const ndn::Block&
   wireEncode() const;
 
+  /*! \brief Adds a next hop to a routing table entry.
+   *  \param destRouter The destination router whose RTE we want to modify.
+   *  \param nh The next hop to add to the RTE.
+   */
+  void
+  addNextHop(const ndn::Name& destRouter, NextHop& nh);
+
+  /*! \brief Adds a next hop to a routing table entry in a dry run scenario.
+   *  \param destRouter The destination router whose RTE we want to modify.
+   *  \param nh The next hop to add to the router.
+   */
+  void
+  addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh);
+
+  RoutingTableEntry*
+  findRoutingTableEntry(const ndn::Name& destRouter);
+
 private:
   void
   wireDecode(const ndn::Block& wire);
@@ -77,9 +113,49 @@ private:
   size_t
   wireEncode(ndn::EncodingImpl<TAG>& block) const;
 
+  void
+  rebuildIndexes();
+
+  // RoutingTable fills a separate RoutingTableStatus off the main thread and swaps it in
+  friend class RoutingTable;
+
+PUBLIC_WITH_TESTS_ELSE_PROTECTED:
+  void
+  clearEntries();
+
+  void
+  clearDryEntries();
+
+  /*! \brief Removes the routing table entry of \p destRouter, if there is one. */
+  void
+  removeEntry(RouterId destRouter);
+
+  /*! \brief Removes the dry-run routing table entry of \p destRouter, if there is one. */
+  void
+  removeDryEntry(RouterId destRouter);
+
+  /*! \brief Swaps the routing table entries, but not the dry-run entries, with \p other. */
+  void
+  swapEntries(RoutingTableStatus& other);
+
+  /*! \brief Swaps the dry-run routing table entries with \p other. */
+  void
+  swapDryEntries(RoutingTableStatus& other);
+
+  /*! \brief Returns the destinations whose routes differ between this table and \p next.
+   *
+   *  The changed entries point into \p next.
+   */
+  RoutingTableDelta
+  diffEntries(const RoutingTableStatus& next) const;
+
 PUBLIC_WITH_TESTS_ELSE_PROTECTED:
   std::list<RoutingTableEntry> m_dryTable;
   std::list<RoutingTableEntry> m_rTable;
+  // The entries of both tables indexed by destination; list iterators stay valid until
+  // their element is erased, also across swap(), so entries are erased in constant time
+  std::unordered_map<RouterId, std::list<RoutingTableEntry>::iterator> m_dryTableIndex;
+  std::unordered_map<RouterId, std::list<RoutingTableEntry>::iterator> m_rTableIndex;
   mutable ndn::Block m_wire;
 };
 
@@ -89,52 +165,122 @@ operator<<(std::ostream& os, const RoutingTableStatus& rts);
 class RoutingTable : public RoutingTableStatus
 {
 public:
-  explicit
-  RoutingTable(ndn::Scheduler& scheduler, Lsdb& lsdb, ConfParameter& confParam);
+  /*! \param io The event loop on which finished calculations are published.
+   *
+   *  If the configuration asks for routing calculation threads, calculations run on
+   *  them and the result is posted back to \p io; otherwise they run in place.
+   */
+  RoutingTable(boost::asio::io_service& io, ndn::Scheduler& scheduler, Lsdb& lsdb,
+               ConfParameter& confParam);
 
-  ~RoutingTable()
-  {
-    m_afterLsdbModified.disconnect();
-  }
+  ~RoutingTable();
 
   /*! \brief Calculates a list of next hops for each router in the network.
    *
-   *  Calculates the list of next hops to every other router in the network.
+   *  Calculates the list of next hops to every other router in the network. The LSDB is
+   *  copied first; with routing calculation threads the rest of the work happens on a
+   *  worker, and a calculation that is still running is cancelled.
    */
   void
   calculate();
 
-  /*! \brief Adds a next hop to a routing table entry.
-   *  \param destRouter The destination router whose RTE we want to modify.
-   *  \param nh The next hop to add to the RTE.
+  /*! \brief Schedules a calculation event in the event scheduler only
+   *  if one isn't already scheduled.
+   *
+   *  A calculation that is still running on a worker is cancelled, since its
+   *  snapshot of the LSDB is out of date. The delay follows getCalculationDelay().
    */
   void
-  addNextHop(const ndn::Name& destRouter, NextHop& nh);
+  scheduleRoutingTableCalculation();
 
-  /*! \brief Adds a next hop to a routing table entry in a dry run scenario.
-   *  \param destRouter The destination router whose RTE we want to modify.
-   *  \param nh The next hop to add to the router.
+PUBLIC_WITH_TESTS_ELSE_PRIVATE:
+  /*! \brief Returns the delay of the next calculation and updates the hold time.
+   *
+   *  The first calculation after a quiet period of twice the hold time waits for the
+   *  initial delay. Later ones wait until the hold time has passed since the last
+   *  calculation, and each of them doubles the hold time, up to the routing calculation
+   *  interval, which also bounds every delay.
    */
-  void
-  addNextHopToDryTable(const ndn::Name& destRouter, NextHop& nh);
+  ndn::time::milliseconds
+  getCalculationDelay();
 
-  RoutingTableEntry*
-  findRoutingTableEntry(const ndn::Name& destRouter);
+private:
+  /*! \brief The state of the last single-path link-state calculation,
+   *         kept to update the routing table incrementally.
+   */
+  struct LsSpfState
+  {
+    Map map;
+    TopologyGraph graph;
+    ShortestPathTree tree;
+  };
 
-  /*! \brief Schedules a calculation event in the event scheduler only
-   *  if one isn't already scheduled.
+  /*! \brief A routing table calculation over a snapshot of the LSDB.
+   *
+   *  Everything the calculation reads is copied when it is made on the main thread, so it
+   *  can run on a worker while the LSDB and the adjacency list keep changing.
    */
-  void
-  scheduleRoutingTableCalculation();
+  struct Calculation
+  {
+    ndn::Name routerPrefix;
+    uint32_t maxFacesPerPrefix = 0;
+    bool isFastRerouteEnabled = false;
+    AdjacencyList adjacencies;
+
+    bool isLsCalculated = false;
+    Map lsMap;
+    /*! The whole topology, or only that of its own area on an area border router. */
+    TopologyGraph lsGraph;
+    bool isAreaBorderRouter = false;
+    TopologyGraph lsBackboneGraph;
+    /*! The state of the previous calculation on input, and of this one on output. */
+    std::unique_ptr<LsSpfState> lsSpfState;
+
+    bool isHypCalculated = false;
+    bool isHypDryRun = false;
+    Map hypMap;
+    std::vector<HyperbolicCoordinates> coordinates;
+    /*! The distances of the previous calculation on input, and of this one on output. */
+    std::unique_ptr<HyperbolicRoutingCalculator::State> hypState;
+
+    /*! The new tables, which start as a copy of the current ones. */
+    RoutingTableStatus result;
+    std::atomic<bool> isCancelled{false};
+  };
+
+  /*! \brief Copies the inputs of a calculation out of the LSDB and the configuration. */
+  std::shared_ptr<Calculation>
+  makeCalculation();
+
+  /*! \brief Runs \p calculation; this only touches the calculation itself. */
+  static void
+  runCalculation(Calculation& calculation);
 
-private:
   /*! \brief Calculates a link-state routing table. */
-  void
-  calculateLsRoutingTable();
+  static void
+  calculateLsRoutingTable(Calculation& calculation);
+
+  /*! \brief Updates the single-path link-state routing table by repairing the
+   *         shortest path tree of the previous calculation.
+   *  \param source The mapping number of this router.
+   *  \return false if the previous tree cannot be reused, in which case the routing
+   *          table is not changed.
+   *
+   *  Only the destinations whose next hop or cost moved are updated.
+   */
+  static bool
+  updateLsRoutingTableIncrementally(Calculation& calculation, int32_t source);
 
   /*! \brief Calculates a HR routing table. */
+  static void
+  calculateHypRoutingTable(Calculation& calculation);
+
+  /*! \brief Swaps the result of \p calculation in and updates the NPT. */
+  void
+  publishCalculation(Calculation& calculation);
+
   void
-  calculateHypRoutingTable(bool isDryRun);
+  cancelCalculation();
 
   void
   clearRoutingTable();
@@ -144,13 +290,19 @@ private:
 
 public:
   AfterRoutingChange afterRoutingChange;
+  ndn::util::Signal<RoutingTable, Statistics::PacketType> calculationIncrementSignal;
 
 private:
+  boost::asio::io_service& m_io;
   ndn::Scheduler& m_scheduler;
   Lsdb& m_lsdb;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::time::seconds m_routingCalcInterval;
+  ndn::time::milliseconds m_routingCalcInitialDelay;
+  ndn::time::milliseconds m_routingCalcInitialHoldTime;
+  ndn::time::milliseconds m_routingCalcHoldTime;
+  ndn::optional<ndn::time::steady_clock::TimePoint> m_lastCalculationTime;
   bool m_isRoutingTableCalculating;
   bool m_isRouteCalculationScheduled;
 
@@ -158,6 +310,15 @@ PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   ndn::util::signal::Connection m_afterLsdbModified;
   int32_t m_hyperbolicState;
   bool m_ownAdjLsaExist = false;
+  /*! The coordinates of the Coordinate LSAs in the LSDB, kept up to date as they change. */
+  HyperbolicCoordinateCache m_coordinateCache;
+
+  std::unique_ptr<LsSpfState> m_lsSpfState;
+  std::unique_ptr<HyperbolicRoutingCalculator::State> m_hypState;
+  std::shared_ptr<Calculation> m_pendingCalculation;
+
+  // Declared last so that the workers are joined before anything they use is destroyed
+  util::WorkerPool m_workerPool;
 };
 
 } // namespace nlsr
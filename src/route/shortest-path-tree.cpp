@@ -0,0 +1,250 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "shortest-path-tree.hpp"
+
+#include <boost/assert.hpp>
+
+namespace nlsr {
+
+const int32_t ShortestPathTree::EMPTY_PARENT = -12345;
+const RouteCost ShortestPathTree::INF_DISTANCE = INFINITE_ROUTE_COST;
+const int32_t ShortestPathTree::NO_NEXT_HOP = -12345;
+
+ShortestPathTree::ShortestPathTree(const TopologyGraph& graph, int32_t source,
+                                   const TopologyGraph::Link* sourceLink)
+  : m_source(source)
+  , m_parent(graph.getNRouters(), EMPTY_PARENT)
+  , m_distance(graph.getNRouters(), INF_DISTANCE)
+{
+  IndexedMinHeap<RouteCost> queue(graph.getNRouters());
+
+  // Distance to source from source is always 0.
+  m_distance[source] = 0;
+  queue.pushOrDecrease(source, 0);
+
+  propagate(graph, queue, sourceLink);
+  computeNextHops();
+}
+
+std::vector<int32_t>
+ShortestPathTree::update(const TopologyGraph& oldGraph, const TopologyGraph& newGraph)
+{
+  BOOST_ASSERT(oldGraph.getNRouters() == getNRouters());
+  BOOST_ASSERT(newGraph.getNRouters() == getNRouters());
+
+  const auto nRouters = static_cast<int32_t>(getNRouters());
+
+  struct ChangedLink
+  {
+    int32_t from;
+    int32_t to;
+    RouteCost cost;
+  };
+  std::vector<ChangedLink> increased;
+  std::vector<ChangedLink> decreased;
+
+  // Both graphs keep each router's links sorted by neighbor, so they can be merged row by row
+  for (int32_t u = 0; u < nRouters; ++u) {
+    auto oldLink = oldGraph.linksBegin(u);
+    auto newLink = newGraph.linksBegin(u);
+    while (oldLink != oldGraph.linksEnd(u) || newLink != newGraph.linksEnd(u)) {
+      if (newLink == newGraph.linksEnd(u) ||
+          (oldLink != oldGraph.linksEnd(u) && oldLink->router < newLink->router)) {
+        increased.push_back({u, oldLink->router, INF_DISTANCE});
+        ++oldLink;
+      }
+      else if (oldLink == oldGraph.linksEnd(u) || newLink->router < oldLink->router) {
+        decreased.push_back({u, newLink->router, newLink->cost});
+        ++newLink;
+      }
+      else {
+        if (newLink->cost > oldLink->cost) {
+          increased.push_back({u, newLink->router, newLink->cost});
+        }
+        else if (newLink->cost < oldLink->cost) {
+          decreased.push_back({u, newLink->router, newLink->cost});
+        }
+        ++oldLink;
+        ++newLink;
+      }
+    }
+  }
+
+  if (increased.empty() && decreased.empty()) {
+    return {};
+  }
+
+  const std::vector<RouteCost> oldDistance = m_distance;
+  const std::vector<int32_t> oldNextHop = m_nextHop;
+
+  // Routers whose tree path uses a link that got worse must be recomputed, and so must
+  // their whole subtree. Children are grouped by parent with a counting sort.
+  std::vector<bool> isAffected(nRouters, false);
+  std::vector<int32_t> affected;
+  std::vector<int32_t> childOffsets(nRouters + 1, 0);
+  std::vector<int32_t> children(nRouters);
+  for (int32_t v = 0; v < nRouters; ++v) {
+    if (m_parent[v] != EMPTY_PARENT) {
+      ++childOffsets[m_parent[v] + 1];
+    }
+  }
+  for (int32_t v = 0; v < nRouters; ++v) {
+    childOffsets[v + 1] += childOffsets[v];
+  }
+  {
+    std::vector<int32_t> cursor(childOffsets.begin(), childOffsets.end() - 1);
+    for (int32_t v = 0; v < nRouters; ++v) {
+      if (m_parent[v] != EMPTY_PARENT) {
+        children[cursor[m_parent[v]]++] = v;
+      }
+    }
+  }
+
+  for (const auto& link : increased) {
+    if (m_parent[link.to] != link.from || isAffected[link.to]) {
+      continue;
+    }
+    size_t first = affected.size();
+    isAffected[link.to] = true;
+    affected.push_back(link.to);
+    for (size_t i = first; i < affected.size(); ++i) {
+      int32_t v = affected[i];
+      for (int32_t c = childOffsets[v]; c < childOffsets[v + 1]; ++c) {
+        if (!isAffected[children[c]]) {
+          isAffected[children[c]] = true;
+          affected.push_back(children[c]);
+        }
+      }
+    }
+  }
+
+  for (int32_t v : affected) {
+    m_parent[v] = EMPTY_PARENT;
+    m_distance[v] = INF_DISTANCE;
+  }
+
+  IndexedMinHeap<RouteCost> queue(nRouters);
+
+  // Seed the affected routers from their unaffected neighbors. Links are symmetric, so the
+  // links leaving v are also the links entering it.
+  for (int32_t v : affected) {
+    for (auto link = newGraph.linksBegin(v); link != newGraph.linksEnd(v); ++link) {
+      int32_t u = link->router;
+      if (!isAffected[u] && m_distance[u] != INF_DISTANCE &&
+          addRouteCost(m_distance[u], link->cost) < m_distance[v]) {
+        m_distance[v] = addRouteCost(m_distance[u], link->cost);
+        m_parent[v] = u;
+      }
+    }
+    if (m_distance[v] != INF_DISTANCE) {
+      queue.pushOrDecrease(v, m_distance[v]);
+    }
+  }
+
+  // Relax the links that got better
+  for (const auto& link : decreased) {
+    if (isAffected[link.from] || m_distance[link.from] == INF_DISTANCE) {
+      continue;
+    }
+    RouteCost distance = addRouteCost(m_distance[link.from], link.cost);
+    if (distance < m_distance[link.to]) {
+      m_distance[link.to] = distance;
+      m_parent[link.to] = link.from;
+      queue.pushOrDecrease(link.to, distance);
+    }
+  }
+
+  propagate(newGraph, queue, nullptr);
+  computeNextHops();
+
+  std::vector<int32_t> changed;
+  for (int32_t v = 0; v < nRouters; ++v) {
+    if (m_distance[v] != oldDistance[v] || m_nextHop[v] != oldNextHop[v]) {
+      changed.push_back(v);
+    }
+  }
+  return changed;
+}
+
+void
+ShortestPathTree::propagate(const TopologyGraph& graph, IndexedMinHeap<RouteCost>& queue,
+                            const TopologyGraph::Link* sourceLink)
+{
+  // Routers whose shortest distance is final
+  std::vector<bool> visited(m_distance.size(), false);
+
+  while (!queue.empty()) {
+    int32_t u = queue.pop();
+    visited[u] = true;
+
+    const TopologyGraph::Link* first = graph.linksBegin(u);
+    const TopologyGraph::Link* last = graph.linksEnd(u);
+    if (u == m_source && sourceLink != nullptr) {
+      // Simulate that only the given neighbor is accessible
+      first = sourceLink;
+      last = sourceLink + 1;
+    }
+
+    // Iterate over the adjacent nodes to u.
+    for (auto link = first; link != last; ++link) {
+      int32_t v = link->router;
+      // If we haven't visited v yet and the distance to u + from u to v is less than
+      // the best distance to v found so far
+      if (!visited[v] && addRouteCost(m_distance[u], link->cost) < m_distance[v]) {
+        // Set the new distance and how we get there.
+        m_distance[v] = addRouteCost(m_distance[u], link->cost);
+        m_parent[v] = u;
+        queue.pushOrDecrease(v, m_distance[v]);
+      }
+    }
+  }
+}
+
+void
+ShortestPathTree::computeNextHops()
+{
+  const auto nRouters = static_cast<int32_t>(m_parent.size());
+  m_nextHop.assign(nRouters, NO_NEXT_HOP);
+
+  std::vector<bool> isKnown(nRouters, false);
+  std::vector<int32_t> path;
+  for (int32_t v = 0; v < nRouters; ++v) {
+    // Walk up until a router whose next hop is known or that is a child of the source
+    int32_t u = v;
+    while (!isKnown[u] && m_parent[u] != EMPTY_PARENT && m_parent[u] != m_source) {
+      path.push_back(u);
+      u = m_parent[u];
+    }
+    if (!isKnown[u]) {
+      isKnown[u] = true;
+      if (m_parent[u] == m_source) {
+        m_nextHop[u] = u;
+      }
+    }
+    for (int32_t w : path) {
+      isKnown[w] = true;
+      m_nextHop[w] = m_nextHop[u];
+    }
+    path.clear();
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,124 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_SHORTEST_PATH_TREE_HPP
+#define NLSR_SHORTEST_PATH_TREE_HPP
+
+#include "indexed-heap.hpp"
+#include "topology-graph.hpp"
+
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief A single-source shortest path tree over a TopologyGraph.
+ *
+ * The tree is computed with Dijkstra's algorithm on construction. It can then be moved to a
+ * newer graph over the same routers with update(), which only repairs the part of the tree
+ * affected by the links that changed, in the style of Ramalingam and Reps' dynamic
+ * shortest path algorithm:
+ *
+ *  -# routers whose tree path crosses a link that got more expensive or disappeared lose
+ *     their distance, together with their whole subtree;
+ *  -# those routers are seeded from their unaffected neighbors, and the far ends of links
+ *     that got cheaper or appeared are relaxed;
+ *  -# a Dijkstra pass started from these seeds propagates the improvements.
+ *
+ * The resulting distances are the same as those of a full calculation. Among equal-cost
+ * paths, the repaired tree may keep a different parent than a full calculation would pick.
+ */
+class ShortestPathTree
+{
+public:
+  /*! \brief Computes the tree rooted at \p source.
+    \param graph The topology graph to compute paths over.
+    \param source The mapping number of the root router.
+    \param sourceLink If not null, the only link of \p source that may be used.
+  */
+  ShortestPathTree(const TopologyGraph& graph, int32_t source,
+                   const TopologyGraph::Link* sourceLink = nullptr);
+
+  /*! \brief Moves the tree from \p oldGraph to \p newGraph.
+    \param oldGraph The graph this tree was last computed or updated over.
+    \param newGraph The new graph; it must number the same routers in the same way.
+    \return The routers whose distance or next hop changed, in ascending order.
+    \pre The tree was constructed without a \c sourceLink.
+  */
+  std::vector<int32_t>
+  update(const TopologyGraph& oldGraph, const TopologyGraph& newGraph);
+
+  int32_t
+  getSource() const
+  {
+    return m_source;
+  }
+
+  size_t
+  getNRouters() const
+  {
+    return m_distance.size();
+  }
+
+  RouteCost
+  getDistance(int32_t router) const
+  {
+    return m_distance[router];
+  }
+
+  int32_t
+  getParent(int32_t router) const
+  {
+    return m_parent[router];
+  }
+
+  /*! \brief Returns the neighbor of the source on the path to \p router,
+             or NO_NEXT_HOP if \p router is the source or is unreachable.
+  */
+  int32_t
+  getNextHop(int32_t router) const
+  {
+    return m_nextHop[router];
+  }
+
+private:
+  /*! \brief Runs Dijkstra's algorithm from the routers queued in \p queue. */
+  void
+  propagate(const TopologyGraph& graph, IndexedMinHeap<RouteCost>& queue,
+            const TopologyGraph::Link* sourceLink);
+
+  /*! \brief Derives the next hop of every router from the parent array. */
+  void
+  computeNextHops();
+
+public:
+  static const int32_t EMPTY_PARENT;
+  static const RouteCost INF_DISTANCE;
+  static const int32_t NO_NEXT_HOP;
+
+private:
+  int32_t m_source;
+  std::vector<int32_t> m_parent;
+  std::vector<RouteCost> m_distance;
+  std::vector<int32_t> m_nextHop;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_SHORTEST_PATH_TREE_HPP
@@ -0,0 +1,225 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "topology-graph.hpp"
+#include "map.hpp"
+#include "adjacent.hpp"
+#include "lsdb.hpp"
+#include "logger.hpp"
+
+#include <algorithm>
+
+namespace nlsr {
+
+INIT_LOGGER(route.TopologyGraph);
+
+TopologyGraph::TopologyGraph(const Lsdb& lsdb, const Map& map, const LsaFilter& filter)
+  : m_offsets(map.getMapSize() + 1, 0)
+{
+  const auto nRouters = static_cast<int32_t>(map.getMapSize());
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+
+  // Count the links advertised by every router
+  size_t nLinks = 0;
+  for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; ++lsaIt) {
+    auto adjLsa = std::static_pointer_cast<AdjLsa>(*lsaIt);
+    if (filter && !filter(*adjLsa)) {
+      continue;
+    }
+    ndn::optional<int32_t> row = map.getMappingNoByRouterId(adjLsa->getOriginRouterId());
+    if (row && *row < nRouters) {
+      size_t degree = adjLsa->getAdl().size();
+      m_offsets[*row + 1] += degree;
+      nLinks += degree;
+    }
+  }
+  for (int32_t i = 0; i < nRouters; ++i) {
+    m_offsets[i + 1] += m_offsets[i];
+  }
+
+  // Place each link into its router's row
+  m_links.resize(nLinks, Link{-1, INFINITE_ROUTE_COST});
+  std::vector<uint32_t> cursor(m_offsets.begin(), m_offsets.end() - 1);
+  for (auto lsaIt = lsaRange.first; lsaIt != lsaRange.second; ++lsaIt) {
+    auto adjLsa = std::static_pointer_cast<AdjLsa>(*lsaIt);
+    if (filter && !filter(*adjLsa)) {
+      continue;
+    }
+    ndn::optional<int32_t> row = map.getMappingNoByRouterId(adjLsa->getOriginRouterId());
+    if (!row || *row >= nRouters) {
+      continue;
+    }
+    for (const auto& adjacent : adjLsa->getAdl().getAdjList()) {
+      ndn::optional<int32_t> col = map.getMappingNoByRouterId(adjacent.getNameId());
+      if (col && *col < nRouters) {
+        m_links[cursor[*row]++] = Link{*col, adjacent.getFixedLinkCost()};
+      }
+    }
+  }
+
+  normalizeRows();
+  reconcileCosts();
+  removeBrokenLinks();
+  m_links.shrink_to_fit();
+}
+
+void
+TopologyGraph::normalizeRows()
+{
+  size_t out = 0;
+  for (size_t row = 0; row + 1 < m_offsets.size(); ++row) {
+    auto first = m_links.begin() + m_offsets[row];
+    auto last = m_links.begin() + m_offsets[row + 1];
+    std::stable_sort(first, last, [] (const Link& a, const Link& b) {
+      return a.router < b.router;
+    });
+
+    m_offsets[row] = out;
+    for (auto it = first; it != last; ++it) {
+      if (it->router < 0 || it->router == static_cast<int32_t>(row)) {
+        continue;
+      }
+      if (it + 1 != last && (it + 1)->router == it->router) {
+        // A later advertisement of the same neighbor overrides this one
+        continue;
+      }
+      m_links[out++] = *it;
+    }
+  }
+  m_offsets.back() = out;
+  m_links.resize(out);
+}
+
+void
+TopologyGraph::reconcileCosts()
+{
+  // Links that do not have the same cost for both directions should
+  // have their costs corrected:
+  //
+  //   If the cost of one side of the link is INFINITE_ROUTE_COST (i.e. broken, or advertised
+  //   with a negative cost), both direction of the link should have their cost corrected
+  //   to INFINITE_ROUTE_COST.
+  //
+  //   Otherwise, both sides of the link should use the larger of the two costs.
+  //
+  // Each pair is visited once from its lower-numbered end; a link whose reverse
+  // direction was never advertised is visited from either end.
+  for (size_t row = 0; row + 1 < m_offsets.size(); ++row) {
+    for (size_t i = m_offsets[row]; i < m_offsets[row + 1]; ++i) {
+      int32_t col = m_links[i].router;
+      size_t j = findLink(col, static_cast<int32_t>(row));
+
+      RouteCost toCost = m_links[i].cost;
+      RouteCost fromCost = j == m_links.size() ? INFINITE_ROUTE_COST : m_links[j].cost;
+      if (j != m_links.size() && col < static_cast<int32_t>(row)) {
+        // Already handled from the other end
+        continue;
+      }
+
+      if (fromCost != toCost) {
+        // If both sides of the link are up, use the larger cost else break the link.
+        // A broken side has the largest possible cost, so the larger cost covers both.
+        RouteCost correctedCost = std::max(toCost, fromCost);
+
+        NLSR_LOG_WARN("Cost between [" << row << "][" << col << "] and [" << col << "][" << row <<
+                      "] are not the same (" << toCost << " != " << fromCost << "). " <<
+                      "Correcting to cost: " << correctedCost);
+
+        m_links[i].cost = correctedCost;
+        if (j != m_links.size()) {
+          m_links[j].cost = correctedCost;
+        }
+      }
+    }
+  }
+}
+
+void
+TopologyGraph::removeBrokenLinks()
+{
+  size_t out = 0;
+  for (size_t row = 0; row + 1 < m_offsets.size(); ++row) {
+    size_t first = m_offsets[row];
+    size_t last = m_offsets[row + 1];
+    m_offsets[row] = out;
+    for (size_t i = first; i < last; ++i) {
+      if (m_links[i].cost != INFINITE_ROUTE_COST) {
+        m_links[out++] = m_links[i];
+      }
+    }
+  }
+  m_offsets.back() = out;
+  m_links.resize(out);
+}
+
+size_t
+TopologyGraph::findLink(int32_t from, int32_t to) const
+{
+  auto first = m_links.begin() + m_offsets[from];
+  auto last = m_links.begin() + m_offsets[from + 1];
+  auto it = std::lower_bound(first, last, to, [] (const Link& link, int32_t router) {
+    return link.router < router;
+  });
+  if (it == last || it->router != to) {
+    return m_links.size();
+  }
+  return std::distance(m_links.begin(), it);
+}
+
+RouteCost
+TopologyGraph::getLinkCost(int32_t from, int32_t to) const
+{
+  size_t pos = findLink(from, to);
+  return pos == m_links.size() ? INFINITE_ROUTE_COST : m_links[pos].cost;
+}
+
+namespace {
+
+/*! \brief Prints the links of one router, so that they are only formatted when logged. */
+struct LinksOf
+{
+  const TopologyGraph& graph;
+  int32_t router;
+};
+
+std::ostream&
+operator<<(std::ostream& os, const LinksOf& links)
+{
+  for (auto link = links.graph.linksBegin(links.router);
+       link != links.graph.linksEnd(links.router); ++link) {
+    os << link->router << ":" << fromRouteCost(link->cost) << " ";
+  }
+  return os;
+}
+
+} // anonymous namespace
+
+void
+TopologyGraph::writeLog(const Map& map) const
+{
+  NLSR_LOG_DEBUG("-----------Topology (" << getNRouters() << " routers, " <<
+                 getNLinks() << " links)------");
+  for (size_t i = 0; i < getNRouters(); ++i) {
+    NLSR_LOG_DEBUG("Router:" << map.getRouterNameByMappingNo(i)->toUri() <<
+                   " Index:" << i << " Links: " << LinksOf{*this, static_cast<int32_t>(i)});
+  }
+}
+
+} // namespace nlsr
@@ -0,0 +1,139 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_TOPOLOGY_GRAPH_HPP
+#define NLSR_TOPOLOGY_GRAPH_HPP
+
+#include "common.hpp"
+#include "route-cost.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace nlsr {
+
+class AdjLsa;
+class Lsdb;
+class Map;
+
+/*! \brief An immutable view of the network topology in compressed sparse row form.
+ *
+ * Routers are identified by their mapping number in a Map. The links leaving router \c i
+ * are stored contiguously, sorted by neighbor, in the range [offsets[i], offsets[i + 1]).
+ * Memory use is therefore proportional to the number of links rather than to the square of
+ * the number of routers.
+ *
+ * Only usable links are kept: a link is present if and only if both of its ends advertise
+ * it with a non-negative cost, and both directions then use the larger of the two costs.
+ * Costs are converted to fixed point once, when the graph is built.
+ */
+class TopologyGraph
+{
+public:
+  struct Link
+  {
+    int32_t router;
+    RouteCost cost;
+  };
+
+  /*! Selects the adjacency LSAs whose links make up the graph. */
+  using LsaFilter = std::function<bool(const AdjLsa&)>;
+
+  TopologyGraph() = default;
+
+  /*! \brief Builds the graph from the adjacency LSAs in \p lsdb.
+    \param lsdb The Lsdb holding the adjacency LSAs.
+    \param map The map that assigns a mapping number to every router in the LSAs.
+    \param filter If set, only the LSAs it accepts advertise links, e.g. the LSAs of
+                  the routers in one area; links to the other routers are one-sided
+                  and therefore left out.
+  */
+  TopologyGraph(const Lsdb& lsdb, const Map& map, const LsaFilter& filter = nullptr);
+
+  size_t
+  getNRouters() const
+  {
+    return m_offsets.empty() ? 0 : m_offsets.size() - 1;
+  }
+
+  size_t
+  getNLinks() const
+  {
+    return m_links.size();
+  }
+
+  const Link*
+  linksBegin(int32_t router) const
+  {
+    return m_links.data() + m_offsets[router];
+  }
+
+  const Link*
+  linksEnd(int32_t router) const
+  {
+    return m_links.data() + m_offsets[router + 1];
+  }
+
+  size_t
+  getDegree(int32_t router) const
+  {
+    return m_offsets[router + 1] - m_offsets[router];
+  }
+
+  /*! \brief Returns the cost of the link from \p from to \p to, or
+             INFINITE_ROUTE_COST if there is no such link.
+  */
+  RouteCost
+  getLinkCost(int32_t from, int32_t to) const;
+
+  /*! \brief Writes the links of every router to the DEBUG log. */
+  void
+  writeLog(const Map& map) const;
+
+private:
+  /*! \brief Returns the position of the link from \p from to \p to in m_links,
+             or m_links.size() if there is no such link.
+  */
+  size_t
+  findLink(int32_t from, int32_t to) const;
+
+  /*! \brief Sorts every row by neighbor and drops self-links and duplicates.
+
+    When a router advertises the same neighbor twice, the last advertisement wins.
+  */
+  void
+  normalizeRows();
+
+  /*! \brief Makes every link symmetric and drops broken ones. */
+  void
+  reconcileCosts();
+
+  /*! \brief Removes the links whose cost is INFINITE_ROUTE_COST. */
+  void
+  removeBrokenLinks();
+
+private:
+  std::vector<uint32_t> m_offsets;
+  std::vector<Link> m_links;
+};
+
+} // namespace nlsr
+
+#endif // NLSR_TOPOLOGY_GRAPH_HPP
@@ -0,0 +1,357 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "router-id.hpp"
+
+#include <algorithm>
+#include <stdexcept>
+#include <string>
+
+namespace nlsr {
+
+constexpr RouterId RouterIdTable::INVALID_ID;
+constexpr size_t RouterIdTable::CHUNK_SIZE;
+constexpr size_t RouterIdTable::MAX_CHUNKS;
+constexpr size_t RouterIdTable::MAX_IDS;
+constexpr uint64_t RouterIdTable::Index::EMPTY;
+constexpr uint64_t RouterIdTable::Index::TOMBSTONE;
+constexpr uint64_t RouterIdTable::Index::TAG_MASK;
+
+RouterIdTable::Index::Index(size_t capacity)
+  : mask(capacity - 1)
+  , slots(new std::atomic<uint64_t>[capacity]())
+{
+}
+
+RouterIdTable::~RouterIdTable()
+{
+  for (auto& chunk : m_chunks) {
+    delete chunk.load(std::memory_order_relaxed);
+  }
+}
+
+RouterIdTable&
+RouterIdTable::get()
+{
+  static RouterIdTable table;
+  return table;
+}
+
+std::shared_ptr<RouterIdTable::Entry>
+RouterIdTable::loadEntry(RouterId id) const
+{
+  if (id >= MAX_IDS) {
+    return nullptr;
+  }
+  Chunk* chunk = m_chunks[id / CHUNK_SIZE].load(std::memory_order_acquire);
+  return chunk == nullptr ? nullptr : std::atomic_load(&(*chunk)[id % CHUNK_SIZE]);
+}
+
+std::shared_ptr<RouterIdTable::Entry>
+RouterIdTable::findEntry(const ndn::Name& name, uint64_t hash) const
+{
+  // An index replaced by a writer in the meantime may miss a new name or point to a
+  // reclaimed ID; the entry is always checked, so neither gives a wrong answer
+  std::shared_ptr<Index> index = std::atomic_load(&m_index);
+  uint64_t tag = Index::makeSlot(hash, 0) & Index::TAG_MASK;
+  for (size_t i = index->getHome(tag), n = 0; n <= index->mask; i = (i + 1) & index->mask, ++n) {
+    uint64_t slot = index->slots[i].load(std::memory_order_acquire);
+    if (slot == Index::EMPTY) {
+      break;
+    }
+    if (slot == Index::TOMBSTONE || (slot & Index::TAG_MASK) != tag) {
+      continue;
+    }
+    auto entry = loadEntry(Index::getId(slot));
+    if (entry != nullptr && entry->hash == hash && entry->name == name) {
+      return entry;
+    }
+  }
+  return nullptr;
+}
+
+RouterId
+RouterIdTable::intern(const ndn::Name& name)
+{
+  uint64_t hash = RouterIdTable::hash(name);
+  if (auto entry = findEntry(name, hash)) {
+    return entry->id;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // Another writer may have given the name an ID since the lookup
+  if (auto entry = findEntry(name, hash)) {
+    return entry->id;
+  }
+  return insert(name, hash)->id;
+}
+
+ndn::optional<RouterId>
+RouterIdTable::find(const ndn::Name& name) const
+{
+  if (auto entry = findEntry(name, RouterIdTable::hash(name))) {
+    return entry->id;
+  }
+  return ndn::nullopt;
+}
+
+RouterId
+RouterIdTable::acquire(const ndn::Name& name)
+{
+  uint64_t hash = RouterIdTable::hash(name);
+  auto entry = findEntry(name, hash);
+  if (entry != nullptr && tryAcquire(*entry)) {
+    return entry->id;
+  }
+
+  // Taking the first reference races with reclaiming the ID, so it is done under the lock
+  std::lock_guard<std::mutex> lock(m_mutex);
+  entry = findEntry(name, hash);
+  if (entry == nullptr) {
+    entry = insert(name, hash);
+  }
+  entry->nRefs.fetch_add(1, std::memory_order_relaxed);
+  return entry->id;
+}
+
+void
+RouterIdTable::acquire(RouterId id)
+{
+  auto entry = loadEntry(id);
+  if (entry != nullptr && tryAcquire(*entry)) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  entry = loadEntry(id);
+  if (entry == nullptr) {
+    NDN_THROW(std::out_of_range("Router ID " + std::to_string(id) + " is not given out"));
+  }
+  entry->nRefs.fetch_add(1, std::memory_order_relaxed);
+}
+
+void
+RouterIdTable::release(RouterId id) noexcept
+{
+  // The caller holds a reference, so the ID still has this entry
+  auto entry = loadEntry(id);
+  if (entry->nRefs.fetch_sub(1, std::memory_order_acq_rel) != 1) {
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  // The ID may have been referenced again, or reclaimed by a later release, in the meantime
+  if (loadEntry(id) != entry || entry->nRefs.load(std::memory_order_relaxed) != 0) {
+    return;
+  }
+
+  Index& index = *m_index;
+  uint64_t slot = Index::makeSlot(entry->hash, id);
+  for (size_t i = index.getHome(slot); ; i = (i + 1) & index.mask) {
+    if (index.slots[i].load(std::memory_order_relaxed) == slot) {
+      index.slots[i].store(Index::TOMBSTONE, std::memory_order_release);
+      break;
+    }
+  }
+  std::atomic_store(&(*m_chunks[id / CHUNK_SIZE])[id % CHUNK_SIZE], std::shared_ptr<Entry>());
+  // Never allocates: capacity for every slot was reserved when the slot was first used
+  m_freeIds.push_back(id);
+  m_nIds.fetch_sub(1, std::memory_order_relaxed);
+}
+
+std::shared_ptr<RouterIdTable::Entry>
+RouterIdTable::insert(const ndn::Name& name, uint64_t hash)
+{
+  bool isReused = !m_freeIds.empty();
+  if (!isReused && m_nSlots >= MAX_IDS) {
+    NDN_THROW(std::length_error("Cannot give out more than " + std::to_string(MAX_IDS) +
+                                " router IDs"));
+  }
+  RouterId id = isReused ? m_freeIds.back() : m_nSlots;
+
+  // Allocate everything before changing the table
+  auto entry = std::make_shared<Entry>(name, hash, id);
+  std::atomic<Chunk*>& chunk = m_chunks[id / CHUNK_SIZE];
+  if (chunk.load(std::memory_order_relaxed) == nullptr) {
+    chunk.store(new Chunk(), std::memory_order_release);
+  }
+  if (!isReused && m_freeIds.capacity() <= m_nSlots) {
+    m_freeIds.reserve(std::max<size_t>(2 * m_freeIds.capacity(), m_nSlots + 1));
+  }
+  addToIndex(Index::makeSlot(hash, id));
+
+  // Published after the index, which readers always check against the entry
+  std::atomic_store(&(*chunk.load(std::memory_order_relaxed))[id % CHUNK_SIZE], entry);
+  if (isReused) {
+    m_freeIds.pop_back();
+  }
+  else {
+    ++m_nSlots;
+  }
+  m_nIds.fetch_add(1, std::memory_order_relaxed);
+  return entry;
+}
+
+void
+RouterIdTable::addToIndex(uint64_t slot)
+{
+  if ((m_index->nUsed + 1) * 2 > m_index->mask + 1) {
+    // Tombstones are dropped, and the new index is at most a quarter full
+    size_t capacity = 16;
+    while (capacity < (m_nIds.load(std::memory_order_relaxed) + 1) * 4) {
+      capacity *= 2;
+    }
+    auto index = std::make_shared<Index>(capacity);
+    for (size_t i = 0; i <= m_index->mask; ++i) {
+      uint64_t oldSlot = m_index->slots[i].load(std::memory_order_relaxed);
+      if (oldSlot == Index::EMPTY || oldSlot == Index::TOMBSTONE) {
+        continue;
+      }
+      size_t j = index->getHome(oldSlot);
+      while (index->slots[j].load(std::memory_order_relaxed) != Index::EMPTY) {
+        j = (j + 1) & index->mask;
+      }
+      index->slots[j].store(oldSlot, std::memory_order_relaxed);
+      ++index->nUsed;
+    }
+    std::atomic_store(&m_index, std::move(index));
+  }
+
+  Index& index = *m_index;
+  size_t i = index.getHome(slot);
+  while (true) {
+    uint64_t current = index.slots[i].load(std::memory_order_relaxed);
+    if (current == Index::EMPTY || current == Index::TOMBSTONE) {
+      if (current == Index::EMPTY) {
+        ++index.nUsed;
+      }
+      index.slots[i].store(slot, std::memory_order_release);
+      return;
+    }
+    i = (i + 1) & index.mask;
+  }
+}
+
+bool
+RouterIdTable::tryAcquire(Entry& entry) noexcept
+{
+  uint32_t nRefs = entry.nRefs.load(std::memory_order_relaxed);
+  do {
+    if (nRefs == 0) {
+      return false;
+    }
+  } while (!entry.nRefs.compare_exchange_weak(nRefs, nRefs + 1, std::memory_order_relaxed));
+  return true;
+}
+
+uint64_t
+RouterIdTable::hash(const ndn::Name& name) noexcept
+{
+  // 64-bit FNV-1a
+  constexpr uint64_t FNV_OFFSET_BASIS = 14695981039346656037ULL;
+  constexpr uint64_t FNV_PRIME = 1099511628211ULL;
+
+  uint64_t hash = FNV_OFFSET_BASIS;
+  auto mix = [&hash] (uint64_t value) {
+    for (int i = 0; i < 8; ++i) {
+      hash = (hash ^ ((value >> (8 * i)) & 0xFF)) * FNV_PRIME;
+    }
+  };
+
+  for (const auto& component : name) {
+    // The type and length keep "/ab/c" and "/a/bc" apart
+    mix(component.type());
+    mix(component.value_size());
+    const uint8_t* value = component.value();
+    for (size_t i = 0; i < component.value_size(); ++i) {
+      hash = (hash ^ value[i]) * FNV_PRIME;
+    }
+  }
+  return hash;
+}
+
+const ndn::Name&
+RouterIdTable::getName(RouterId id) const
+{
+  auto entry = loadEntry(id);
+  if (entry == nullptr) {
+    NDN_THROW(std::out_of_range("Router ID " + std::to_string(id) + " is not given out"));
+  }
+  // The entry stays in the table while the caller holds a reference on the ID
+  return entry->name;
+}
+
+size_t
+RouterIdTable::size() const
+{
+  return m_nIds.load(std::memory_order_relaxed);
+}
+
+RouterIdRef::RouterIdRef(RouterId id)
+{
+  RouterIdTable::get().acquire(id);
+  m_id = id;
+}
+
+RouterIdRef::RouterIdRef(const RouterIdRef& other)
+  : m_id(other.m_id)
+{
+  if (m_id != RouterIdTable::INVALID_ID) {
+    RouterIdTable::get().acquire(m_id);
+  }
+}
+
+RouterIdRef::RouterIdRef(RouterIdRef&& other) noexcept
+  : m_id(other.m_id)
+{
+  other.m_id = RouterIdTable::INVALID_ID;
+}
+
+RouterIdRef&
+RouterIdRef::operator=(RouterIdRef other) noexcept
+{
+  std::swap(m_id, other.m_id);
+  return *this;
+}
+
+RouterIdRef::~RouterIdRef()
+{
+  reset();
+}
+
+RouterId
+RouterIdRef::intern(const ndn::Name& name)
+{
+  if (m_id == RouterIdTable::INVALID_ID) {
+    m_id = RouterIdTable::get().acquire(name);
+  }
+  return m_id;
+}
+
+void
+RouterIdRef::reset() noexcept
+{
+  if (m_id != RouterIdTable::INVALID_ID) {
+    RouterIdTable::get().release(m_id);
+    m_id = RouterIdTable::INVALID_ID;
+  }
+}
+
+} // namespace nlsr
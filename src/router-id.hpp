@@ -0,0 +1,271 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_ROUTER_ID_HPP
+#define NLSR_ROUTER_ID_HPP
+
+#include "common.hpp"
+
+#include <boost/noncopyable.hpp>
+
+#include <array>
+#include <atomic>
+#include <limits>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+
+namespace nlsr {
+
+/*! \brief A dense integer that stands for a router name. */
+using RouterId = uint32_t;
+
+/*! \brief The process-wide table of router IDs.
+ *
+ * IDs are given out densely from 0, so routing calculations, the LSDB and the NPT can
+ * compare, hash and index routers by ID instead of by Name.
+ *
+ * Objects that cache an ID hold a RouterIdRef on it. When the last RouterIdRef on an ID is
+ * dropped, its name is removed and the ID is given to the next new name, so the table holds
+ * at most as many IDs as there are routers in use at the same time, plus the names passed to
+ * intern() that were never referenced. An ID must therefore not be kept past the lifetime of
+ * the object it was read from without a RouterIdRef.
+ *
+ * Entries are kept in fixed-size chunks that are never moved, and names are found through
+ * an open-addressing index of tagged IDs. Giving out or reclaiming an ID therefore writes
+ * one entry and one index slot; only growing the index past half full rebuilds it, which
+ * costs amortized constant time per ID. At most MAX_IDS IDs can be given out at once.
+ *
+ * Lookups and references on IDs in use do not take the table's lock, so the table may be
+ * used from any thread.
+ */
+class RouterIdTable : boost::noncopyable
+{
+public:
+  ~RouterIdTable();
+
+  /*! \brief Returns the table shared by the whole process. */
+  static RouterIdTable&
+  get();
+
+  /*! \brief Returns the ID of \p name, giving it a new ID if it does not have one yet.
+   *
+   * A new ID given out here is not referenced; it is kept until a RouterIdRef on it is
+   * taken and dropped again.
+   *
+   * \throw std::length_error MAX_IDS IDs are given out already
+   */
+  RouterId
+  intern(const ndn::Name& name);
+
+  /*! \brief Returns the ID of \p name, if it has one. */
+  ndn::optional<RouterId>
+  find(const ndn::Name& name) const;
+
+  /*! \brief Returns a 64-bit hash of \p name.
+   *
+   * The hash is computed over the TLV types and values of the components, which a decoded
+   * Name already holds, so unlike std::hash<ndn::Name> it never encodes the name and never
+   * allocates.
+   */
+  static uint64_t
+  hash(const ndn::Name& name) noexcept;
+
+  /*! \brief Returns the name that \p id stands for.
+   *
+   * The reference stays valid while the caller holds a reference on \p id.
+   *
+   * \throw std::out_of_range \p id is not given out
+   */
+  const ndn::Name&
+  getName(RouterId id) const;
+
+  /*! \brief Returns the number of IDs given out. */
+  size_t
+  size() const;
+
+private:
+  /*! \brief Takes a reference on the ID of \p name, giving it a new ID if needed. */
+  RouterId
+  acquire(const ndn::Name& name);
+
+  /*! \brief Takes another reference on \p id. */
+  void
+  acquire(RouterId id);
+
+  /*! \brief Drops a reference on \p id, reclaiming the ID when it was the last one. */
+  void
+  release(RouterId id) noexcept;
+
+public:
+  static constexpr RouterId INVALID_ID = std::numeric_limits<RouterId>::max();
+  static constexpr size_t CHUNK_SIZE = 1024;
+  static constexpr size_t MAX_CHUNKS = 4096;
+  static constexpr size_t MAX_IDS = CHUNK_SIZE * MAX_CHUNKS;
+
+private:
+  struct Entry
+  {
+    Entry(const ndn::Name& name, uint64_t hash, RouterId id)
+      : name(name)
+      , hash(hash)
+      , id(id)
+    {
+    }
+
+    const ndn::Name name;
+    const uint64_t hash;
+    const RouterId id;
+    std::atomic<uint32_t> nRefs{0};
+  };
+
+  // Read and written with std::atomic_load and std::atomic_store
+  using Chunk = std::array<std::shared_ptr<Entry>, CHUNK_SIZE>;
+
+  /*! \brief An open-addressing hash index from names to IDs.
+   *
+   * A slot holds the low 32 bits of the hash of a name and its ID plus one, so that most
+   * mismatches are skipped without reading the entry. Only writers change the slots.
+   */
+  struct Index
+  {
+    explicit
+    Index(size_t capacity);
+
+    static constexpr uint64_t EMPTY = 0;
+    static constexpr uint64_t TOMBSTONE = std::numeric_limits<uint64_t>::max();
+
+    static constexpr uint64_t TAG_MASK = ~uint64_t(0xFFFFFFFF);
+
+    static uint64_t
+    makeSlot(uint64_t hash, RouterId id)
+    {
+      return (hash << 32) | (static_cast<uint64_t>(id) + 1);
+    }
+
+    /*! \brief Returns the slot at which the search for \p slot starts. */
+    size_t
+    getHome(uint64_t slot) const
+    {
+      return (slot >> 32) & mask;
+    }
+
+    static RouterId
+    getId(uint64_t slot)
+    {
+      return static_cast<RouterId>((slot & ~TAG_MASK) - 1);
+    }
+
+    const size_t mask;
+    std::unique_ptr<std::atomic<uint64_t>[]> slots;
+    // Slots that are not EMPTY, including tombstones
+    size_t nUsed = 0;
+  };
+
+  /*! \brief Returns the entry that currently has \p id, or nullptr. */
+  std::shared_ptr<Entry>
+  loadEntry(RouterId id) const;
+
+  /*! \brief Returns the entry of \p name, or nullptr. */
+  std::shared_ptr<Entry>
+  findEntry(const ndn::Name& name, uint64_t hash) const;
+
+  /*! \brief Gives \p name a new ID. The caller must hold m_mutex. */
+  std::shared_ptr<Entry>
+  insert(const ndn::Name& name, uint64_t hash);
+
+  /*! \brief Adds \p slot to the index, rebuilding it first if it is half full.
+   *
+   * The caller must hold m_mutex.
+   */
+  void
+  addToIndex(uint64_t slot);
+
+  /*! \brief Increments the reference count of \p entry unless it is zero. */
+  static bool
+  tryAcquire(Entry& entry) noexcept;
+
+private:
+  // Serializes writers; readers only load the chunks and the index
+  mutable std::mutex m_mutex;
+  std::array<std::atomic<Chunk*>, MAX_CHUNKS> m_chunks{};
+  std::shared_ptr<Index> m_index = std::make_shared<Index>(16);
+  // The number of IDs ever given out, i.e. the first ID that has never been used
+  RouterId m_nSlots = 0;
+  std::atomic<size_t> m_nIds{0};
+  // Reclaimed IDs, handed out again before new ones; reserved for every slot, so that
+  // release() never allocates
+  std::vector<RouterId> m_freeIds;
+
+  friend class RouterIdRef;
+};
+
+/*! \brief A reference on a router ID, which keeps the ID from being reclaimed.
+ *
+ * A RouterIdRef is empty until intern() is called. Copies hold their own reference.
+ */
+class RouterIdRef
+{
+public:
+  RouterIdRef() noexcept = default;
+
+  /*! \brief Takes a reference on \p id, which must have been given out. */
+  explicit
+  RouterIdRef(RouterId id);
+
+  RouterIdRef(const RouterIdRef& other);
+
+  RouterIdRef(RouterIdRef&& other) noexcept;
+
+  RouterIdRef&
+  operator=(RouterIdRef other) noexcept;
+
+  ~RouterIdRef();
+
+  /*! \brief Returns the held ID, taking a reference on the ID of \p name if empty. */
+  RouterId
+  intern(const ndn::Name& name);
+
+  /*! \brief Drops the reference, leaving the RouterIdRef empty. */
+  void
+  reset() noexcept;
+
+  operator RouterId() const noexcept
+  {
+    return m_id;
+  }
+
+private:
+  RouterId m_id = RouterIdTable::INVALID_ID;
+};
+
+/*! \brief Hashes names with RouterIdTable::hash(), for unordered containers keyed by Name. */
+struct NameHash
+{
+  size_t
+  operator()(const ndn::Name& name) const noexcept
+  {
+    return static_cast<size_t>(RouterIdTable::hash(name));
+  }
+};
+
+} // namespace nlsr
+
+#endif // NLSR_ROUTER_ID_HPP
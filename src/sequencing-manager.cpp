@@ -22,34 +22,153 @@
 #include "sequencing-manager.hpp"
 #include "logger.hpp"
 
+#include <cstdio>
 #include <string>
 #include <fstream>
 #include <pwd.h>
 #include <cstdlib>
+#include <fcntl.h>
 #include <unistd.h>
 
 namespace nlsr {
 
 INIT_LOGGER(SequencingManager);
 
-SequencingManager::SequencingManager(const std::string& filePath, int hypState)
-  : m_hyperbolicState(hypState)
+constexpr uint64_t SequencingManager::SEQ_NO_LEASE;
+
+SequencingManager::SequencingManager(const std::string& filePath, int hypState,
+                                     bool shouldFsync)
+  : m_shouldFsync(shouldFsync)
+  , m_hyperbolicState(hypState)
 {
   setSeqFileDirectory(filePath);
   initiateSeqNoFromFile();
+  m_writer = std::thread(&SequencingManager::runWriter, this);
+}
+
+SequencingManager::~SequencingManager()
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    m_isStopping = true;
+  }
+  m_cv.notify_one();
+  m_writer.join();
+  flush();
 }
 
 void
-SequencingManager::writeSeqNoToFile() const
+SequencingManager::writeSeqNoToFile()
 {
   writeLog();
-  std::ofstream outputFile(m_seqFileNameWithPath.c_str());
+
+  // The numbers of the LSA type that the routing mode does not use stay 0 in the file,
+  // as initiateSeqNoFromFile expects
+  bool isAdjUsed = m_hyperbolicState != HYPERBOLIC_STATE_ON;
+  bool isCorUsed = m_hyperbolicState != HYPERBOLIC_STATE_OFF;
+  SeqNos lease{++m_generation,
+               m_nameLsaSeq + SEQ_NO_LEASE,
+               isAdjUsed ? m_adjLsaSeq + SEQ_NO_LEASE : m_adjLsaSeq,
+               isCorUsed ? m_corLsaSeq + SEQ_NO_LEASE : m_corLsaSeq,
+               m_summaryLsaSeq + SEQ_NO_LEASE};
+
+  bool isExhausted = false;
+  bool isRenewalDue = false;
+  auto check = [&] (uint64_t seqNo, uint64_t leased, uint64_t persisted) {
+    // A start resumes 10 past the file, so seqNo must stay below that
+    isExhausted = isExhausted || seqNo >= persisted + 10;
+    isRenewalDue = isRenewalDue || (leased > persisted && seqNo + SEQ_NO_LEASE / 2 > persisted);
+  };
+
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    check(m_nameLsaSeq, lease.name, m_persisted.name);
+    check(m_adjLsaSeq, lease.adj, m_persisted.adj);
+    check(m_corLsaSeq, lease.cor, m_persisted.cor);
+    check(m_summaryLsaSeq, lease.summary, m_persisted.summary);
+    if (isExhausted || isRenewalDue) {
+      m_pending = lease;
+    }
+  }
+
+  if (isExhausted) {
+    // The caller publishes after this returns, so the file must catch up first
+    NLSR_LOG_DEBUG("Sequence number lease used up, writing it before publishing");
+    ++m_nBlockingWrites;
+    flush();
+  }
+  else if (isRenewalDue) {
+    m_cv.notify_one();
+  }
+}
+
+void
+SequencingManager::flush()
+{
+  // Waits for a write in progress, which may have taken the pending numbers already
+  std::lock_guard<std::mutex> fileLock(m_fileMutex);
+  ndn::optional<SeqNos> seqNos;
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    seqNos.swap(m_pending);
+  }
+  if (seqNos) {
+    persist(*seqNos);
+  }
+}
+
+void
+SequencingManager::runWriter()
+{
+  while (true) {
+    {
+      std::unique_lock<std::mutex> lock(m_mutex);
+      m_cv.wait(lock, [this] { return m_pending || m_isStopping; });
+      if (m_isStopping) {
+        // The destructor writes what is still pending
+        return;
+      }
+    }
+    // Requests made during a write replace the pending numbers, so they are written once
+    flush();
+  }
+}
+
+void
+SequencingManager::persist(const SeqNos& seqNos)
+{
+  {
+    std::lock_guard<std::mutex> lock(m_mutex);
+    if (seqNos.generation <= m_persisted.generation) {
+      return;
+    }
+  }
+
   std::ostringstream os;
-  os << "NameLsaSeq " << std::to_string(m_nameLsaSeq) << "\n"
-     << "AdjLsaSeq "  << std::to_string(m_adjLsaSeq)  << "\n"
-     << "CorLsaSeq "  << std::to_string(m_corLsaSeq);
-  outputFile << os.str();
-  outputFile.close();
+  os << "NameLsaSeq " << std::to_string(seqNos.name) << "\n"
+     << "AdjLsaSeq "  << std::to_string(seqNos.adj)  << "\n"
+     << "CorLsaSeq "  << std::to_string(seqNos.cor) << "\n"
+     << "SumLsaSeq "  << std::to_string(seqNos.summary);
+  std::string content = os.str();
+
+  // The file is replaced atomically, so a crash leaves either the old or the new numbers
+  std::string tempFileName = m_seqFileNameWithPath + ".tmp";
+  int fd = ::open(tempFileName.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+  if (fd < 0) {
+    NLSR_LOG_ERROR("Cannot open " << tempFileName);
+    return;
+  }
+  bool isWritten = ::write(fd, content.data(), content.size()) ==
+                     static_cast<ssize_t>(content.size()) &&
+                   (!m_shouldFsync || ::fsync(fd) == 0);
+  isWritten = ::close(fd) == 0 && isWritten;
+  if (!isWritten || std::rename(tempFileName.c_str(), m_seqFileNameWithPath.c_str()) != 0) {
+    NLSR_LOG_ERROR("Cannot write sequence numbers to " << m_seqFileNameWithPath);
+    return;
+  }
+
+  std::lock_guard<std::mutex> lock(m_mutex);
+  m_persisted = seqNos;
 }
 
 void
@@ -64,12 +183,24 @@ SequencingManager::initiateSeqNoFromFile()
     inputFile >> seqType >> m_nameLsaSeq;
     inputFile >> seqType >> m_adjLsaSeq;
     inputFile >> seqType >> m_corLsaSeq;
+    // Files written before summary LSAs were introduced end here
+    if (!(inputFile >> seqType >> m_summaryLsaSeq)) {
+      m_summaryLsaSeq = 0;
+    }
 
     inputFile.close();
 
+    // The file holds these numbers until the next write
+    {
+      std::lock_guard<std::mutex> lock(m_mutex);
+      m_persisted = {m_persisted.generation, m_nameLsaSeq, m_adjLsaSeq, m_corLsaSeq,
+                     m_summaryLsaSeq};
+    }
+
     // Increment by 10 in case last run of NLSR was not able to write to file
     // before crashing
     m_nameLsaSeq += 10;
+    m_summaryLsaSeq += 10;
 
     // Increment the adjacency LSA seq. no. if link-state or dry HR is enabled
     if (m_hyperbolicState != HYPERBOLIC_STATE_ON) {
@@ -121,6 +252,7 @@ SequencingManager::writeLog() const
     NLSR_LOG_DEBUG("Cor LSA Seq no: " << m_corLsaSeq);
   }
   NLSR_LOG_DEBUG("Name LSA Seq no: " << m_nameLsaSeq);
+  NLSR_LOG_DEBUG("Summary LSA Seq no: " << m_summaryLsaSeq);
 }
 
 } // namespace nlsr
@@ -28,15 +28,30 @@
 
 #include <ndn-cxx/face.hpp>
 
+#include <boost/noncopyable.hpp>
+
+#include <condition_variable>
 #include <list>
+#include <mutex>
 #include <string>
+#include <thread>
 
 namespace nlsr {
 
-class SequencingManager
+/*! \brief Keeps the sequence numbers of the own LSAs and persists them to a file.
+
+  The file holds a lease: each sequence number in use plus SEQ_NO_LEASE. A restarted router
+  resumes 10 past the numbers in the file, so every number below the lease can be published
+  without a write. A background thread renews the lease once half of it is used, and replaces
+  the file atomically. The caller only waits for a write when the lease is used up, which
+  happens at the first publication after a start.
+ */
+class SequencingManager : boost::noncopyable
 {
 public:
-  SequencingManager(const std::string& filePath, int hypState);
+  SequencingManager(const std::string& filePath, int hypState, bool shouldFsync = false);
+
+  ~SequencingManager();
 
   void
   setLsaSeq(uint64_t seqNo, Lsa::Type lsaType)
@@ -51,6 +66,9 @@ public:
       case Lsa::Type::NAME:
         m_nameLsaSeq = seqNo;
         break;
+      case Lsa::Type::SUMMARY:
+        m_summaryLsaSeq = seqNo;
+        break;
       default:
         return;
     }
@@ -66,6 +84,8 @@ public:
         return m_corLsaSeq;
       case Lsa::Type::NAME:
         return m_nameLsaSeq;
+      case Lsa::Type::SUMMARY:
+        return m_summaryLsaSeq;
       default:
         return 0;
     }
@@ -107,6 +127,18 @@ public:
     m_corLsaSeq = clsn;
   }
 
+  uint64_t
+  getSummaryLsaSeq() const
+  {
+    return m_summaryLsaSeq;
+  }
+
+  void
+  increaseSummaryLsaSeq()
+  {
+    m_summaryLsaSeq++;
+  }
+
   void
   increaseNameLsaSeq()
   {
@@ -125,13 +157,46 @@ public:
     m_corLsaSeq++;
   }
 
+  /*! \brief Makes sure that the file covers the current sequence numbers.
+
+    The lease is renewed later by the background thread, but never so late that a restart
+    from the file could reuse a sequence number that is published after this call.
+   */
+  void
+  writeSeqNoToFile();
+
+  /*! \brief Writes any requested sequence numbers to the file before returning. */
   void
-  writeSeqNoToFile() const;
+  flush();
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   void
   initiateSeqNoFromFile();
 
+  struct SeqNos
+  {
+    uint64_t generation;
+    uint64_t name;
+    uint64_t adj;
+    uint64_t cor;
+    uint64_t summary;
+  };
+
+  /*! \brief Writes \p seqNos to the file, unless newer ones have been written already.
+
+    The caller holds m_fileMutex.
+   */
+  void
+  persist(const SeqNos& seqNos);
+
+  void
+  runWriter();
+
+  static constexpr uint64_t SEQ_NO_LEASE = 100;
+
+  // The writes that writeSeqNoToFile did on the caller's thread because the lease was used up
+  uint64_t m_nBlockingWrites = 0;
+
 private:
   /*! \brief Set the sequence file directory
 
@@ -149,7 +214,21 @@ private:
   uint64_t m_nameLsaSeq = 0;
   uint64_t m_adjLsaSeq = 0;
   uint64_t m_corLsaSeq = 0;
+  uint64_t m_summaryLsaSeq = 0;
   std::string m_seqFileNameWithPath;
+  bool m_shouldFsync;
+  uint64_t m_generation = 0;
+
+  // Guards the members below, which the writer thread shares
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  ndn::optional<SeqNos> m_pending;
+  SeqNos m_persisted{0, 0, 0, 0, 0};
+  bool m_isStopping = false;
+
+  // Serializes the writes of the writer thread and of flush; taken before m_mutex
+  std::mutex m_fileMutex;
+  std::thread m_writer;
 
 PUBLIC_WITH_TESTS_ELSE_PRIVATE:
   int m_hyperbolicState;
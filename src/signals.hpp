@@ -29,10 +29,10 @@
 namespace nlsr {
 
 class RoutingTable;
-class RoutingTableEntry;
+struct RoutingTableDelta;
 class SyncLogicHandler;
 
-using AfterRoutingChange = ndn::util::Signal<RoutingTable, const std::list<RoutingTableEntry>&>;
+using AfterRoutingChange = ndn::util::Signal<RoutingTable, const RoutingTableDelta&>;
 using OnNewLsa = ndn::util::Signal<SyncLogicHandler, const ndn::Name&, const uint64_t&, const ndn::Name&>;
 
 } // namespace nlsr
@@ -90,6 +90,10 @@ operator<<(std::ostream& os, const Statistics& stats)
      << "    Received Adjacency LSA Data: "       << stats.get(PacketType::RCV_ADJ_LSA_DATA) << "\n"
      << "    Received Coordinate LSA Data: "      << stats.get(PacketType::RCV_COORD_LSA_DATA) << "\n"
      << "    Received Name LSA Data: "            << stats.get(PacketType::RCV_NAME_LSA_DATA) << "\n"
+     << "\n"
+     << "ROUTING TABLE\n"
+     << "    Routing Table Calculations: "        << stats.get(PacketType::ROUTING_CALC) << "\n"
+     << "    Coalesced Calculation Requests: "    << stats.get(PacketType::COALESCED_ROUTING_CALC) << "\n"
      << "++++++++++++++++++++++++++++++++++++++++\n";
 
   return os;
@@ -50,7 +50,9 @@ public:
     RCV_LSA_DATA,
     RCV_ADJ_LSA_DATA,
     RCV_COORD_LSA_DATA,
-    RCV_NAME_LSA_DATA
+    RCV_NAME_LSA_DATA,
+    ROUTING_CALC,
+    COALESCED_ROUTING_CALC
   };
 
   size_t
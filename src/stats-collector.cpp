@@ -23,20 +23,24 @@
 
 namespace nlsr {
 
-StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp)
+StatsCollector::StatsCollector(Lsdb& lsdb, HelloProtocol& hp, RoutingTable& rt)
   : m_lsdb(lsdb)
   , m_hp(hp)
+  , m_rt(rt)
 {
   m_lsaIncrementConn = m_lsdb.lsaIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
                                                                    this, _1));
   m_helloIncrementConn = m_hp.hpIncrementSignal.connect(std::bind(&StatsCollector::statsIncrement,
                                                                   this, _1));
+  m_calculationIncrementConn = m_rt.calculationIncrementSignal.connect(
+    std::bind(&StatsCollector::statsIncrement, this, _1));
 }
 
 StatsCollector::~StatsCollector()
 {
   m_lsaIncrementConn.disconnect();
   m_helloIncrementConn.disconnect();
+  m_calculationIncrementConn.disconnect();
 }
 
 void
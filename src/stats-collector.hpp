@@ -24,6 +24,7 @@
 #include "statistics.hpp"
 #include "lsdb.hpp"
 #include "hello-protocol.hpp"
+#include "route/routing-table.hpp"
 #include <ndn-cxx/util/signal.hpp>
 
 namespace nlsr {
@@ -34,7 +35,7 @@ class StatsCollector
 {
 public:
 
-  StatsCollector(Lsdb& lsdb, HelloProtocol& hp);
+  StatsCollector(Lsdb& lsdb, HelloProtocol& hp, RoutingTable& rt);
 
   ~StatsCollector();
 
@@ -61,10 +62,12 @@ private:
 
   Lsdb& m_lsdb;
   HelloProtocol& m_hp;
+  RoutingTable& m_rt;
   Statistics m_stats;
 
   ndn::util::signal::ScopedConnection m_lsaIncrementConn;
   ndn::util::signal::ScopedConnection m_helloIncrementConn;
+  ndn::util::signal::ScopedConnection m_calculationIncrementConn;
 };
 
 } // namespace nlsr
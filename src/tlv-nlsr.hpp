@@ -47,7 +47,13 @@ enum {
   Uri                         = 141,
   NextHop                     = 143,
   RoutingTable                = 144,
-  RoutingTableEntry           = 145
+  RoutingTableEntry           = 145,
+  Area                        = 146,
+  SummaryLsa                  = 147,
+  NameLsaDelta                = 148,
+  BaseSequenceNumber          = 149,
+  AddedNames                  = 150,
+  RemovedNames                = 151
 };
 
 } // namespace nlsr
@@ -0,0 +1,78 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_WORKER_POOL_HPP
+#define NLSR_WORKER_POOL_HPP
+
+#include <boost/noncopyable.hpp>
+
+#include <condition_variable>
+#include <deque>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace nlsr {
+namespace util {
+
+/*! \brief A fixed set of worker threads for routing calculations and state file writes.
+ *
+ * A pool with zero threads is valid, but nothing may be posted to it; its owner then does
+ * the work on the calling thread instead.
+ */
+class WorkerPool : boost::noncopyable
+{
+public:
+  explicit
+  WorkerPool(size_t nThreads);
+
+  /*! \brief Stops the workers after the tasks that are already queued have run. */
+  ~WorkerPool();
+
+  size_t
+  getNThreads() const
+  {
+    return m_threads.size();
+  }
+
+  /*! \brief Queues \p job to run on one of the workers and returns immediately.
+   *
+   * \p job must not throw. The pool must have at least one thread.
+   */
+  void
+  post(std::function<void()> job);
+
+private:
+  void
+  run();
+
+private:
+  std::vector<std::thread> m_threads;
+  std::deque<std::function<void()>> m_jobs;
+  std::mutex m_mutex;
+  std::condition_variable m_cv;
+  bool m_isStopping = false;
+};
+
+} // namespace util
+} // namespace nlsr
+
+#endif // NLSR_WORKER_POOL_HPP
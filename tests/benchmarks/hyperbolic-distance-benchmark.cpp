@@ -0,0 +1,108 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#define BOOST_TEST_MODULE NLSR Hyperbolic Distance Benchmark
+#include "tests/boost-test.hpp"
+
+#include "route/hyperbolic-distance-kernel.hpp"
+
+#include <chrono>
+#include <iostream>
+#include <random>
+
+namespace nlsr {
+namespace test {
+
+/*! \brief Compares the batch hyperbolic distance kernel with the scalar calculation
+           for every neighbor of a router in a large network.
+ */
+class HyperbolicDistanceBenchmarkFixture
+{
+protected:
+  HyperbolicDistanceBenchmarkFixture()
+  {
+    std::mt19937 generator(1);
+    std::uniform_real_distribution<double> radius(1.0, 20.0);
+    std::uniform_real_distribution<double> polar(0.0, 3.14);
+    std::uniform_real_distribution<double> azimuth(0.0, 6.28);
+
+    coordinates.reserve(N_ROUTERS);
+    for (size_t i = 0; i < N_ROUTERS; ++i) {
+      coordinates.push_back(HyperbolicCoordinates::fromPolar(radius(generator),
+                                                             {polar(generator),
+                                                              azimuth(generator)}));
+    }
+  }
+
+  template<typename F>
+  static void
+  timedRun(const std::string& name, const F& f)
+  {
+    auto t1 = std::chrono::steady_clock::now();
+    for (size_t i = 0; i < N_REPEATS; ++i) {
+      f();
+    }
+    auto t2 = std::chrono::steady_clock::now();
+    auto us = std::chrono::duration_cast<std::chrono::microseconds>(t2 - t1).count();
+    std::cout << name << ": " << N_ROUTERS << " routers x " << N_NEIGHBORS << " neighbors, "
+              << us / N_REPEATS << " us per calculation" << std::endl;
+  }
+
+protected:
+  static constexpr size_t N_ROUTERS = 5000;
+  static constexpr size_t N_NEIGHBORS = 40;
+  static constexpr size_t N_REPEATS = 10;
+
+  std::vector<HyperbolicCoordinates> coordinates;
+};
+
+BOOST_FIXTURE_TEST_SUITE(HyperbolicDistance, HyperbolicDistanceBenchmarkFixture)
+
+BOOST_AUTO_TEST_CASE(Scalar)
+{
+  double sum = 0.0;
+  timedRun("Scalar", [&] {
+    for (size_t src = 0; src < N_NEIGHBORS; ++src) {
+      for (const auto& dest : coordinates) {
+        sum += HyperbolicDistanceKernel::computeDistance(coordinates[src], dest);
+      }
+    }
+  });
+  BOOST_CHECK_GT(sum, 0.0);
+}
+
+BOOST_AUTO_TEST_CASE(Batch)
+{
+  HyperbolicDistanceKernel kernel(coordinates);
+  std::vector<double> distances;
+  double sum = 0.0;
+  timedRun("Batch", [&] {
+    for (size_t src = 0; src < N_NEIGHBORS; ++src) {
+      kernel.computeDistances(coordinates[src], distances);
+      sum += distances.front();
+    }
+  });
+  BOOST_CHECK_NE(sum, 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
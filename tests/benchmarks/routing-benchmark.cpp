@@ -0,0 +1,377 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+/*! \file
+ * Times the routing engine on synthetic topologies of 100 to 20000 routers, without NFD.
+ *
+ * Every run fills a real Lsdb with the Adjacency, Coordinate and Name LSAs of the topology
+ * and reports, for the LSDB fill, the routing table calculation, the NPT update (which
+ * includes the FIB update it triggers) and the FIB update on its own, the wall time and the
+ * number of allocations, followed by the peak RSS of the process. A calculation after one
+ * link cost change is timed as well, since the calculators update their results
+ * incrementally.
+ *
+ * NLSR_BENCHMARK_SIZES sets the numbers of routers, as a comma-separated list, and
+ * NLSR_BENCHMARK_ROCKETFUEL names a Rocketfuel weights file for the Rocketfuel case.
+ */
+
+#define BOOST_TEST_MODULE NLSR Routing Benchmark
+#include "tests/boost-test.hpp"
+
+#include "topology-generator.hpp"
+
+#include "conf-parameter.hpp"
+#include "lsdb.hpp"
+#include "lsa/adj-lsa.hpp"
+#include "lsa/coordinate-lsa.hpp"
+#include "lsa/name-lsa.hpp"
+#include "route/fib.hpp"
+#include "route/name-prefix-table.hpp"
+#include "route/routing-table.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <sys/resource.h>
+
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <new>
+#include <sstream>
+
+namespace nlsr {
+namespace test {
+
+static std::atomic<size_t> g_nAllocations{0};
+
+} // namespace test
+} // namespace nlsr
+
+void*
+operator new(std::size_t size)
+{
+  ++nlsr::test::g_nAllocations;
+  void* p = std::malloc(size == 0 ? 1 : size);
+  if (p == nullptr) {
+    throw std::bad_alloc();
+  }
+  return p;
+}
+
+void
+operator delete(void* p) noexcept
+{
+  std::free(p);
+}
+
+void
+operator delete(void* p, std::size_t) noexcept
+{
+  std::free(p);
+}
+
+namespace nlsr {
+namespace test {
+
+using namespace ndn::time_literals;
+
+/*! \brief The time and the number of allocations at some point of a run. */
+struct Sample
+{
+  static Sample
+  now()
+  {
+    return {std::chrono::steady_clock::now(), g_nAllocations.load()};
+  }
+
+  std::chrono::steady_clock::time_point time;
+  size_t nAllocations;
+};
+
+static std::string
+formatPhase(const std::string& name, const Sample& begin, const Sample& end)
+{
+  std::chrono::duration<double, std::milli> ms = end.time - begin.time;
+  std::ostringstream os;
+  os << name << " " << std::fixed << std::setprecision(1) << ms.count() << " ms, "
+     << end.nAllocations - begin.nAllocations << " allocs";
+  return os.str();
+}
+
+static long
+getPeakRssKb()
+{
+  rusage usage{};
+  getrusage(RUSAGE_SELF, &usage);
+#ifdef __APPLE__
+  return usage.ru_maxrss / 1024;
+#else
+  return usage.ru_maxrss;
+#endif
+}
+
+static std::vector<size_t>
+getSizes()
+{
+  const char* sizes = std::getenv("NLSR_BENCHMARK_SIZES");
+  std::istringstream is(sizes != nullptr ? sizes : "100,1000,5000,20000");
+  std::vector<size_t> result;
+  std::string size;
+  while (std::getline(is, size, ',')) {
+    result.push_back(std::stoul(size));
+  }
+  return result;
+}
+
+static ndn::FaceUri
+makeFaceUri(size_t i)
+{
+  return ndn::FaceUri("udp4://10." + std::to_string((i >> 16) & 0xFF) + "." +
+                      std::to_string((i >> 8) & 0xFF) + "." + std::to_string(i & 0xFF) +
+                      ":6363");
+}
+
+/*! \brief Sets up router 0 of a topology as this router. */
+class ConfSetup
+{
+public:
+  ConfSetup(ConfParameter& conf, const Topology& topology, bool isHyperbolic)
+  {
+    conf.setNetwork("/ndn");
+    conf.setSiteName("/site0");
+    conf.setRouterName("/%C1.Router/router0");
+    conf.buildRouterAndSyncUserPrefix();
+    conf.setHyperbolicState(isHyperbolic ? HYPERBOLIC_STATE_ON : HYPERBOLIC_STATE_OFF);
+    // Calculations run in place, so that they can be timed from the caller
+    conf.setRoutingCalcThreads(0);
+
+    for (const auto& link : topology.links) {
+      if (link.a == 0 || link.b == 0) {
+        size_t neighbor = link.a == 0 ? link.b : link.a;
+        conf.getAdjacencyList().insert(Adjacent(topology.routers[neighbor],
+                                                makeFaceUri(neighbor), link.cost,
+                                                Adjacent::STATUS_ACTIVE, 0, neighbor + 1));
+      }
+    }
+  }
+};
+
+/*! \brief The routing engine of router 0 of a topology. */
+class RoutingBenchmark
+{
+public:
+  RoutingBenchmark(const Topology& topology, bool isHyperbolic)
+    : m_topology(topology)
+    , m_keyChain("pib-memory:", "tpm-memory:")
+    , m_scheduler(m_io)
+    , m_face(m_io, m_keyChain, {false, false})
+    , m_conf(m_face, m_keyChain)
+    , m_confSetup(m_conf, topology, isHyperbolic)
+    , m_lsdb(m_face, m_keyChain, m_conf)
+    , m_routingTable(m_io, m_scheduler, m_lsdb, m_conf)
+    , m_beforeNptConnection(m_routingTable.afterRoutingChange.connect(
+        [this] (const RoutingTableDelta&) {
+          m_isPublished = true;
+          m_beforeNpt = Sample::now();
+        }))
+    , m_fib(m_face, m_scheduler, m_conf.getAdjacencyList(), m_conf, m_keyChain)
+    , m_npt(m_conf, m_fib, m_routingTable, m_routingTable.afterRoutingChange,
+            m_lsdb.onLsdbModified)
+    , m_afterNptConnection(m_routingTable.afterRoutingChange.connect(
+        [this] (const RoutingTableDelta&) { m_afterNpt = Sample::now(); }))
+  {
+  }
+
+  void
+  run(const std::string& name)
+  {
+    Sample begin = Sample::now();
+    installLsas();
+    Sample lsdbDone = Sample::now();
+    calculate();
+    std::string fib = updateFib();
+
+    std::cout << name << (m_conf.getHyperbolicState() == HYPERBOLIC_STATE_ON ? " HR" : " LS")
+              << ", " << m_topology.routers.size() << " routers, "
+              << m_topology.links.size() << " links: "
+              << formatPhase("lsdb", begin, lsdbDone) << "; "
+              << formatPhase("calculation", m_calculationBegin, m_beforeNpt) << "; "
+              << formatPhase("npt", m_beforeNpt, m_afterNpt) << "; "
+              << fib << "; peak RSS " << getPeakRssKb() / 1024 << " MB" << std::endl;
+    BOOST_CHECK_GT(m_routingTable.getRoutingTableEntry().size(), 0);
+
+    // A link cost change, usually far from this router
+    const Topology::Link& link = m_topology.links.back();
+    auto adjacent = m_adjacencies[link.a].findAdjacent(m_topology.routers[link.b]);
+    BOOST_REQUIRE(adjacent != m_adjacencies[link.a].end());
+    adjacent->setLinkCost(adjacent->getLinkCost() + 1);
+    installAdjLsa(link.a, 2);
+
+    calculate();
+    std::cout << "  after a link cost change: "
+              << formatPhase("calculation", m_calculationBegin, m_beforeNpt) << "; "
+              << formatPhase("npt", m_beforeNpt, m_afterNpt) << std::endl;
+  }
+
+private:
+  void
+  installAdjLsa(size_t router, uint64_t seqNo)
+  {
+    m_lsdb.installLsa(std::make_shared<AdjLsa>(m_topology.routers[router], seqNo,
+                                               getExpirationTime(),
+                                               m_adjacencies[router].size(),
+                                               m_adjacencies[router]));
+  }
+
+  void
+  installLsas()
+  {
+    m_adjacencies.assign(m_topology.routers.size(), AdjacencyList());
+    for (const auto& link : m_topology.links) {
+      for (size_t end : {link.a, link.b}) {
+        Adjacent adjacent(m_topology.routers[end == link.a ? link.b : link.a]);
+        adjacent.setLinkCost(link.cost);
+        adjacent.setStatus(Adjacent::STATUS_ACTIVE);
+        m_adjacencies[end].insert(adjacent);
+      }
+    }
+    m_adjacencies[0] = m_conf.getAdjacencyList();
+
+    for (size_t i = 0; i < m_topology.routers.size(); ++i) {
+      const ndn::Name& router = m_topology.routers[i];
+      installAdjLsa(i, 1);
+      m_lsdb.installLsa(std::make_shared<CoordinateLsa>(router, 1, getExpirationTime(),
+                                                        m_topology.radius[i],
+                                                        std::vector<double>{m_topology.angle[i]}));
+      NamePrefixList names{ndn::Name("/ndn/site" + std::to_string(i)).append("data")};
+      m_lsdb.installLsa(std::make_shared<NameLsa>(router, 1, getExpirationTime(), names));
+    }
+  }
+
+  void
+  calculate()
+  {
+    m_isPublished = false;
+    m_calculationBegin = Sample::now();
+    m_routingTable.calculate();
+    if (!m_isPublished) {
+      m_beforeNpt = m_afterNpt = Sample::now();
+    }
+  }
+
+  /*! \brief Installs the next hops of every name prefix in an empty FIB. */
+  std::string
+  updateFib()
+  {
+    Fib fib(m_face, m_scheduler, m_conf.getAdjacencyList(), m_conf, m_keyChain);
+    Sample begin = Sample::now();
+    for (const auto& entry : m_npt) {
+      fib.update(entry->getNamePrefix(), entry->getNexthopList());
+    }
+    return formatPhase("fib", begin, Sample::now());
+  }
+
+  static ndn::time::system_clock::TimePoint
+  getExpirationTime()
+  {
+    return ndn::time::system_clock::now() + 24_h;
+  }
+
+private:
+  const Topology& m_topology;
+  ndn::KeyChain m_keyChain;
+  boost::asio::io_service m_io;
+  ndn::Scheduler m_scheduler;
+  ndn::util::DummyClientFace m_face;
+  ConfParameter m_conf;
+  ConfSetup m_confSetup;
+  Lsdb m_lsdb;
+  RoutingTable m_routingTable;
+  std::vector<AdjacencyList> m_adjacencies;
+
+  Sample m_calculationBegin;
+  bool m_isPublished = false;
+  Sample m_beforeNpt;
+  Sample m_afterNpt;
+  ndn::util::signal::ScopedConnection m_beforeNptConnection;
+  Fib m_fib;
+  NamePrefixTable m_npt;
+  ndn::util::signal::ScopedConnection m_afterNptConnection;
+};
+
+template<typename MakeTopology>
+static void
+runTopologies(const std::string& name, const MakeTopology& makeTopology)
+{
+  for (size_t nRouters : getSizes()) {
+    Topology topology = makeTopology(nRouters);
+    for (bool isHyperbolic : {false, true}) {
+      RoutingBenchmark(topology, isHyperbolic).run(name);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE(Routing)
+
+BOOST_AUTO_TEST_CASE(Grid)
+{
+  runTopologies("Grid", [] (size_t nRouters) {
+    return makeGridTopology(nRouters);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(Waxman)
+{
+  runTopologies("Waxman", [] (size_t nRouters) {
+    return makeWaxmanTopology(nRouters, 4.0, 0.1, 1);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(PowerLaw)
+{
+  runTopologies("Power-law", [] (size_t nRouters) {
+    return makePowerLawTopology(nRouters, 2, 1);
+  });
+}
+
+BOOST_AUTO_TEST_CASE(Rocketfuel)
+{
+  const char* path = std::getenv("NLSR_BENCHMARK_ROCKETFUEL");
+  if (path == nullptr) {
+    BOOST_TEST_MESSAGE("NLSR_BENCHMARK_ROCKETFUEL is not set, skipping");
+    return;
+  }
+
+  std::ifstream is(path);
+  BOOST_REQUIRE(is);
+  Topology topology = loadRocketfuelTopology(is, 1);
+  BOOST_REQUIRE(!topology.routers.empty());
+  for (bool isHyperbolic : {false, true}) {
+    RoutingBenchmark(topology, isHyperbolic).run("Rocketfuel");
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
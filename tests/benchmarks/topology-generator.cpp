@@ -0,0 +1,226 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "topology-generator.hpp"
+
+#include <boost/math/constants/constants.hpp>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <random>
+#include <set>
+#include <string>
+
+namespace nlsr {
+namespace test {
+
+/*! \brief Names the routers and places them in the hyperbolic plane.
+
+    The angles are random, and the radius decreases with the degree, so that well connected
+    routers are near the center as in a greedy embedding of a scale-free network.
+ */
+static void
+finishTopology(Topology& topology, size_t nRouters, uint32_t seed)
+{
+  topology.routers.clear();
+  for (size_t i = 0; i < nRouters; ++i) {
+    topology.routers.push_back(makeRouterName(i));
+  }
+
+  std::vector<size_t> degrees(nRouters);
+  for (const auto& link : topology.links) {
+    ++degrees[link.a];
+    ++degrees[link.b];
+  }
+
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> angle(0.0, 2 * boost::math::constants::pi<double>());
+  topology.radius.clear();
+  topology.angle.clear();
+  for (size_t i = 0; i < nRouters; ++i) {
+    double degree = std::max<size_t>(degrees[i], 1);
+    topology.radius.push_back(std::max(2 * std::log(nRouters / degree), 0.1));
+    topology.angle.push_back(angle(generator));
+  }
+}
+
+ndn::Name
+makeRouterName(size_t i)
+{
+  return ndn::Name("/ndn")
+    .append("site" + std::to_string(i))
+    .append("%C1.Router")
+    .append("router" + std::to_string(i));
+}
+
+Topology
+makeGridTopology(size_t nRouters)
+{
+  Topology topology;
+  size_t width = static_cast<size_t>(std::ceil(std::sqrt(nRouters)));
+  for (size_t i = 0; i < nRouters; ++i) {
+    if ((i + 1) % width != 0 && i + 1 < nRouters) {
+      topology.links.push_back({i, i + 1, 10});
+    }
+    if (i + width < nRouters) {
+      topology.links.push_back({i, i + width, 10});
+    }
+  }
+
+  finishTopology(topology, nRouters, 1);
+  return topology;
+}
+
+Topology
+makeWaxmanTopology(size_t nRouters, double degree, double beta, uint32_t seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_real_distribution<double> uniform(0.0, 1.0);
+
+  std::vector<double> x(nRouters);
+  std::vector<double> y(nRouters);
+  for (size_t i = 0; i < nRouters; ++i) {
+    x[i] = uniform(generator);
+    y[i] = uniform(generator);
+  }
+
+  auto distance = [&] (size_t i, size_t j) {
+    return std::hypot(x[i] - x[j], y[i] - y[j]);
+  };
+  const double scale = beta * std::sqrt(2.0);
+
+  // Estimate the mean link probability factor to pick alpha for the requested degree
+  double meanFactor = 0.0;
+  const size_t N_SAMPLES = 10000;
+  std::uniform_int_distribution<size_t> router(0, nRouters - 1);
+  for (size_t k = 0; k < N_SAMPLES; ++k) {
+    meanFactor += std::exp(-distance(router(generator), router(generator)) / scale);
+  }
+  meanFactor /= N_SAMPLES;
+  // The links to the nearest predecessors already give an average degree of about 2
+  double randomDegree = std::max(degree - 2, 0.0);
+  double alpha = nRouters > 1 ? std::min(1.0, randomDegree / ((nRouters - 1) * meanFactor)) : 0.0;
+
+  Topology topology;
+  std::vector<size_t> linked;
+  for (size_t i = 1; i < nRouters; ++i) {
+    size_t nearest = 0;
+    double nearestDistance = std::numeric_limits<double>::infinity();
+    for (size_t j = 0; j < i; ++j) {
+      // Squared distance, which orders routers the same way and is much cheaper
+      double d = (x[i] - x[j]) * (x[i] - x[j]) + (y[i] - y[j]) * (y[i] - y[j]);
+      if (d < nearestDistance) {
+        nearest = j;
+        nearestDistance = d;
+      }
+    }
+
+    // Candidates are drawn with probability alpha by skipping geometrically many routers,
+    // then kept with probability exp(-d / scale), which gives the Waxman probability
+    // without drawing a random number for every pair
+    linked.assign(1, nearest);
+    if (alpha > 0.0) {
+      std::geometric_distribution<size_t> skip(alpha);
+      for (size_t j = skip(generator); j < i; j += 1 + skip(generator)) {
+        if (j != nearest && uniform(generator) < std::exp(-distance(i, j) / scale)) {
+          linked.push_back(j);
+        }
+      }
+    }
+
+    for (size_t j : linked) {
+      topology.links.push_back({i, j, std::round(distance(i, j) * 100) + 1});
+    }
+  }
+
+  finishTopology(topology, nRouters, seed);
+  return topology;
+}
+
+Topology
+makePowerLawTopology(size_t nRouters, size_t nLinks, uint32_t seed)
+{
+  std::mt19937 generator(seed);
+  std::uniform_int_distribution<int> cost(1, 100);
+
+  Topology topology;
+  // Every router appears once per link, so that picking a uniform element
+  // picks a router with a probability proportional to its degree
+  std::vector<size_t> endpoints;
+
+  // Start from a clique of nLinks + 1 routers
+  size_t nInitial = std::min(nRouters, nLinks + 1);
+  for (size_t i = 0; i < nInitial; ++i) {
+    for (size_t j = 0; j < i; ++j) {
+      topology.links.push_back({i, j, static_cast<double>(cost(generator))});
+      endpoints.push_back(i);
+      endpoints.push_back(j);
+    }
+  }
+
+  std::set<size_t> targets;
+  for (size_t i = nInitial; i < nRouters; ++i) {
+    targets.clear();
+    std::uniform_int_distribution<size_t> endpoint(0, endpoints.size() - 1);
+    while (targets.size() < nLinks) {
+      targets.insert(endpoints[endpoint(generator)]);
+    }
+    for (size_t j : targets) {
+      topology.links.push_back({i, j, static_cast<double>(cost(generator))});
+      endpoints.push_back(i);
+      endpoints.push_back(j);
+    }
+  }
+
+  finishTopology(topology, nRouters, seed);
+  return topology;
+}
+
+Topology
+loadRocketfuelTopology(std::istream& is, uint32_t seed)
+{
+  Topology topology;
+  std::map<std::string, size_t> routers;
+  std::set<std::pair<size_t, size_t>> links;
+
+  auto getRouter = [&routers] (const std::string& name) {
+    return routers.emplace(name, routers.size()).first->second;
+  };
+
+  std::string a;
+  std::string b;
+  double cost = 0;
+  while (is >> a >> b >> cost) {
+    size_t i = getRouter(a);
+    size_t j = getRouter(b);
+    if (i == j || !links.emplace(std::min(i, j), std::max(i, j)).second) {
+      continue;
+    }
+    topology.links.push_back({i, j, std::max(cost, 1.0)});
+  }
+
+  finishTopology(topology, routers.size(), seed);
+  return topology;
+}
+
+} // namespace test
+} // namespace nlsr
@@ -0,0 +1,87 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#ifndef NLSR_TESTS_BENCHMARKS_TOPOLOGY_GENERATOR_HPP
+#define NLSR_TESTS_BENCHMARKS_TOPOLOGY_GENERATOR_HPP
+
+#include "common.hpp"
+
+#include <istream>
+#include <vector>
+
+namespace nlsr {
+namespace test {
+
+/*! \brief A synthetic network: its routers, the links between them, and a hyperbolic
+           coordinate for every router.
+ */
+struct Topology
+{
+  struct Link
+  {
+    size_t a;
+    size_t b;
+    double cost;
+  };
+
+  std::vector<ndn::Name> routers;
+  std::vector<Link> links;
+  std::vector<double> radius;
+  std::vector<double> angle;
+};
+
+/*! \brief Returns the name of router \p i, made of the network "/ndn", the site
+           "/site<i>" and the router "/%C1.Router/router<i>".
+ */
+ndn::Name
+makeRouterName(size_t i);
+
+/*! \brief Makes a square grid of \p nRouters routers, the last row possibly incomplete. */
+Topology
+makeGridTopology(size_t nRouters);
+
+/*! \brief Makes a Waxman random graph.
+
+    Routers are placed uniformly in the unit square, and two routers at distance d are
+    linked with probability alpha * exp(-d / (beta * sqrt(2))). Every router is also linked
+    to its nearest predecessor so that the graph is connected, and alpha is chosen so that
+    the average degree is about \p degree.
+ */
+Topology
+makeWaxmanTopology(size_t nRouters, double degree, double beta, uint32_t seed);
+
+/*! \brief Makes a power-law graph by preferential attachment (Barabasi-Albert), where
+           every new router is linked to \p nLinks existing ones.
+ */
+Topology
+makePowerLawTopology(size_t nRouters, size_t nLinks, uint32_t seed);
+
+/*! \brief Reads a topology in the format of the Rocketfuel weights and latencies files.
+
+    Every line is "<router> <router> <cost>"; links are undirected, and the routers are
+    numbered in the order in which they first appear.
+ */
+Topology
+loadRocketfuelTopology(std::istream& is, uint32_t seed);
+
+} // namespace test
+} // namespace nlsr
+
+#endif // NLSR_TESTS_BENCHMARKS_TOPOLOGY_GENERATOR_HPP
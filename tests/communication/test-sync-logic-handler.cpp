@@ -152,6 +152,39 @@ BOOST_AUTO_TEST_CASE(UpdateForOtherHRDry)
   BOOST_CHECK_EQUAL(nCallbacks, 3);
 }
 
+/* Tests that a stub router only fetches adjacency LSAs, plus the name LSAs
+   when it learns some stub prefixes.
+ */
+BOOST_AUTO_TEST_CASE(UpdateForStubRouter)
+{
+  this->conf.setStubRouter(true);
+
+  size_t nCallbacks = 0;
+  uint64_t syncSeqNo = 1;
+  auto receiveAll = [&] {
+    for (auto lsaType : {Lsa::Type::NAME, Lsa::Type::ADJACENCY, Lsa::Type::SUMMARY}) {
+      std::string updateName = this->updateNamePrefix + boost::lexical_cast<std::string>(lsaType);
+
+      ndn::util::signal::ScopedConnection connection = this->sync.onNewLsa->connect(
+        [&] (const auto& routerName, uint64_t sequenceNumber, const auto& originRouter) {
+          BOOST_CHECK_NE(lsaType, Lsa::Type::SUMMARY);
+          ++nCallbacks;
+        });
+
+      this->receiveUpdate(updateName, syncSeqNo);
+    }
+    ++syncSeqNo;
+  };
+
+  receiveAll();
+  BOOST_CHECK_EQUAL(nCallbacks, 1);
+
+  this->conf.addStubPrefix("/ndn/edu");
+  nCallbacks = 0;
+  receiveAll();
+  BOOST_CHECK_EQUAL(nCallbacks, 2);
+}
+
 /* Tests that when SyncLogicHandler receives an update for an LSA with
    details matching this router's details, it will *not* emit to its
    signal those LSA details.
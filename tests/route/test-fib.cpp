@@ -412,6 +412,54 @@ BOOST_AUTO_TEST_CASE(PrefixWithdrawalFibUpdateBug) // #5179
   BOOST_CHECK_EQUAL(numRegister, 3);
 }
 
+BOOST_AUTO_TEST_CASE(RerouteAroundFace)
+{
+  conf.setMaxFacesPerPrefix(1);
+  conf.setFastReroute(true);
+
+  NexthopList hops;
+  hops.addNextHop(NextHop(router1FaceUri, 10));
+  hops.addNextHop(NextHop(router2FaceUri, 20));
+  hops.addNextHop(NextHop(router3FaceUri, 30));
+  fib.update("/ndn/name", hops);
+
+  NexthopList otherHops;
+  otherHops.addNextHop(NextHop(router2FaceUri, 10));
+  fib.update("/ndn/other", otherHops);
+  face.processEvents(ndn::time::milliseconds(-1));
+
+  // Only the best next hop is installed, the others are kept as alternates
+  BOOST_CHECK_EQUAL(fib.m_table["/ndn/name"].nexthopSet.size(), 1);
+  BOOST_CHECK_EQUAL(fib.m_table["/ndn/name"].alternates.size(), 2);
+  BOOST_CHECK_EQUAL(fib.m_namesByFaceUri[router1FaceUri].size(), 1);
+  BOOST_CHECK_EQUAL(fib.m_namesByFaceUri[router2FaceUri].size(), 1);
+  interests.clear();
+
+  // The face of router 2 is down too, so router 3 takes the place of router 1
+  adjacencies.findAdjacent(ndn::FaceUri(router1FaceUri))->setFaceId(0);
+  adjacencies.findAdjacent(ndn::FaceUri(router2FaceUri))->setFaceId(0);
+  BOOST_CHECK_EQUAL(fib.rerouteAroundFace(ndn::FaceUri(router1FaceUri)), 1);
+  face.processEvents(ndn::time::milliseconds(-1));
+
+  BOOST_REQUIRE_EQUAL(interests.size(), 1);
+  ndn::nfd::ControlParameters extractedParameters;
+  ndn::Name::Component verb;
+  extractRibCommandParameters(interests.front(), verb, extractedParameters);
+  BOOST_CHECK_EQUAL(extractedParameters.getName(), "/ndn/name");
+  BOOST_CHECK_EQUAL(extractedParameters.getFaceId(), router3FaceId);
+  BOOST_CHECK_EQUAL(verb, ndn::Name::Component("register"));
+
+  const FibEntry& entry = fib.m_table["/ndn/name"];
+  BOOST_REQUIRE_EQUAL(entry.nexthopSet.size(), 1);
+  BOOST_CHECK_EQUAL(entry.nexthopSet.begin()->getConnectingFaceUri(), router3FaceUri);
+  BOOST_CHECK_EQUAL(fib.m_namesByFaceUri.count(router1FaceUri), 0);
+  BOOST_CHECK_EQUAL(fib.m_namesByFaceUri[router3FaceUri].size(), 1);
+
+  // Entries that do not use the face are left alone
+  BOOST_CHECK_EQUAL(fib.rerouteAroundFace(ndn::FaceUri(router1FaceUri)), 0);
+  BOOST_CHECK_EQUAL(fib.m_table["/ndn/other"].nexthopSet.size(), 1);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -193,6 +193,131 @@ BOOST_AUTO_TEST_CASE(BasicMultipleAngles)
   runTest(30.655296361);
 }
 
+BOOST_AUTO_TEST_CASE(IncrementalUpdate)
+{
+  setUpTopology({2.97}, {3.0}, {2.99});
+  // Router D is not a neighbor of A
+  const ndn::Name routerD("/ndn/router/d");
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(routerD, 1, MAX_TIME, 15.0,
+                                                  std::vector<double>{2.9}));
+  map = Map();
+  auto lsaRange = lsdb.getLsdbIterator<CoordinateLsa>();
+  map.createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+
+  HyperbolicRoutingCalculator calculator(map.getMapSize(), false, ROUTER_A_NAME);
+  auto checkAgainstFullCalculation = [&] (RoutingTableStatus& incremental,
+                                          const std::vector<HyperbolicCoordinates>& coordinates) {
+    HyperbolicRoutingCalculator::State fullState;
+    RoutingTableStatus full;
+    calculator.updateDistances(map, coordinates, adjacencies, fullState);
+    calculator.addNextHops(fullState, full);
+
+    BOOST_CHECK_EQUAL(incremental.m_rTable.size(), full.m_rTable.size());
+    for (const auto& entry : full.m_rTable) {
+      RoutingTableEntry* other = incremental.findRoutingTableEntry(entry.getDestination());
+      BOOST_REQUIRE(other != nullptr);
+      BOOST_CHECK_EQUAL(other->getNexthopList(), entry.getNexthopList());
+    }
+  };
+
+  HyperbolicRoutingCalculator::State state;
+  auto coordinates = HyperbolicRoutingCalculator::getCoordinates(map, lsdb);
+  BOOST_CHECK(!calculator.updateDistances(map, coordinates, adjacencies, state));
+  RoutingTableStatus incremental;
+  calculator.addNextHops(state, incremental);
+
+  // Nothing changed
+  auto changed = calculator.updateDistances(map, coordinates, adjacencies, state);
+  BOOST_REQUIRE(changed);
+  BOOST_CHECK(changed->empty());
+
+  // Only the routes to a router that moved change
+  int32_t d = *map.getMappingNoByRouterName(routerD);
+  coordinates[d] = HyperbolicCoordinates::fromPolar(14.5, {2.5});
+  changed = calculator.updateDistances(map, coordinates, adjacencies, state);
+  BOOST_REQUIRE(changed);
+  BOOST_CHECK_EQUAL_COLLECTIONS(changed->begin(), changed->end(), &d, &d + 1);
+  incremental.removeEntry(RouterIdTable::get().intern(routerD));
+  calculator.addNextHops(state, d, incremental);
+  checkAgainstFullCalculation(incremental, coordinates);
+
+  // A neighbor that moved changes the routes to every router
+  int32_t c = *map.getMappingNoByRouterName(ROUTER_C_NAME);
+  coordinates[c] = HyperbolicCoordinates::fromPolar(14.5, {2.7});
+  BOOST_CHECK(!calculator.updateDistances(map, coordinates, adjacencies, state));
+  incremental = RoutingTableStatus();
+  calculator.addNextHops(state, incremental);
+  checkAgainstFullCalculation(incremental, coordinates);
+
+  // So does a neighbor going down
+  adjacencies.setStatusOfNeighbor(ROUTER_B_NAME, Adjacent::STATUS_INACTIVE);
+  BOOST_CHECK(!calculator.updateDistances(map, coordinates, adjacencies, state));
+}
+
+BOOST_AUTO_TEST_CASE(MaxFacesPerPrefix)
+{
+  setUpTopology({2.97}, {3.0}, {2.99});
+  const ndn::Name routerD("/ndn/router/d");
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(routerD, 1, MAX_TIME, 15.0,
+                                                  std::vector<double>{2.9}));
+  map = Map();
+  auto lsaRange = lsdb.getLsdbIterator<CoordinateLsa>();
+  map.createFromCoordinateLsdb(lsaRange.first, lsaRange.second);
+
+  RoutingTableStatus all;
+  HyperbolicRoutingCalculator(map.getMapSize(), false, ROUTER_A_NAME)
+    .calculatePath(map, all, lsdb, adjacencies);
+  RoutingTableStatus best;
+  HyperbolicRoutingCalculator(map.getMapSize(), false, ROUTER_A_NAME, 1)
+    .calculatePath(map, best, lsdb, adjacencies);
+
+  // Only the cheapest next hop of each destination is kept
+  BOOST_CHECK_EQUAL(best.m_rTable.size(), all.m_rTable.size());
+  for (const auto& entry : all.m_rTable) {
+    BOOST_REQUIRE_EQUAL(entry.getNexthopList().size(), 2);
+    RoutingTableEntry* other = best.findRoutingTableEntry(entry.getDestination());
+    BOOST_REQUIRE(other != nullptr);
+    BOOST_REQUIRE_EQUAL(other->getNexthopList().size(), 1);
+    BOOST_CHECK_EQUAL(*other->getNexthopList().begin(), *entry.getNexthopList().begin());
+  }
+  BOOST_CHECK_EQUAL(best.findRoutingTableEntry(ROUTER_B_NAME)->getNexthopList().begin()
+                      ->getConnectingFaceUri(), ROUTER_B_FACE);
+}
+
+BOOST_AUTO_TEST_CASE(CoordinateCache)
+{
+  setUpTopology({2.97, 1.22}, {3.0, 0.09}, {321, 2.99});
+
+  // The routing table keeps the coordinates of the installed LSAs
+  auto fromLsdb = HyperbolicRoutingCalculator::getCoordinates(map, lsdb);
+  auto fromCache = HyperbolicRoutingCalculator::getCoordinates(map,
+                                                               routingTable.m_coordinateCache);
+  BOOST_REQUIRE_EQUAL(fromCache.size(), 3);
+  for (size_t i = 0; i < fromCache.size(); ++i) {
+    BOOST_CHECK_EQUAL(fromCache[i].radius, fromLsdb[i].radius);
+    BOOST_CHECK_EQUAL_COLLECTIONS(fromCache[i].point.begin(), fromCache[i].point.end(),
+                                  fromLsdb[i].point.begin(), fromLsdb[i].point.end());
+  }
+
+  RouterId routerC = RouterIdTable::get().intern(ROUTER_C_NAME);
+  const HyperbolicCoordinates& c = routingTable.m_coordinateCache.find(routerC);
+  BOOST_CHECK(c.isValid());
+  BOOST_CHECK_EQUAL(c.point.size(), 3);
+  BOOST_CHECK_EQUAL(c.radius, 14.11);
+
+  // An updated LSA replaces the coordinates
+  lsdb.installLsa(std::make_shared<CoordinateLsa>(ROUTER_C_NAME, 2, MAX_TIME, 12.5,
+                                                  std::vector<double>{1.5}));
+  BOOST_CHECK_EQUAL(routingTable.m_coordinateCache.find(routerC).radius, 12.5);
+  BOOST_CHECK_EQUAL(routingTable.m_coordinateCache.find(routerC).point.size(), 2);
+
+  lsdb.removeLsa(ROUTER_C_NAME, Lsa::Type::COORDINATE);
+  BOOST_CHECK(!routingTable.m_coordinateCache.find(routerC).isValid());
+
+  // A last angle outside [0, 2PI] makes the coordinates unusable
+  BOOST_CHECK(!HyperbolicCoordinates::fromPolar(10.0, {1.0, 7.0}).isValid());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
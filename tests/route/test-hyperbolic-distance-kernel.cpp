@@ -0,0 +1,81 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/hyperbolic-distance-kernel.hpp"
+#include "tests/boost-test.hpp"
+
+namespace nlsr {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestHyperbolicDistanceKernel)
+
+BOOST_AUTO_TEST_CASE(Distance)
+{
+  auto b = HyperbolicCoordinates::fromPolar(16.59, {3.0});
+  auto c = HyperbolicCoordinates::fromPolar(14.11, {2.99});
+  BOOST_CHECK_CLOSE(HyperbolicDistanceKernel::computeDistance(b, c), 20.103356956, 1e-7);
+
+  // Routers at the same position or without coordinates have no distance
+  BOOST_CHECK_EQUAL(HyperbolicDistanceKernel::computeDistance(b, b),
+                    HyperbolicDistanceKernel::UNKNOWN_DISTANCE);
+  BOOST_CHECK_EQUAL(HyperbolicDistanceKernel::computeDistance(b, HyperbolicCoordinates()),
+                    HyperbolicDistanceKernel::UNKNOWN_DISTANCE);
+}
+
+BOOST_AUTO_TEST_CASE(BatchMatchesScalar)
+{
+  std::vector<HyperbolicCoordinates> coordinates;
+  // More routers than the widest SIMD register, and not a multiple of it
+  for (int i = 0; i < 11; ++i) {
+    coordinates.push_back(HyperbolicCoordinates::fromPolar(10.0 + i, {0.1 + 0.25 * i, 0.3 * i}));
+  }
+  coordinates[2] = HyperbolicCoordinates();
+  coordinates[5] = HyperbolicCoordinates::fromPolar(12.0, {1.0});
+  coordinates[8] = coordinates[0];
+
+  HyperbolicDistanceKernel kernel(coordinates);
+  BOOST_CHECK_EQUAL(kernel.size(), coordinates.size());
+
+  std::vector<double> distances;
+  for (const auto& src : coordinates) {
+    kernel.computeDistances(src, distances);
+    BOOST_REQUIRE_EQUAL(distances.size(), coordinates.size());
+    for (size_t j = 0; j < coordinates.size(); ++j) {
+      double expected = HyperbolicDistanceKernel::computeDistance(src, coordinates[j]);
+      if (expected == HyperbolicDistanceKernel::UNKNOWN_DISTANCE) {
+        BOOST_CHECK_EQUAL(distances[j], expected);
+      }
+      else {
+        BOOST_CHECK_CLOSE(distances[j], expected, 1e-9);
+      }
+    }
+  }
+
+  kernel.computeDistances(coordinates[0], distances);
+  BOOST_CHECK_EQUAL(distances[2], HyperbolicDistanceKernel::UNKNOWN_DISTANCE);
+  BOOST_CHECK_EQUAL(distances[5], HyperbolicDistanceKernel::UNKNOWN_DISTANCE);
+  BOOST_CHECK_EQUAL(distances[8], HyperbolicDistanceKernel::UNKNOWN_DISTANCE);
+  BOOST_CHECK_GT(distances[1], 0.0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
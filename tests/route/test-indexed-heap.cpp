@@ -0,0 +1,80 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/indexed-heap.hpp"
+
+#include "tests/boost-test.hpp"
+
+namespace nlsr {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestIndexedHeap)
+
+BOOST_AUTO_TEST_CASE(PopInKeyOrder)
+{
+  IndexedMinHeap<double> heap(6);
+  heap.pushOrDecrease(3, 7.0);
+  heap.pushOrDecrease(0, 2.5);
+  heap.pushOrDecrease(5, 10.0);
+  heap.pushOrDecrease(1, 0.0);
+  heap.pushOrDecrease(4, 2.5);
+
+  BOOST_CHECK_EQUAL(heap.size(), 5);
+  BOOST_CHECK(heap.contains(3));
+  BOOST_CHECK(!heap.contains(2));
+
+  // Equal keys are popped in index order
+  BOOST_CHECK_EQUAL(heap.pop(), 1);
+  BOOST_CHECK_EQUAL(heap.pop(), 0);
+  BOOST_CHECK_EQUAL(heap.pop(), 4);
+  BOOST_CHECK_EQUAL(heap.pop(), 3);
+  BOOST_CHECK_EQUAL(heap.pop(), 5);
+  BOOST_CHECK(heap.empty());
+  BOOST_CHECK(!heap.contains(5));
+}
+
+BOOST_AUTO_TEST_CASE(DecreaseKey)
+{
+  IndexedMinHeap<double> heap(4);
+  heap.pushOrDecrease(0, 10.0);
+  heap.pushOrDecrease(1, 20.0);
+  heap.pushOrDecrease(2, 30.0);
+
+  heap.pushOrDecrease(2, 5.0);
+  BOOST_CHECK_EQUAL(heap.size(), 3);
+  BOOST_CHECK_EQUAL(heap.topKey(), 5.0);
+
+  // A larger key does not replace the queued one
+  heap.pushOrDecrease(0, 50.0);
+
+  BOOST_CHECK_EQUAL(heap.pop(), 2);
+  BOOST_CHECK_EQUAL(heap.pop(), 0);
+
+  // Items can be queued again after being popped
+  heap.pushOrDecrease(2, 1.0);
+  BOOST_CHECK_EQUAL(heap.pop(), 2);
+  BOOST_CHECK_EQUAL(heap.pop(), 1);
+  BOOST_CHECK(heap.empty());
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
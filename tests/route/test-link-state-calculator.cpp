@@ -95,6 +95,15 @@ public:
     map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
   }
 
+  void
+  calculatePath(LinkStateRoutingTableCalculator& calculator)
+  {
+    TopologyGraph graph(lsdb, map);
+    calculator.calculatePath(graph, map, routingTable, conf.getRouterPrefix(),
+                             conf.getMaxFacesPerPrefix(), conf.getAdjacencyList(),
+                             conf.getFastReroute());
+  }
+
 public:
   ndn::util::DummyClientFace face;
   ConfParameter conf;
@@ -135,7 +144,7 @@ BOOST_FIXTURE_TEST_SUITE(TestLinkStateRoutingCalculator, LinkStateCalculatorFixt
 BOOST_AUTO_TEST_CASE(Basic)
 {
   LinkStateRoutingTableCalculator calculator(map.getMapSize());
-  calculator.calculatePath(map, routingTable, conf, lsdb);
+  calculatePath(calculator);
 
   RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
   BOOST_REQUIRE(entryB != nullptr);
@@ -183,7 +192,7 @@ BOOST_AUTO_TEST_CASE(Asymmetric)
 
   // Calculation should consider the link between B and C as having cost = higherLinkCost
   LinkStateRoutingTableCalculator calculator(map.getMapSize());
-  calculator.calculatePath(map, routingTable, conf, lsdb);
+  calculatePath(calculator);
 
   RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
   BOOST_REQUIRE(entryB != nullptr);
@@ -217,6 +226,55 @@ BOOST_AUTO_TEST_CASE(Asymmetric)
   }
 }
 
+BOOST_AUTO_TEST_CASE(LoopFreeAlternates)
+{
+  conf.setMaxFacesPerPrefix(1);
+  conf.setFastReroute(true);
+
+  LinkStateRoutingTableCalculator calculator(map.getMapSize());
+  calculatePath(calculator);
+
+  // B and C reach each other more cheaply through this router than over their own link,
+  // so neither of them is a loop-free alternate to the other
+  for (const auto& dest : {ROUTER_B_NAME, ROUTER_C_NAME}) {
+    RoutingTableEntry* entry = routingTable.findRoutingTableEntry(dest);
+    BOOST_REQUIRE(entry != nullptr);
+    BOOST_CHECK_EQUAL(entry->getNexthopList().size(), 1);
+  }
+
+  // Make the link between B and C cheaper than the path through this router
+  const double lowerLinkCost = 3;
+  auto lsaB = nlsr.m_lsdb.findLsa<AdjLsa>(ROUTER_B_NAME);
+  auto lsaC = nlsr.m_lsdb.findLsa<AdjLsa>(ROUTER_C_NAME);
+  BOOST_REQUIRE(lsaB != nullptr && lsaC != nullptr);
+  lsaB->m_adl.findAdjacent(ROUTER_C_NAME)->setLinkCost(lowerLinkCost);
+  lsaC->m_adl.findAdjacent(ROUTER_B_NAME)->setLinkCost(lowerLinkCost);
+
+  routingTable.clearEntries();
+  calculatePath(calculator);
+
+  // Each destination keeps its primary next hop first, followed by its alternate
+  RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
+  BOOST_REQUIRE(entryB != nullptr);
+  NexthopList& bHopList = entryB->getNexthopList();
+  BOOST_REQUIRE_EQUAL(bHopList.size(), 2);
+  BOOST_CHECK_EQUAL(bHopList.begin()->getConnectingFaceUri(), ROUTER_B_FACE);
+  BOOST_CHECK_EQUAL(bHopList.begin()->getRouteCostAsAdjustedInteger(), LINK_AB_COST);
+  BOOST_CHECK_EQUAL(std::next(bHopList.begin())->getConnectingFaceUri(), ROUTER_C_FACE);
+  BOOST_CHECK_EQUAL(std::next(bHopList.begin())->getRouteCostAsAdjustedInteger(),
+                    LINK_AC_COST + lowerLinkCost);
+
+  RoutingTableEntry* entryC = routingTable.findRoutingTableEntry(ROUTER_C_NAME);
+  BOOST_REQUIRE(entryC != nullptr);
+  NexthopList& cHopList = entryC->getNexthopList();
+  BOOST_REQUIRE_EQUAL(cHopList.size(), 2);
+  BOOST_CHECK_EQUAL(cHopList.begin()->getConnectingFaceUri(), ROUTER_B_FACE);
+  BOOST_CHECK_EQUAL(cHopList.begin()->getRouteCostAsAdjustedInteger(),
+                    LINK_AB_COST + lowerLinkCost);
+  BOOST_CHECK_EQUAL(std::next(cHopList.begin())->getConnectingFaceUri(), ROUTER_C_FACE);
+  BOOST_CHECK_EQUAL(std::next(cHopList.begin())->getRouteCostAsAdjustedInteger(), LINK_AC_COST);
+}
+
 BOOST_AUTO_TEST_CASE(NonAdjacentCost)
 {
   // Asymmetric link cost between B and C
@@ -231,7 +289,7 @@ BOOST_AUTO_TEST_CASE(NonAdjacentCost)
 
   // Calculation should consider the link between B and C as down
   LinkStateRoutingTableCalculator calculator(map.getMapSize());
-  calculator.calculatePath(map, routingTable, conf, lsdb);
+  calculatePath(calculator);
 
   // Router A should be able to get to B through B but not through C
   RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
@@ -285,7 +343,7 @@ BOOST_AUTO_TEST_CASE(AsymmetricZeroCostLink)
 
   // Calculation should consider 0 link-cost between B and C
   LinkStateRoutingTableCalculator calculator(map.getMapSize());
-  calculator.calculatePath(map, routingTable, conf, lsdb);
+  calculatePath(calculator);
 
   // Router A should be able to get to B through B and C
   RoutingTableEntry* entryB = routingTable.findRoutingTableEntry(ROUTER_B_NAME);
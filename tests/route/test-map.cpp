@@ -41,6 +41,35 @@ BOOST_AUTO_TEST_CASE(MapAddElementAndSize)
   BOOST_CHECK_EQUAL(map1.getMapSize(), 2);
 }
 
+BOOST_AUTO_TEST_CASE(MappingNumbersFollowRouterIds)
+{
+  // Intern in the reverse order of the names
+  RouterId idB = RouterIdTable::get().intern("/ndn/map-test/b");
+  RouterId idA = RouterIdTable::get().intern("/ndn/map-test/a");
+
+  Map map1;
+  map1.addEntry("/ndn/map-test/a");
+  map1.addEntry("/ndn/map-test/b");
+  BOOST_CHECK_EQUAL(*map1.getMappingNoByRouterId(idA), 0);
+  BOOST_CHECK_EQUAL(*map1.getMappingNoByRouterId(idB), 1);
+  BOOST_CHECK_EQUAL(*map1.getRouterNameByMappingNo(0), "/ndn/map-test/a");
+
+  // Populated from the LSDB, routers are numbered in the order of their IDs
+  std::vector<std::shared_ptr<Lsa>> lsas;
+  AdjacencyList adjacencies;
+  adjacencies.insert(Adjacent("/ndn/map-test/b"));
+  lsas.push_back(std::make_shared<AdjLsa>("/ndn/map-test/a", 1, ndn::time::system_clock::now(),
+                                          1, adjacencies));
+  Map map2;
+  map2.createFromAdjLsdb(lsas.begin(), lsas.end());
+  BOOST_CHECK_EQUAL(map2.getMapSize(), 2);
+  BOOST_CHECK_EQUAL(*map2.getMappingNoByRouterName("/ndn/map-test/b"), 0);
+  BOOST_CHECK_EQUAL(*map2.getRouterIdByMappingNo(1), idA);
+  BOOST_CHECK(!map2.getRouterIdByMappingNo(2));
+  BOOST_CHECK(!map2.getMappingNoByRouterName("/ndn/map-test/c"));
+  BOOST_CHECK(!(map1 == map2));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,212 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/multipath-spf.hpp"
+
+#include "adjacent.hpp"
+#include "lsdb.hpp"
+#include "route/map.hpp"
+#include "route/shortest-path-tree.hpp"
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <algorithm>
+#include <tuple>
+
+namespace nlsr {
+namespace test {
+
+class MultipathSpfFixture : public BaseFixture
+{
+public:
+  MultipathSpfFixture()
+    : face(m_ioService, m_keyChain)
+    , conf(face, m_keyChain)
+    , lsdb(face, m_keyChain, conf)
+  {
+    // Square topology A-B-C-D-A with a diagonal B-D
+    installAdjLsa(A, {{B, 1}, {D, 10}});
+    installAdjLsa(B, {{A, 1}, {C, 2}, {D, 4}});
+    installAdjLsa(C, {{B, 2}, {D, 1}});
+    installAdjLsa(D, {{A, 10}, {B, 4}, {C, 1}});
+
+    auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+    map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+    graph = TopologyGraph(lsdb, map);
+
+    ranks.assign(map.getMapSize(), 0);
+    ranks[id(B)] = 0;
+    ranks[id(D)] = 1;
+  }
+
+  void
+  installAdjLsa(const ndn::Name& origin, const std::vector<std::pair<ndn::Name, double>>& links,
+                uint64_t seqNo = 1)
+  {
+    AdjacencyList adjacencies;
+    for (const auto& link : links) {
+      Adjacent adjacent(link.first);
+      adjacent.setLinkCost(link.second);
+      adjacencies.insert(adjacent);
+    }
+    lsdb.installLsa(std::make_shared<AdjLsa>(origin, seqNo, ndn::time::system_clock::TimePoint::max(),
+                                             adjacencies.size(), adjacencies));
+  }
+
+  int32_t
+  id(const ndn::Name& router) const
+  {
+    return *map.getMappingNoByRouterName(router);
+  }
+
+  std::vector<std::pair<int32_t, double>>
+  getRoutes(const MultipathSpf& spf, const ndn::Name& dest) const
+  {
+    std::vector<std::pair<int32_t, double>> routes;
+    for (auto route = spf.routesBegin(id(dest)); route != spf.routesEnd(id(dest)); ++route) {
+      routes.emplace_back(route->nextHop, fromRouteCost(route->cost));
+    }
+    return routes;
+  }
+
+  /*! \brief Checks the routes from \p source against one Dijkstra's calculation per neighbor
+             of \p source, in which only the link to that neighbor leaves \p source.
+  */
+  void
+  checkSameAsPerNeighborCalculation(const ndn::Name& source, size_t nRoutes)
+  {
+    // Rank the neighbors in the reverse order of their links, so that the ranks matter
+    int32_t sourceId = id(source);
+    std::vector<uint32_t> neighborRanks(map.getMapSize(), 0);
+    uint32_t rank = graph.getDegree(sourceId);
+    for (auto link = graph.linksBegin(sourceId); link != graph.linksEnd(sourceId); ++link) {
+      neighborRanks[link->router] = --rank;
+    }
+    MultipathSpf spf(graph, sourceId, nRoutes, neighborRanks);
+
+    std::vector<ShortestPathTree> trees;
+    for (auto link = graph.linksBegin(sourceId); link != graph.linksEnd(sourceId); ++link) {
+      trees.emplace_back(graph, sourceId, link);
+    }
+
+    for (size_t dest = 0; dest < graph.getNRouters(); ++dest) {
+      std::vector<std::tuple<RouteCost, uint32_t, int32_t>> expected;
+      for (const auto& tree : trees) {
+        int32_t nextHop = tree.getNextHop(dest);
+        if (nextHop != ShortestPathTree::NO_NEXT_HOP) {
+          expected.emplace_back(tree.getDistance(dest), neighborRanks[nextHop], nextHop);
+        }
+      }
+      std::sort(expected.begin(), expected.end());
+      expected.resize(std::min(expected.size(), nRoutes));
+
+      BOOST_REQUIRE_EQUAL(static_cast<size_t>(spf.routesEnd(dest) - spf.routesBegin(dest)),
+                          expected.size());
+      for (size_t i = 0; i < expected.size(); ++i) {
+        BOOST_CHECK_EQUAL(spf.routesBegin(dest)[i].cost, std::get<0>(expected[i]));
+        BOOST_CHECK_EQUAL(spf.routesBegin(dest)[i].nextHop, std::get<2>(expected[i]));
+      }
+    }
+  }
+
+public:
+  ndn::util::DummyClientFace face;
+  ConfParameter conf;
+  Lsdb lsdb;
+  Map map;
+  TopologyGraph graph;
+  std::vector<uint32_t> ranks;
+
+  const ndn::Name A{"/ndn/site/%C1.Router/a"};
+  const ndn::Name B{"/ndn/site/%C1.Router/b"};
+  const ndn::Name C{"/ndn/site/%C1.Router/c"};
+  const ndn::Name D{"/ndn/site/%C1.Router/d"};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestMultipathSpf, MultipathSpfFixture)
+
+BOOST_AUTO_TEST_CASE(AllNextHops)
+{
+  MultipathSpf spf(graph, id(A), 2, ranks);
+
+  using Routes = std::vector<std::pair<int32_t, double>>;
+  Routes expectedB{{id(B), 1}, {id(D), 13}};
+  Routes expectedC{{id(B), 3}, {id(D), 11}};
+  Routes expectedD{{id(B), 4}, {id(D), 10}};
+
+  BOOST_CHECK(getRoutes(spf, A).empty());
+  BOOST_CHECK(getRoutes(spf, B) == expectedB);
+  BOOST_CHECK(getRoutes(spf, C) == expectedC);
+  BOOST_CHECK(getRoutes(spf, D) == expectedD);
+}
+
+BOOST_AUTO_TEST_CASE(MaxNextHops)
+{
+  MultipathSpf spf(graph, id(A), 1, ranks);
+
+  using Routes = std::vector<std::pair<int32_t, double>>;
+  BOOST_CHECK(getRoutes(spf, B) == (Routes{{id(B), 1}}));
+  BOOST_CHECK(getRoutes(spf, C) == (Routes{{id(B), 3}}));
+  BOOST_CHECK(getRoutes(spf, D) == (Routes{{id(B), 4}}));
+}
+
+BOOST_AUTO_TEST_CASE(EqualCost)
+{
+  // Make both routes to C cost 11; the lower ranked neighbor comes first
+  installAdjLsa(B, {{A, 1}, {C, 10}, {D, 9}}, 2);
+  installAdjLsa(C, {{B, 10}, {D, 1}}, 2);
+  installAdjLsa(D, {{A, 10}, {B, 9}, {C, 1}}, 2);
+  graph = TopologyGraph(lsdb, map);
+
+  ranks[id(B)] = 1;
+  ranks[id(D)] = 0;
+  MultipathSpf spf(graph, id(A), 1, ranks);
+
+  using Routes = std::vector<std::pair<int32_t, double>>;
+  BOOST_CHECK(getRoutes(spf, C) == (Routes{{id(D), 11}}));
+}
+
+BOOST_AUTO_TEST_CASE(SameAsPerNeighborCalculation)
+{
+  for (const auto& source : {A, B, C, D}) {
+    for (size_t nRoutes : {1, 2, 3}) {
+      BOOST_TEST_MESSAGE("Source " << source << ", " << nRoutes << " route(s)");
+      checkSameAsPerNeighborCalculation(source, nRoutes);
+    }
+  }
+
+  // Equal cost routes are ranked
+  installAdjLsa(B, {{A, 1}, {C, 10}, {D, 9}}, 2);
+  installAdjLsa(C, {{B, 10}, {D, 1}}, 2);
+  installAdjLsa(D, {{A, 10}, {B, 9}, {C, 1}}, 2);
+  graph = TopologyGraph(lsdb, map);
+  for (const auto& source : {A, B, C, D}) {
+    for (size_t nRoutes : {1, 2, 3}) {
+      BOOST_TEST_MESSAGE("Source " << source << ", " << nRoutes << " route(s)");
+      checkSameAsPerNeighborCalculation(source, nRoutes);
+    }
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
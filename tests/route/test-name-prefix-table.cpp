@@ -39,8 +39,8 @@ public:
     , confProcessor(conf)
     , lsdb(face, m_keyChain, conf)
     , fib(face, m_scheduler, conf.getAdjacencyList(), conf, m_keyChain)
-    , rt(m_scheduler, lsdb, conf)
-    , npt(conf.getRouterPrefix(), fib, rt, rt.afterRoutingChange, lsdb.onLsdbModified)
+    , rt(m_ioService, m_scheduler, lsdb, conf)
+    , npt(conf, fib, rt, rt.afterRoutingChange, lsdb.onLsdbModified)
   {
   }
 
@@ -145,7 +145,7 @@ BOOST_FIXTURE_TEST_CASE(AddEntryToPool, NamePrefixTableFixture)
   npt.addRtpeToPool(rtpe1);
 
   BOOST_CHECK_EQUAL(npt.m_rtpool.size(), 1);
-  BOOST_CHECK_EQUAL(*(npt.m_rtpool.find("router1")->second), rtpe1);
+  BOOST_CHECK_EQUAL(*(npt.m_rtpool.find(RouterIdTable::get().intern("router1"))->second), rtpe1);
 }
 
 BOOST_FIXTURE_TEST_CASE(RemoveEntryFromPool, NamePrefixTableFixture)
@@ -158,7 +158,7 @@ BOOST_FIXTURE_TEST_CASE(RemoveEntryFromPool, NamePrefixTableFixture)
   npt.deleteRtpeFromPool(rtpePtr);
 
   BOOST_CHECK_EQUAL(npt.m_rtpool.size(), 0);
-  BOOST_CHECK_EQUAL(npt.m_rtpool.count("router1"), 0);
+  BOOST_CHECK_EQUAL(npt.m_rtpool.count(RouterIdTable::get().intern("router1")), 0);
 }
 
 BOOST_FIXTURE_TEST_CASE(AddRoutingEntryToNptEntry, NamePrefixTableFixture)
@@ -292,7 +292,7 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
                                    });
   BOOST_REQUIRE(nameIterator != npt.end());
 
-  auto iterator = npt.m_rtpool.find(destination);
+  auto iterator = npt.m_rtpool.find(RouterIdTable::get().intern(destination));
   BOOST_REQUIRE(iterator != npt.m_rtpool.end());
   auto nextHops = (iterator->second)->getNexthopList();
   BOOST_CHECK_EQUAL(nextHops.size(), 2);
@@ -307,12 +307,47 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableUpdate, NamePrefixTableFixture)
                                 return entry1.getNamePrefix() == entry->getNamePrefix();
                               });
   BOOST_REQUIRE(nameIterator != npt.end());
-  iterator = npt.m_rtpool.find(destination);
+  iterator = npt.m_rtpool.find(RouterIdTable::get().intern(destination));
   BOOST_REQUIRE(iterator != npt.m_rtpool.end());
   nextHops = (iterator->second)->getNexthopList();
   BOOST_CHECK_EQUAL(nextHops.size(), 3);
 }
 
+BOOST_FIXTURE_TEST_CASE(RoutingTableDeltaUpdate, NamePrefixTableFixture)
+{
+  const ndn::Name destination1("/ndn/destination1");
+  const ndn::Name destination2("/ndn/destination2");
+  const ndn::Name prefix1("/ndn/prefix1");
+  const ndn::Name prefix2("/ndn/prefix2");
+  npt.addEntry(prefix1, destination1);
+  npt.addEntry(prefix2, destination2);
+
+  RoutingTableEntry rte1(destination1);
+  rte1.getNexthopList().addNextHop(NextHop("udp4://10.0.0.1", 1));
+  RoutingTableEntry rte2(destination2);
+  rte2.getNexthopList().addNextHop(NextHop("udp4://10.0.0.2", 1));
+
+  RoutingTableDelta delta;
+  delta.changed = {&rte1, &rte2};
+  npt.updateWithRouteDelta(delta);
+
+  auto& pool1 = npt.m_rtpool.at(RouterIdTable::get().intern(destination1));
+  auto& pool2 = npt.m_rtpool.at(RouterIdTable::get().intern(destination2));
+  BOOST_CHECK_EQUAL(pool1->getNexthopList().size(), 1);
+  BOOST_CHECK_EQUAL(pool2->getNexthopList().size(), 1);
+  BOOST_CHECK(fib.m_table.find(prefix1) != fib.m_table.end());
+  BOOST_CHECK(fib.m_table.find(prefix2) != fib.m_table.end());
+
+  // Destinations that are not in the delta keep their next hops
+  delta.changed.clear();
+  delta.removed.emplace_back(RouterIdTable::get().intern(destination1));
+  npt.updateWithRouteDelta(delta);
+  BOOST_CHECK_EQUAL(pool1->getNexthopList().size(), 0);
+  BOOST_CHECK_EQUAL(pool2->getNexthopList().size(), 1);
+  BOOST_CHECK(fib.m_table.find(prefix1) == fib.m_table.end());
+  BOOST_CHECK(fib.m_table.find(prefix2) != fib.m_table.end());
+}
+
 BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, NamePrefixTableFixture)
 {
   ndn::time::system_clock::TimePoint testTimePoint =  ndn::time::system_clock::now();
@@ -372,6 +407,76 @@ BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, NamePrefixTableFixture)
   BOOST_CHECK_EQUAL(npt.m_table.size(), 0);
 }
 
+BOOST_FIXTURE_TEST_CASE(UpdateFromSummaryLsa, NamePrefixTableFixture)
+{
+  ndn::time::system_clock::TimePoint testTimePoint = ndn::time::system_clock::now();
+  ndn::Name n1("name1");
+  ndn::Name border1("/router1/1");
+
+  SummaryLsa slsa1(border1, 12, testTimePoint, NamePrefixList{n1});
+  slsa1.setArea("1");
+  std::shared_ptr<Lsa> lsaPtr = std::make_shared<SummaryLsa>(slsa1);
+
+  // In the backbone, the summarized names are reached through the border router
+  conf.setArea(ConfParameter::BACKBONE_AREA);
+  npt.updateFromLsdb(lsaPtr, LsdbUpdate::INSTALLED, {}, {});
+  BOOST_CHECK(isNameInNpt(n1));
+  BOOST_CHECK(!isNameInNpt(NamePrefixTable::DEFAULT_ROUTE));
+  npt.updateFromLsdb(lsaPtr, LsdbUpdate::REMOVED, {}, {});
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 0);
+
+  // Inside the summarized area, the border router is the default route
+  conf.setArea("1");
+  npt.updateFromLsdb(lsaPtr, LsdbUpdate::INSTALLED, {}, {});
+  BOOST_CHECK(!isNameInNpt(n1));
+  BOOST_CHECK(isNameInNpt(NamePrefixTable::DEFAULT_ROUTE));
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 2); // Router + default route
+  npt.updateFromLsdb(lsaPtr, LsdbUpdate::REMOVED, {}, {});
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 0);
+
+  // Another border router of the same area reaches the names directly
+  conf.setAreaBorderRouter(true);
+  npt.updateFromLsdb(lsaPtr, LsdbUpdate::INSTALLED, {}, {});
+  BOOST_CHECK_EQUAL(npt.m_table.size(), 1); // Router only
+  npt.updateFromLsdb(lsaPtr, LsdbUpdate::REMOVED, {}, {});
+
+  // A border router of another area uses the summary through the backbone
+  conf.setArea("2");
+  npt.updateFromLsdb(lsaPtr, LsdbUpdate::INSTALLED, {}, {});
+  BOOST_CHECK(isNameInNpt(n1));
+  BOOST_CHECK(!isNameInNpt(NamePrefixTable::DEFAULT_ROUTE));
+}
+
+BOOST_FIXTURE_TEST_CASE(StubRouter, NamePrefixTableFixture)
+{
+  ndn::Name upstreamName("/ndn/edu/memphis/%C1.Router/upstream");
+  Adjacent upstream(upstreamName, ndn::FaceUri("udp4://10.0.0.2"), 0,
+                    Adjacent::STATUS_ACTIVE, 0, 0);
+  conf.getAdjacencyList().insert(upstream);
+  conf.setStubRouter(true);
+  conf.addStubPrefix("/ndn/edu");
+
+  NamePrefixTable stubNpt(conf, fib, rt, rt.afterRoutingChange, lsdb.onLsdbModified);
+  auto isNameInStubNpt = [&stubNpt] (const ndn::Name& name) {
+    return std::any_of(stubNpt.begin(), stubNpt.end(),
+                       [&] (const auto& entry) { return name == entry->getNamePrefix(); });
+  };
+
+  // The neighbors are the default route
+  BOOST_CHECK(isNameInStubNpt(NamePrefixTable::DEFAULT_ROUTE));
+
+  ndn::Name otherRouter("/ndn/edu/arizona/%C1.Router/other");
+  auto lsa = std::make_shared<NameLsa>(otherRouter, 1,
+                                       ndn::time::system_clock::now() + 3600_s,
+                                       NamePrefixList{ndn::Name("/ndn/edu/arizona"),
+                                                      ndn::Name("/ndn/org/example")});
+  stubNpt.updateFromLsdb(lsa, LsdbUpdate::INSTALLED, {}, {});
+
+  // Only the names under the stub prefixes are installed
+  BOOST_CHECK(isNameInStubNpt("/ndn/edu/arizona"));
+  BOOST_CHECK(!isNameInStubNpt("/ndn/org/example"));
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
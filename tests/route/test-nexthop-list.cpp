@@ -159,6 +159,25 @@ BOOST_AUTO_TEST_CASE(SortOnAddAndRemove)
   }
 }
 
+BOOST_AUTO_TEST_CASE(ExactCostTie)
+{
+  // Path costs that add up to the same value tie exactly and are ordered by face URI
+  NextHop hopA("A", 0.1 + 0.2);
+  NextHop hopB("B", 0.3);
+  BOOST_CHECK_EQUAL(hopA.getFixedRouteCost(), hopB.getFixedRouteCost());
+
+  NexthopList list;
+  list.addNextHop(hopB);
+  list.addNextHop(hopA);
+
+  BOOST_REQUIRE_EQUAL(list.size(), 2);
+  BOOST_CHECK_EQUAL(list.begin()->getConnectingFaceUri(), "A");
+
+  list.removeNextHop(NextHop("A", 0.3));
+  BOOST_REQUIRE_EQUAL(list.size(), 1);
+  BOOST_CHECK_EQUAL(list.begin()->getConnectingFaceUri(), "B");
+}
+
 /* If there are two NextHops going to the same neighbor, then the list
    should always select the one with the cheaper cost. This would be
    caused by a Name being advertised by two different routers, which
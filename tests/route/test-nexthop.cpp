@@ -83,7 +83,9 @@ BOOST_AUTO_TEST_CASE(HyperbolicRound)
   hop1.setRouteCost(1 + getHyperbolicAdjustedDecimal(6));
 
   BOOST_CHECK_EQUAL(hop1.getConnectingFaceUri(), "udp://test/uri");
-  BOOST_CHECK_EQUAL(hop1.getRouteCost(), 1 + getHyperbolicAdjustedDecimal(6));
+  // The cost is rounded to fixed point when it is set
+  BOOST_CHECK_EQUAL(hop1.getRouteCost(),
+                    fromRouteCost(toRouteCost(1 + getHyperbolicAdjustedDecimal(6))));
   BOOST_CHECK_EQUAL(hop1.getRouteCostAsAdjustedInteger(),
                     applyHyperbolicFactorAndRound((1 + getHyperbolicAdjustedDecimal(6))));
 
@@ -25,6 +25,8 @@
 
 #include "tests/test-common.hpp"
 
+#include <thread>
+
 namespace nlsr {
 namespace test {
 
@@ -36,7 +38,7 @@ public:
     , conf(face, m_keyChain)
     , confProcessor(conf)
     , lsdb(face, m_keyChain, conf)
-    , rt(m_scheduler, lsdb, conf)
+    , rt(m_ioService, m_scheduler, lsdb, conf)
   {
   }
 
@@ -116,6 +118,64 @@ BOOST_FIXTURE_TEST_CASE(RoutingTableDecode1, RoutingTableFixture)
   BOOST_CHECK_EQUAL(rtStatus.m_rTable.size(), 1);
 }
 
+BOOST_FIXTURE_TEST_CASE(EntryIndex, RoutingTableFixture)
+{
+  RoutingTableStatus decoded(ndn::Block{RoutingTableData1});
+  BOOST_REQUIRE(decoded.findRoutingTableEntry("dest1") != nullptr);
+  BOOST_CHECK(decoded.findRoutingTableEntry("dest2") == nullptr);
+
+  // A copy indexes its own entries
+  RoutingTableStatus copy(decoded);
+  BOOST_CHECK_EQUAL(&copy.findRoutingTableEntry("dest1")->getDestination(),
+                    &copy.m_rTable.front().getDestination());
+
+  NextHop nh;
+  nh.setConnectingFaceUri("nexthop2");
+  nh.setRouteCost(2);
+  copy.addNextHop("dest1", nh);
+  copy.addNextHop("dest2", nh);
+  BOOST_CHECK_EQUAL(copy.m_rTable.size(), 2);
+  BOOST_CHECK_EQUAL(copy.findRoutingTableEntry("dest1")->getNexthopList().size(), 2);
+  BOOST_CHECK_EQUAL(decoded.findRoutingTableEntry("dest1")->getNexthopList().size(), 1);
+
+  decoded.swapEntries(copy);
+  BOOST_CHECK_EQUAL(decoded.m_rTable.size(), 2);
+  BOOST_REQUIRE(decoded.findRoutingTableEntry("dest2") != nullptr);
+  BOOST_CHECK(copy.findRoutingTableEntry("dest2") == nullptr);
+
+  decoded.removeEntry(RouterIdTable::get().intern("dest2"));
+  BOOST_CHECK(decoded.findRoutingTableEntry("dest2") == nullptr);
+  BOOST_CHECK_EQUAL(decoded.m_rTable.size(), 1);
+
+  decoded.clearEntries();
+  BOOST_CHECK(decoded.findRoutingTableEntry("dest1") == nullptr);
+}
+
+BOOST_FIXTURE_TEST_CASE(DiffEntries, RoutingTableFixture)
+{
+  NextHop nh1("udp4://10.0.0.1", 1);
+  NextHop nh2("udp4://10.0.0.2", 2);
+
+  RoutingTableStatus previous;
+  previous.addNextHop("/unchanged", nh1);
+  previous.addNextHop("/changed", nh1);
+  previous.addNextHop("/removed", nh1);
+
+  RoutingTableStatus next;
+  next.addNextHop("/unchanged", nh1);
+  next.addNextHop("/changed", nh2);
+  next.addNextHop("/added", nh2);
+
+  RoutingTableDelta delta = previous.diffEntries(next);
+  BOOST_REQUIRE_EQUAL(delta.changed.size(), 2);
+  BOOST_CHECK_EQUAL(delta.changed[0], next.findRoutingTableEntry("/changed"));
+  BOOST_CHECK_EQUAL(delta.changed[1], next.findRoutingTableEntry("/added"));
+  BOOST_REQUIRE_EQUAL(delta.removed.size(), 1);
+  BOOST_CHECK_EQUAL(delta.removed[0], RouterIdTable::get().intern("/removed"));
+
+  BOOST_CHECK(next.diffEntries(next).empty());
+}
+
 BOOST_FIXTURE_TEST_CASE(RoutingTableOutputStream, RoutingTableFixture)
 {
   NextHop nexthops;
@@ -168,7 +228,8 @@ BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, RoutingTableFixture)
   conf.getAdjacencyList().insert(adj);
   lsdb.scheduleAdjLsaBuild();
   BOOST_CHECK_EQUAL(rt.m_rTable.size(), 0);
-  advanceClocks(15_s);
+  // The calculation triggered by the new Adjacency LSA waits for its own delay
+  advanceClocks(1_s, 15);
   BOOST_CHECK_EQUAL(rt.m_rTable.size(), 1);
 
   rt.wireEncode();
@@ -209,6 +270,101 @@ BOOST_FIXTURE_TEST_CASE(UpdateFromLsdb, RoutingTableFixture)
   BOOST_CHECK(!rt.m_wire.isValid());
 }
 
+BOOST_FIXTURE_TEST_CASE(CalculationThrottle, RoutingTableFixture)
+{
+  size_t nCalculations = 0;
+  size_t nCoalesced = 0;
+  rt.calculationIncrementSignal.connect([&] (Statistics::PacketType type) {
+    if (type == Statistics::PacketType::ROUTING_CALC) {
+      ++nCalculations;
+    }
+    else if (type == Statistics::PacketType::COALESCED_ROUTING_CALC) {
+      ++nCoalesced;
+    }
+  });
+
+  // After a quiet period, only the initial delay applies
+  rt.scheduleRoutingTableCalculation();
+  rt.scheduleRoutingTableCalculation();
+  BOOST_CHECK_EQUAL(nCoalesced, 1);
+  advanceClocks(100_ms);
+  BOOST_CHECK_EQUAL(nCalculations, 1);
+  BOOST_CHECK(!rt.m_isRouteCalculationScheduled);
+
+  // The next calculation waits until the hold time has passed since the last one
+  advanceClocks(400_ms);
+  rt.scheduleRoutingTableCalculation();
+  advanceClocks(500_ms);
+  BOOST_CHECK_EQUAL(nCalculations, 1);
+  advanceClocks(100_ms);
+  BOOST_CHECK_EQUAL(nCalculations, 2);
+
+  // Under sustained churn, the hold time doubles up to the routing calculation interval
+  std::vector<ndn::time::milliseconds> delays{2_s, 4_s, 8_s, 15_s, 15_s};
+  for (const auto& delay : delays) {
+    BOOST_CHECK_EQUAL(rt.getCalculationDelay(), delay);
+  }
+
+  // Once the network is quiet for twice the hold time, the initial delay applies again
+  advanceClocks(30_s);
+  BOOST_CHECK_EQUAL(rt.getCalculationDelay(), 100_ms);
+}
+
+BOOST_FIXTURE_TEST_CASE(BackgroundCalculation, RoutingTableFixture)
+{
+  conf.setRoutingCalcThreads(2);
+  conf.setMaxFacesPerPrefix(1);
+  RoutingTable bgRt(m_ioService, m_scheduler, lsdb, conf);
+  BOOST_REQUIRE_EQUAL(bgRt.m_workerPool.getNThreads(), 2);
+
+  ndn::time::system_clock::TimePoint testTimePoint = ndn::time::system_clock::now() + 3600_s;
+  Adjacent ownAdj(conf.getRouterPrefix());
+  ownAdj.setStatus(Adjacent::STATUS_ACTIVE);
+  AdjacencyList adjl4;
+  adjl4.insert(ownAdj);
+  lsdb.installLsa(std::make_shared<AdjLsa>("/router4", 12, testTimePoint, 1, adjl4));
+
+  Adjacent router4("/router4");
+  router4.setStatus(Adjacent::STATUS_ACTIVE);
+  conf.getAdjacencyList().insert(router4);
+  lsdb.installLsa(std::make_shared<AdjLsa>(conf.getRouterPrefix(), 12, testTimePoint, 1,
+                                           conf.getAdjacencyList()));
+
+  auto waitForCalculation = [&] {
+    for (int i = 0; i < 500 && bgRt.m_isRoutingTableCalculating; ++i) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(10));
+      advanceClocks(1_ms);
+    }
+  };
+
+  // The result is only published from the event loop
+  bgRt.calculate();
+  BOOST_CHECK(bgRt.m_isRoutingTableCalculating);
+  BOOST_CHECK_EQUAL(bgRt.m_rTable.size(), 0);
+
+  // A change in the network makes the running calculation obsolete
+  bgRt.scheduleRoutingTableCalculation();
+  BOOST_CHECK(!bgRt.m_isRoutingTableCalculating);
+  BOOST_CHECK(bgRt.m_pendingCalculation == nullptr);
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  advanceClocks(1_ms);
+  BOOST_CHECK_EQUAL(bgRt.m_rTable.size(), 0);
+
+  // The scheduled calculation runs and is published
+  advanceClocks(15_s);
+  waitForCalculation();
+  BOOST_CHECK(!bgRt.m_isRoutingTableCalculating);
+  BOOST_CHECK_EQUAL(bgRt.m_rTable.size(), 1);
+  BOOST_CHECK(bgRt.findRoutingTableEntry("/router4") != nullptr);
+
+  // The single-path state is handed back for the next, incremental calculation
+  BOOST_CHECK(bgRt.m_lsSpfState != nullptr);
+  bgRt.calculate();
+  waitForCalculation();
+  BOOST_CHECK_EQUAL(bgRt.m_rTable.size(), 1);
+  BOOST_CHECK(bgRt.m_lsSpfState != nullptr);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,267 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/shortest-path-tree.hpp"
+
+#include "adjacent.hpp"
+#include "lsdb.hpp"
+#include "route/map.hpp"
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+#include <algorithm>
+
+namespace nlsr {
+namespace test {
+
+class ShortestPathTreeFixture : public BaseFixture
+{
+public:
+  ShortestPathTreeFixture()
+    : face(m_ioService, m_keyChain)
+    , conf(face, m_keyChain)
+    , lsdb(face, m_keyChain, conf)
+  {
+  }
+
+  void
+  installAdjLsa(const ndn::Name& origin, uint64_t seqNo,
+                const std::vector<std::pair<ndn::Name, double>>& links)
+  {
+    AdjacencyList adjacencies;
+    for (const auto& link : links) {
+      Adjacent adjacent(link.first);
+      adjacent.setLinkCost(link.second);
+      adjacencies.insert(adjacent);
+    }
+    lsdb.installLsa(std::make_shared<AdjLsa>(origin, seqNo,
+                                             ndn::time::system_clock::TimePoint::max(),
+                                             adjacencies.size(), adjacencies));
+  }
+
+  // Square topology A-B-C-D-A with a diagonal B-D
+  void
+  installTopology(uint64_t seqNo, double costBC)
+  {
+    installAdjLsa(A, seqNo, {{B, 1}, {D, 10}});
+    installAdjLsa(B, seqNo, {{A, 1}, {C, costBC}, {D, 4}});
+    installAdjLsa(C, seqNo, {{B, costBC}, {D, 1}});
+    installAdjLsa(D, seqNo, {{A, 10}, {B, 4}, {C, 1}});
+  }
+
+  int32_t
+  id(const ndn::Name& router) const
+  {
+    return *map.getMappingNoByRouterName(router);
+  }
+
+  /*! \brief Checks \p tree against a full calculation over \p graph.
+
+    A next hop may only differ from the full calculation where it is also on a shortest path,
+    i.e. where equal-cost paths were broken differently.
+  */
+  void
+  checkSameAsFullCalculation(const ShortestPathTree& tree, const TopologyGraph& graph)
+  {
+    int32_t source = tree.getSource();
+    ShortestPathTree fullTree(graph, source);
+    for (size_t i = 0; i < graph.getNRouters(); ++i) {
+      BOOST_CHECK_EQUAL(tree.getDistance(i), fullTree.getDistance(i));
+
+      int32_t nextHop = tree.getNextHop(i);
+      if (nextHop == fullTree.getNextHop(i)) {
+        continue;
+      }
+      BOOST_REQUIRE_NE(nextHop, ShortestPathTree::NO_NEXT_HOP);
+      auto link = std::find_if(graph.linksBegin(source), graph.linksEnd(source),
+                               [=] (const TopologyGraph::Link& l) { return l.router == nextHop; });
+      BOOST_REQUIRE(link != graph.linksEnd(source));
+      // A tree that may only leave the source through that neighbor reaches the router
+      // at the same distance
+      ShortestPathTree restrictedTree(graph, source, link);
+      BOOST_CHECK_EQUAL(restrictedTree.getDistance(i), tree.getDistance(i));
+    }
+  }
+
+public:
+  ndn::util::DummyClientFace face;
+  ConfParameter conf;
+  Lsdb lsdb;
+  Map map;
+
+  const ndn::Name A{"/ndn/site/%C1.Router/a"};
+  const ndn::Name B{"/ndn/site/%C1.Router/b"};
+  const ndn::Name C{"/ndn/site/%C1.Router/c"};
+  const ndn::Name D{"/ndn/site/%C1.Router/d"};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestShortestPathTree, ShortestPathTreeFixture)
+
+BOOST_AUTO_TEST_CASE(Basic)
+{
+  installTopology(1, 2);
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  TopologyGraph graph(lsdb, map);
+
+  ShortestPathTree tree(graph, id(A));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(A)), toRouteCost(0));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(B)), toRouteCost(1));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(C)), toRouteCost(3));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(D)), toRouteCost(4));
+
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(A)), ShortestPathTree::NO_NEXT_HOP);
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(B)), id(B));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(C)), id(B));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(D)), id(B));
+  BOOST_CHECK_EQUAL(tree.getParent(id(D)), id(C));
+}
+
+BOOST_AUTO_TEST_CASE(HugeLinkCost)
+{
+  BOOST_CHECK_EQUAL(toRouteCost(std::nan("")), INFINITE_ROUTE_COST);
+  BOOST_CHECK_EQUAL(toRouteCost(std::numeric_limits<double>::infinity()), INFINITE_ROUTE_COST);
+  BOOST_CHECK_EQUAL(toRouteCost(1e300), MAX_LINK_COST);
+  BOOST_CHECK_EQUAL(addRouteCost(INFINITE_ROUTE_COST - 1, MAX_LINK_COST), INFINITE_ROUTE_COST);
+
+  // C is only reachable over huge links, whose costs must not wrap around
+  installAdjLsa(A, 1, {{B, 1}, {D, 10}});
+  installAdjLsa(B, 1, {{A, 1}, {C, 1e300}, {D, 4}});
+  installAdjLsa(C, 1, {{B, 1e300}, {D, 1e300}});
+  installAdjLsa(D, 1, {{A, 10}, {B, 4}, {C, 1e300}});
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  TopologyGraph graph(lsdb, map);
+
+  ShortestPathTree tree(graph, id(A));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(C)), toRouteCost(1) + MAX_LINK_COST);
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(C)), id(B));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(D)), toRouteCost(5));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(D)), id(B));
+}
+
+BOOST_AUTO_TEST_CASE(IncreasedTreeLink)
+{
+  installTopology(1, 2);
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  TopologyGraph oldGraph(lsdb, map);
+  ShortestPathTree tree(oldGraph, id(A));
+
+  // B-C is on the tree; making it expensive moves C and D under the diagonal
+  installTopology(2, 20);
+  TopologyGraph newGraph(lsdb, map);
+  std::vector<int32_t> changed = tree.update(oldGraph, newGraph);
+
+  std::vector<int32_t> expected{id(C), id(D)};
+  std::sort(expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL_COLLECTIONS(changed.begin(), changed.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(tree.getDistance(id(C)), toRouteCost(6));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(D)), toRouteCost(5));
+  BOOST_CHECK_EQUAL(tree.getParent(id(D)), id(B));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(B)), id(B));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(C)), id(B));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(D)), id(B));
+  checkSameAsFullCalculation(tree, newGraph);
+
+  // Making it cheap again restores the original tree
+  installTopology(3, 2);
+  TopologyGraph finalGraph(lsdb, map);
+  changed = tree.update(newGraph, finalGraph);
+
+  BOOST_CHECK_EQUAL_COLLECTIONS(changed.begin(), changed.end(), expected.begin(), expected.end());
+  BOOST_CHECK_EQUAL(tree.getDistance(id(C)), toRouteCost(3));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(D)), toRouteCost(4));
+  BOOST_CHECK_EQUAL(tree.getParent(id(D)), id(C));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(C)), id(B));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(D)), id(B));
+  checkSameAsFullCalculation(tree, finalGraph);
+}
+
+BOOST_AUTO_TEST_CASE(RemovedLink)
+{
+  installTopology(1, 2);
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  TopologyGraph oldGraph(lsdb, map);
+  ShortestPathTree tree(oldGraph, id(A));
+
+  // A withdraws its link to B: everything is now reached through D
+  installAdjLsa(A, 2, {{D, 10}});
+  TopologyGraph newGraph(lsdb, map);
+  std::vector<int32_t> changed = tree.update(oldGraph, newGraph);
+
+  BOOST_CHECK_EQUAL(changed.size(), 3);
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(B)), id(D));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(C)), id(D));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(D)), id(D));
+  checkSameAsFullCalculation(tree, newGraph);
+}
+
+BOOST_AUTO_TEST_CASE(Unchanged)
+{
+  installTopology(1, 2);
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  TopologyGraph oldGraph(lsdb, map);
+  ShortestPathTree tree(oldGraph, id(A));
+
+  installTopology(2, 2);
+  TopologyGraph newGraph(lsdb, map);
+  BOOST_CHECK(tree.update(oldGraph, newGraph).empty());
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(A)), ShortestPathTree::NO_NEXT_HOP);
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(B)), id(B));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(C)), id(B));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(D)), id(B));
+  checkSameAsFullCalculation(tree, newGraph);
+}
+
+BOOST_AUTO_TEST_CASE(EqualCostNextHop)
+{
+  installTopology(1, 2);
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  TopologyGraph oldGraph(lsdb, map);
+  ShortestPathTree tree(oldGraph, id(A));
+
+  // D is now as far through B as it is directly, and C hangs off D
+  installAdjLsa(A, 2, {{B, 1}, {D, 5}});
+  installAdjLsa(B, 2, {{A, 1}, {C, 20}, {D, 4}});
+  installAdjLsa(C, 2, {{B, 20}, {D, 1}});
+  installAdjLsa(D, 2, {{A, 5}, {B, 4}, {C, 1}});
+  TopologyGraph newGraph(lsdb, map);
+  tree.update(oldGraph, newGraph);
+
+  checkSameAsFullCalculation(tree, newGraph);
+  BOOST_CHECK_EQUAL(tree.getDistance(id(D)), toRouteCost(5));
+  BOOST_CHECK_EQUAL(tree.getDistance(id(C)), toRouteCost(6));
+
+  // Either first hop is on a shortest path to D, and C follows D
+  int32_t nextHop = tree.getNextHop(id(D));
+  BOOST_CHECK(nextHop == id(B) || nextHop == id(D));
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(C)), nextHop);
+  BOOST_CHECK_EQUAL(tree.getNextHop(id(B)), id(B));
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -0,0 +1,158 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "route/topology-graph.hpp"
+
+#include "adjacent.hpp"
+#include "lsdb.hpp"
+#include "route/map.hpp"
+#include "tests/test-common.hpp"
+
+#include <ndn-cxx/util/dummy-client-face.hpp>
+
+namespace nlsr {
+namespace test {
+
+class TopologyGraphFixture : public BaseFixture
+{
+public:
+  TopologyGraphFixture()
+    : face(m_ioService, m_keyChain)
+    , conf(face, m_keyChain)
+    , lsdb(face, m_keyChain, conf)
+  {
+  }
+
+  void
+  installAdjLsa(const ndn::Name& origin,
+                const std::vector<std::pair<ndn::Name, double>>& links,
+                const std::string& area = "")
+  {
+    AdjacencyList adjacencies;
+    for (const auto& link : links) {
+      Adjacent adjacent(link.first);
+      adjacent.setLinkCost(link.second);
+      adjacencies.insert(adjacent);
+    }
+    auto lsa = std::make_shared<AdjLsa>(origin, 1, ndn::time::system_clock::TimePoint::max(),
+                                        adjacencies.size(), adjacencies);
+    lsa->setArea(area);
+    lsdb.installLsa(lsa);
+  }
+
+  int32_t
+  id(const ndn::Name& router) const
+  {
+    return *map.getMappingNoByRouterName(router);
+  }
+
+public:
+  ndn::util::DummyClientFace face;
+  ConfParameter conf;
+  Lsdb lsdb;
+  Map map;
+
+  const ndn::Name A{"/ndn/site/%C1.Router/a"};
+  const ndn::Name B{"/ndn/site/%C1.Router/b"};
+  const ndn::Name C{"/ndn/site/%C1.Router/c"};
+  const ndn::Name D{"/ndn/site/%C1.Router/d"};
+};
+
+BOOST_FIXTURE_TEST_SUITE(TestTopologyGraph, TopologyGraphFixture)
+
+BOOST_AUTO_TEST_CASE(ReconcileCosts)
+{
+  installAdjLsa(A, {{B, 5}, {C, 10}});
+  installAdjLsa(B, {{A, 5}, {C, 17}});
+  installAdjLsa(C, {{A, 12}, {D, 3}});
+
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+  TopologyGraph graph(lsdb, map);
+
+  BOOST_CHECK_EQUAL(graph.getNRouters(), 4);
+
+  // Symmetric link is kept as is
+  BOOST_CHECK_EQUAL(graph.getLinkCost(id(A), id(B)), toRouteCost(5));
+  BOOST_CHECK_EQUAL(graph.getLinkCost(id(B), id(A)), toRouteCost(5));
+
+  // Asymmetric link uses the larger cost in both directions
+  BOOST_CHECK_EQUAL(graph.getLinkCost(id(A), id(C)), toRouteCost(12));
+  BOOST_CHECK_EQUAL(graph.getLinkCost(id(C), id(A)), toRouteCost(12));
+
+  // Links advertised by only one side are broken
+  BOOST_CHECK_EQUAL(graph.getLinkCost(id(B), id(C)), INFINITE_ROUTE_COST);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(id(C), id(B)), INFINITE_ROUTE_COST);
+  BOOST_CHECK_EQUAL(graph.getLinkCost(id(C), id(D)), INFINITE_ROUTE_COST);
+
+  BOOST_CHECK_EQUAL(graph.getNLinks(), 4);
+  BOOST_CHECK_EQUAL(graph.getDegree(id(A)), 2);
+  BOOST_CHECK_EQUAL(graph.getDegree(id(B)), 1);
+  BOOST_CHECK_EQUAL(graph.getDegree(id(C)), 1);
+  BOOST_CHECK_EQUAL(graph.getDegree(id(D)), 0);
+
+  // Links are sorted by neighbor
+  for (size_t i = 0; i < graph.getNRouters(); ++i) {
+    for (auto link = graph.linksBegin(i); link != graph.linksEnd(i); ++link) {
+      BOOST_CHECK_NE(link->router, static_cast<int32_t>(i));
+      if (link + 1 != graph.linksEnd(i)) {
+        BOOST_CHECK_LT(link->router, (link + 1)->router);
+      }
+    }
+  }
+}
+
+BOOST_AUTO_TEST_CASE(AreaFilter)
+{
+  // B is the border router between area 1 (A, B) and the backbone (B, C)
+  installAdjLsa(A, {{B, 5}, {C, 7}}, "1");
+  installAdjLsa(B, {{A, 5}, {C, 10}}, "1");
+  installAdjLsa(C, {{A, 7}, {B, 10}}, "0");
+
+  auto lsaRange = lsdb.getLsdbIterator<AdjLsa>();
+  map.createFromAdjLsdb(lsaRange.first, lsaRange.second);
+
+  TopologyGraph area(lsdb, map, [] (const AdjLsa& lsa) { return lsa.getArea() == "1"; });
+  BOOST_CHECK_EQUAL(area.getNRouters(), 3);
+  BOOST_CHECK_EQUAL(area.getLinkCost(id(A), id(B)), toRouteCost(5));
+  // Links to routers of other areas are only advertised by one side
+  BOOST_CHECK_EQUAL(area.getLinkCost(id(A), id(C)), INFINITE_ROUTE_COST);
+  BOOST_CHECK_EQUAL(area.getLinkCost(id(B), id(C)), INFINITE_ROUTE_COST);
+  BOOST_CHECK_EQUAL(area.getNLinks(), 2);
+
+  TopologyGraph backbone(lsdb, map, [this] (const AdjLsa& lsa) {
+    return lsa.getArea() == "0" || lsa.getOriginRouter() == B;
+  });
+  BOOST_CHECK_EQUAL(backbone.getLinkCost(id(B), id(C)), toRouteCost(10));
+  BOOST_CHECK_EQUAL(backbone.getLinkCost(id(A), id(C)), INFINITE_ROUTE_COST);
+  BOOST_CHECK_EQUAL(backbone.getNLinks(), 2);
+}
+
+BOOST_AUTO_TEST_CASE(Empty)
+{
+  TopologyGraph graph(lsdb, map);
+  BOOST_CHECK_EQUAL(graph.getNRouters(), 0);
+  BOOST_CHECK_EQUAL(graph.getNLinks(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
@@ -188,6 +188,8 @@ public:
     conf.buildRouterAndSyncUserPrefix();
     conf.setSyncProtocol(protocol);
     conf.setHyperbolicState(hyperbolicState);
+    // Calculate routes in place, so that tests see the result of a calculation right away
+    conf.setRoutingCalcThreads(0);
   }
 };
 
@@ -96,7 +96,11 @@ const std::string SECTION_FIB =
   "fib\n"
   "{\n"
   "   max-faces-per-prefix 3\n"
+  "   fast-reroute on\n"
   "   routing-calc-interval 9\n"
+  "   routing-calc-initial-delay 50\n"
+  "   routing-calc-hold-time 500\n"
+  "   routing-calc-threads 4\n"
   "}\n\n";
 
 const std::string SECTION_ADVERTISING =
@@ -104,6 +108,7 @@ const std::string SECTION_ADVERTISING =
   "{\n"
   "  prefix /ndn/edu/memphis/cs/netlab\n"
   "  prefix /ndn/edu/memphis/sports/basketball\n"
+  "  aggregate /ndn/edu/memphis/sports\n"
   "}\n";
 
 // NEED TO TEST SECURITY SECTION SUCH AS LOADING CERTIFICATE
@@ -202,10 +207,16 @@ BOOST_AUTO_TEST_CASE(LinkState)
 
   // FIB
   BOOST_CHECK_EQUAL(conf.getMaxFacesPerPrefix(), 3);
+  BOOST_CHECK_EQUAL(conf.getFastReroute(), true);
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(), 9);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialDelay(), 50);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcHoldTime(), 500);
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcThreads(), 4);
 
   // Advertising
   BOOST_CHECK_EQUAL(conf.getNamePrefixList().size(), 2);
+  BOOST_REQUIRE_EQUAL(conf.getAggregationRules().size(), 1);
+  BOOST_CHECK_EQUAL(conf.getAggregationRules().front(), "/ndn/edu/memphis/sports");
 }
 
 BOOST_AUTO_TEST_CASE(MalformedUri)
@@ -265,6 +276,9 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   BOOST_CHECK_EQUAL(conf.getLsaInterestLifetime(),
                     static_cast<ndn::time::seconds>(LSA_INTEREST_LIFETIME_DEFAULT));
   BOOST_CHECK_EQUAL(conf.getRouterDeadInterval(), (2 * conf.getLsaRefreshTime()));
+  BOOST_CHECK_EQUAL(conf.getArea(), "");
+  BOOST_CHECK_EQUAL(conf.isAreaBorderRouter(), false);
+  BOOST_CHECK_EQUAL(conf.isStubRouter(), false);
 
   BOOST_CHECK(conf.m_confFileName != conf.getConfFileNameDynamic());
   conf.m_confFileName = "/tmp/nlsr.conf";
@@ -272,6 +286,50 @@ BOOST_AUTO_TEST_CASE(DefaultValuesGeneral)
   BOOST_CHECK(!processConfigurationString(config));
 }
 
+BOOST_AUTO_TEST_CASE(Areas)
+{
+  std::string config = SECTION_GENERAL;
+  boost::replace_all(config, "  router /cs/pollux/\n",
+                     "  router /cs/pollux/\n  area 1\n  area-border-router on\n");
+
+  BOOST_REQUIRE(processConfigurationString(config));
+  BOOST_CHECK_EQUAL(conf.getArea(), "1");
+  BOOST_CHECK_EQUAL(conf.isAreaBorderRouter(), true);
+  BOOST_CHECK(conf.isInArea("1"));
+  BOOST_CHECK(conf.isInArea(ConfParameter::BACKBONE_AREA));
+  BOOST_CHECK(!conf.isInArea("2"));
+  auto syncVersion = ConfParameter::SYNC_VERSION;
+  BOOST_CHECK_EQUAL(conf.getSyncPrefix(),
+                    ndn::Name("/localhop/ndn/nlsr/sync/1").appendVersion(syncVersion));
+  BOOST_CHECK_EQUAL(conf.getAreaSyncPrefix(ConfParameter::BACKBONE_AREA),
+                    ndn::Name("/localhop/ndn/nlsr/sync/0").appendVersion(syncVersion));
+  // LSAs keep their names, so that they can be fetched across the areas of a border router
+  BOOST_CHECK_EQUAL(conf.getLsaPrefix(), "/localhop/ndn/nlsr/LSA");
+
+  // The backbone has no border to another area
+  boost::replace_all(config, "area 1", "area 0");
+  BOOST_CHECK(!processConfigurationString(config));
+}
+
+BOOST_AUTO_TEST_CASE(StubRouter)
+{
+  std::string config = SECTION_GENERAL;
+  boost::replace_all(config, "  router /cs/pollux/\n",
+                     "  router /cs/pollux/\n  stub-router on\n"
+                     "  stub-prefix /ndn/edu\n  stub-prefix /ndn/org/example\n");
+
+  BOOST_REQUIRE(processConfigurationString(config));
+  BOOST_CHECK_EQUAL(conf.isStubRouter(), true);
+  BOOST_REQUIRE_EQUAL(conf.getStubPrefixes().size(), 2);
+  BOOST_CHECK(conf.isStubPrefix("/ndn/edu/ucla"));
+  BOOST_CHECK(conf.isStubPrefix("/ndn/org/example"));
+  BOOST_CHECK(!conf.isStubPrefix("/ndn/org"));
+
+  // Stub prefixes only apply to stub routers
+  boost::replace_all(config, "stub-router on", "stub-router off");
+  BOOST_CHECK(!processConfigurationString(config));
+}
+
 BOOST_AUTO_TEST_CASE(DefaultValuesNeighbors)
 {
   std::string config = SECTION_NEIGHBORS;
@@ -322,14 +380,25 @@ BOOST_AUTO_TEST_CASE(DefaultValuesFib)
   std::string config = SECTION_FIB;
 
   commentOut("max-faces-per-prefix", config);
+  commentOut("fast-reroute", config);
   commentOut("routing-calc-interval", config);
+  commentOut("routing-calc-initial-delay", config);
+  commentOut("routing-calc-hold-time", config);
+  commentOut("routing-calc-threads", config);
 
   BOOST_CHECK_EQUAL(processConfigurationString(config), true);
 
   BOOST_CHECK_EQUAL(conf.getMaxFacesPerPrefix(),
                     static_cast<uint32_t>(MAX_FACES_PER_PREFIX_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getFastReroute(), false);
   BOOST_CHECK_EQUAL(conf.getRoutingCalcInterval(),
                     static_cast<uint32_t>(ROUTING_CALC_INTERVAL_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcInitialDelay(),
+                    static_cast<uint32_t>(ROUTING_CALC_INITIAL_DELAY_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcHoldTime(),
+                    static_cast<uint32_t>(ROUTING_CALC_HOLD_TIME_DEFAULT));
+  BOOST_CHECK_EQUAL(conf.getRoutingCalcThreads(),
+                    static_cast<uint32_t>(ROUTING_CALC_THREADS_DEFAULT));
 }
 
 BOOST_AUTO_TEST_CASE(DefaultValuesHyperbolic)
@@ -38,6 +38,9 @@ BOOST_AUTO_TEST_CASE(ConfParameterSettersAndGetters)
   ndn::KeyChain keyChain;
   ConfParameter cp1(face, keyChain);
 
+  // Routing tables are calculated off the main thread by default
+  BOOST_CHECK_EQUAL(cp1.getRoutingCalcThreads(), 1);
+
   const string NAME = "router1";
   const string SITE = "memphis";
   const string NETWORK = "ATT";
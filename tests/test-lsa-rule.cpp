@@ -131,6 +131,33 @@ BOOST_AUTO_TEST_CASE(ValidateCorrectLSA)
                                     });
 }
 
+BOOST_AUTO_TEST_CASE(ValidateNameLsaDelta)
+{
+  ndn::Name lsaDataName = confParam.getLsaPrefix();
+  lsaDataName.append(confParam.getSiteName());
+  lsaDataName.append(confParam.getRouterName());
+
+  // Append the delta component, the sequence number and the base sequence number
+  uint64_t seqNo = lsdb.m_sequencingManager.getNameLsaSeq();
+  lsaDataName.append("NAME-DELTA").appendNumber(seqNo).appendNumber(seqNo - 1);
+
+  // Append version, segmentNo
+  lsaDataName.appendNumber(1).appendNumber(1);
+
+  ndn::Data data(lsaDataName);
+  data.setFreshnessPeriod(10_s);
+
+  // Sign data with NLSR's key
+  m_keyChain.sign(data, confParam.getSigningInfo());
+
+  // Make NLSR validate data signed by its own key
+  confParam.getValidator().validate(data,
+                                    [] (const Data&) { BOOST_CHECK(true); },
+                                    [] (const Data&, const ndn::security::ValidationError& e) {
+                                      BOOST_ERROR(e);
+                                    });
+}
+
 BOOST_AUTO_TEST_CASE(DoNotValidateIncorrectLSA)
 {
   // getSubName removes the /localhop compnonent from /localhop/ndn/NLSR/LSA
@@ -20,10 +20,13 @@
  */
 
 #include "lsa/name-lsa.hpp"
+#include "lsa/name-lsa-delta.hpp"
 #include "lsa/adj-lsa.hpp"
 #include "lsa/coordinate-lsa.hpp"
+#include "lsa/summary-lsa.hpp"
 #include "test-common.hpp"
 #include "adjacent.hpp"
+#include "tlv-nlsr.hpp"
 #include "name-prefix-list.hpp"
 
 #include <ndn-cxx/util/time.hpp>
@@ -443,6 +446,74 @@ BOOST_AUTO_TEST_CASE(NameLsaUpdate)
   BOOST_CHECK(it != namesToAdd.end());
 }
 
+BOOST_AUTO_TEST_CASE(SummaryLsaArea)
+{
+  NamePrefixList npl{ndn::Name("name1"), ndn::Name("name2")};
+  auto testTimePoint = ndn::time::fromUnixTimestamp(ndn::time::milliseconds(1585196014943));
+
+  SummaryLsa slsa1("router1", 12, testTimePoint, npl);
+  slsa1.setArea("1");
+  BOOST_CHECK_EQUAL(slsa1.getType(), Lsa::Type::SUMMARY);
+
+  auto wire = slsa1.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), ndn::tlv::nlsr::SummaryLsa);
+
+  SummaryLsa slsa2(wire);
+  BOOST_CHECK_EQUAL(slsa2.getOriginRouter(), ndn::Name("router1"));
+  BOOST_CHECK_EQUAL(slsa2.getSeqNo(), 12);
+  BOOST_CHECK_EQUAL(slsa2.getArea(), "1");
+  BOOST_CHECK(slsa2.isEqualContent(slsa1));
+
+  // A summary LSA is not a name LSA on the wire
+  BOOST_CHECK_THROW(NameLsa{wire}, ndn::tlv::Error);
+
+  // The area is only encoded when it is set, so that name LSAs of routers
+  // that do not use areas are not changed
+  NameLsa nlsa1("router1", 12, testTimePoint, npl);
+  BOOST_CHECK_EQUAL(NameLsa(nlsa1.wireEncode()).getArea(), "");
+  nlsa1.setArea("0");
+  NameLsa nlsa2(nlsa1.wireEncode());
+  BOOST_CHECK_EQUAL(nlsa2.getArea(), "0");
+  NameLsa nlsa3(nlsa2);
+  BOOST_CHECK_EQUAL(nlsa3.getArea(), "0");
+}
+
+BOOST_AUTO_TEST_CASE(NameLsaDeltaBasic)
+{
+  ndn::Name name1("name1");
+  ndn::Name name2("name2");
+  ndn::Name name3("name3");
+  auto testTimePoint = ndn::time::fromUnixTimestamp(ndn::time::milliseconds(1585196014943));
+
+  NameLsaDelta delta1("router1", 13, 12, testTimePoint, {name1, name2}, {name3});
+  delta1.setArea("1");
+  BOOST_CHECK_EQUAL(delta1.getType(), Lsa::Type::NAME);
+
+  auto wire = delta1.wireEncode();
+  BOOST_CHECK_EQUAL(wire.type(), ndn::tlv::nlsr::NameLsaDelta);
+
+  NameLsaDelta delta2(wire);
+  BOOST_CHECK_EQUAL(delta2.getOriginRouter(), ndn::Name("router1"));
+  BOOST_CHECK_EQUAL(delta2.getSeqNo(), 13);
+  BOOST_CHECK_EQUAL(delta2.getBaseSeqNo(), 12);
+  BOOST_CHECK_EQUAL(delta2.getArea(), "1");
+  BOOST_CHECK(delta2.getAddedNames() == (std::list<ndn::Name>{name1, name2}));
+  BOOST_CHECK(delta2.getRemovedNames() == std::list<ndn::Name>{name3});
+
+  // A delta is not a name LSA on the wire
+  BOOST_CHECK_THROW(NameLsa{wire}, ndn::tlv::Error);
+
+  // Names added by one delta and removed by the next cancel out
+  NameLsaDelta delta3("router1", 14, 13, testTimePoint + 1_s, {name3}, {name2});
+  delta1.append(delta3);
+  BOOST_CHECK_EQUAL(delta1.getSeqNo(), 14);
+  BOOST_CHECK_EQUAL(delta1.getBaseSeqNo(), 12);
+  BOOST_CHECK_EQUAL(delta1.getExpirationTimePoint(), testTimePoint + 1_s);
+  BOOST_CHECK(delta1.getAddedNames() == std::list<ndn::Name>{name1});
+  BOOST_CHECK(delta1.getRemovedNames().empty());
+  BOOST_CHECK_EQUAL(NameLsaDelta(delta1.wireEncode()).getSeqNo(), 14);
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
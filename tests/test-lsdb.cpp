@@ -28,6 +28,8 @@
 #include <ndn-cxx/util/dummy-client-face.hpp>
 #include <ndn-cxx/util/segment-fetcher.hpp>
 
+#include <boost/filesystem.hpp>
+
 #include <unistd.h>
 
 namespace nlsr {
@@ -411,6 +413,269 @@ BOOST_AUTO_TEST_CASE(InstallNameLsa)
   BOOST_CHECK_EQUAL(nameList, newPrefixes);
 }
 
+BOOST_AUTO_TEST_CASE(AggregateOwnNames)
+{
+  ndn::Name aggregate("/site/app");
+  ndn::Name instance1("/site/app/instance-1");
+  ndn::Name instance2("/site/app/instance-2");
+  ndn::Name other("/site/other");
+  conf.addAggregationRule(aggregate);
+
+  auto& npl = conf.getNamePrefixList();
+  npl.insert(instance1);
+  npl.insert(other);
+  lsdb.buildAndInstallOwnNameLsa();
+
+  auto advertisedNames = [this] {
+    auto ownLsa = lsdb.findLsa<NameLsa>(conf.getRouterPrefix());
+    BOOST_REQUIRE(ownLsa != nullptr);
+    auto names = ownLsa->getNpl().getNames();
+    return std::set<ndn::Name>(names.begin(), names.end());
+  };
+
+  auto names = advertisedNames();
+  BOOST_CHECK_EQUAL(names.count(aggregate), 1);
+  BOOST_CHECK_EQUAL(names.count(instance1), 0);
+  BOOST_CHECK_EQUAL(names.count(other), 1);
+  BOOST_REQUIRE_EQUAL(lsdb.m_suppressedNames.count(aggregate), 1);
+  BOOST_CHECK_EQUAL(lsdb.m_suppressedNames[aggregate].size(), 1);
+
+  // Another covered name does not change the advertised names
+  uint64_t seqNo = lsdb.m_sequencingManager.getNameLsaSeq();
+  npl.insert(instance2);
+  lsdb.buildAndInstallOwnNameLsa();
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo);
+  BOOST_CHECK_EQUAL(lsdb.m_suppressedNames[aggregate].size(), 2);
+
+  // The aggregate is withdrawn with its last covered name
+  npl.remove(instance1);
+  lsdb.buildAndInstallOwnNameLsa();
+  BOOST_CHECK_EQUAL(advertisedNames().count(aggregate), 1);
+  npl.remove(instance2);
+  lsdb.buildAndInstallOwnNameLsa();
+  BOOST_CHECK_EQUAL(lsdb.m_sequencingManager.getNameLsaSeq(), seqNo + 1);
+  BOOST_CHECK_EQUAL(advertisedNames().count(aggregate), 0);
+  BOOST_CHECK(lsdb.m_suppressedNames.empty());
+}
+
+BOOST_AUTO_TEST_CASE(OwnNameLsaDeltas)
+{
+  auto& npl = conf.getNamePrefixList();
+  for (int i = 0; i < 3; ++i) {
+    npl.insert(ndn::Name("/ndn/name").appendNumber(i));
+  }
+  lsdb.buildAndInstallOwnNameLsa();
+  uint64_t baseSeqNo = lsdb.m_sequencingManager.getNameLsaSeq();
+
+  ndn::Name newName("/ndn/name/new");
+  npl.insert(newName);
+  lsdb.buildAndInstallOwnNameLsa();
+
+  auto delta = lsdb.buildOwnNameLsaDelta(baseSeqNo);
+  BOOST_REQUIRE(delta);
+  BOOST_CHECK_EQUAL(delta->getSeqNo(), baseSeqNo + 1);
+  BOOST_CHECK(delta->getAddedNames() == std::list<ndn::Name>{newName});
+  BOOST_CHECK(delta->getRemovedNames().empty());
+
+  // A delta that is not smaller than the LSA, or from an unknown base, is not built
+  BOOST_CHECK(!lsdb.buildOwnNameLsaDelta(baseSeqNo - 1));
+  BOOST_CHECK(!lsdb.buildOwnNameLsaDelta(baseSeqNo + 10));
+
+  // A refresh extends the delta to the new sequence number
+  lsdb.expireOrRefreshLsa(lsdb.findLsa<NameLsa>(conf.getRouterPrefix()));
+  delta = lsdb.buildOwnNameLsaDelta(baseSeqNo);
+  BOOST_REQUIRE(delta);
+  BOOST_CHECK_EQUAL(delta->getSeqNo(), baseSeqNo + 2);
+  BOOST_CHECK(delta->getAddedNames() == std::list<ndn::Name>{newName});
+}
+
+BOOST_AUTO_TEST_CASE(ApplyNameLsaDelta)
+{
+  ndn::Name otherRouter("/ndn/site/%C1.router/other-router");
+  ndn::Name name1("/ndn/name1");
+  ndn::Name name2("/ndn/name2");
+  ndn::Name name3("/ndn/name3");
+  auto maxTime = ndn::time::system_clock::TimePoint::max();
+
+  NameLsa lsa(otherRouter, 2, maxTime, NamePrefixList{name1, name2});
+  lsdb.installLsa(std::make_shared<NameLsa>(lsa));
+  connectSignal();
+
+  NameLsaDelta delta(otherRouter, 3, 2, maxTime, {name3}, {name1});
+  BOOST_CHECK(lsdb.applyNameLsaDelta(delta));
+  auto installed = lsdb.findLsa<NameLsa>(otherRouter);
+  checkSignalResult(LsdbUpdate::UPDATED, installed, {name3}, {name1});
+  BOOST_CHECK_EQUAL(installed->getSeqNo(), 3);
+  BOOST_CHECK_EQUAL(installed->getNpl(), (NamePrefixList{name2, name3}));
+
+  // The LSDB no longer holds the base of this delta
+  NameLsaDelta staleDelta(otherRouter, 5, 2, maxTime, {name1}, {});
+  BOOST_CHECK(!lsdb.applyNameLsaDelta(staleDelta));
+  BOOST_CHECK_EQUAL(installed->getSeqNo(), 3);
+  BOOST_CHECK(!updateHappened);
+}
+
+BOOST_AUTO_TEST_CASE(FetchNameLsaDelta)
+{
+  ndn::Name originRouter("/ndn/site/%C1.Router/this-router");
+  auto& npl = conf.getNamePrefixList();
+  for (int i = 0; i < 3; ++i) {
+    npl.insert(ndn::Name("/ndn/name").appendNumber(i));
+  }
+  lsdb.buildAndInstallOwnNameLsa();
+  NameLsa baseLsa(lsdb.findLsa<NameLsa>(originRouter)->wireEncode());
+
+  npl.insert(ndn::Name("/ndn/name/new"));
+  lsdb.buildAndInstallOwnNameLsa();
+  auto ownLsa = lsdb.findLsa<NameLsa>(originRouter);
+
+  ndn::util::DummyClientFace face2(m_ioService, m_keyChain, {true, true});
+  face.linkTo(face2);
+
+  ConfParameter conf2(face2, m_keyChain);
+  std::string config = R"CONF(
+              trust-anchor
+                {
+                  type any
+                }
+            )CONF";
+  conf2.getValidator().load(config, "config-file-from-string");
+
+  Lsdb lsdb2(face2, m_keyChain, conf2);
+  lsdb2.installLsa(std::make_shared<NameLsa>(baseLsa));
+
+  advanceClocks(ndn::time::milliseconds(10), 10);
+
+  ndn::Name lsaName("/localhop/ndn/nlsr/LSA/site/%C1.Router/this-router/NAME");
+  lsdb2.expressInterest(lsdb2.getNameLsaDeltaName(lsaName, ownLsa->getSeqNo(),
+                                                  baseLsa.getSeqNo()), 0);
+
+  advanceClocks(ndn::time::milliseconds(200), 20);
+
+  auto fetchedLsa = lsdb2.findLsa<NameLsa>(originRouter);
+  BOOST_REQUIRE(fetchedLsa != nullptr);
+  BOOST_CHECK_EQUAL(fetchedLsa->getSeqNo(), ownLsa->getSeqNo());
+  auto ownNames = ownLsa->getNpl().getNames();
+  auto fetchedNames = fetchedLsa->getNpl().getNames();
+  BOOST_CHECK(std::set<ndn::Name>(fetchedNames.begin(), fetchedNames.end()) ==
+              std::set<ndn::Name>(ownNames.begin(), ownNames.end()));
+}
+
+BOOST_AUTO_TEST_CASE(NameLsaDeltaNaming)
+{
+  ndn::Name otherRouter("/ndn/site/%C1.router/other-router");
+  ndn::Name lsaName = lsdb.getLsaName(otherRouter, Lsa::Type::NAME);
+  ndn::Name fullName = ndn::Name(lsaName).appendNumber(3);
+  ndn::Name deltaName = lsdb.getNameLsaDeltaName(lsaName, 3, 2);
+
+  // An Interest for the full LSA cannot be answered with cached delta segments
+  BOOST_CHECK(!fullName.isPrefixOf(deltaName));
+  ndn::Name convertedName(deltaName);
+  BOOST_CHECK_EQUAL(lsdb.toFullLsaName(convertedName).value_or(0), 2);
+  BOOST_CHECK_EQUAL(convertedName, fullName);
+
+  // A delta received for the full LSA is neither applied nor fetched again
+  auto maxTime = ndn::time::system_clock::TimePoint::max();
+  NameLsa lsa(otherRouter, 2, maxTime, NamePrefixList{ndn::Name("/ndn/name1")});
+  lsdb.installLsa(std::make_shared<NameLsa>(lsa));
+  NameLsaDelta delta(otherRouter, 3, 2, maxTime, {ndn::Name("/ndn/name2")}, {});
+  lsdb.afterFetchLsa(delta.wireEncode().getBuffer(), fullName);
+  advanceClocks(10_ms);
+  BOOST_CHECK_EQUAL(lsdb.findLsa<NameLsa>(otherRouter)->getSeqNo(), 2);
+  BOOST_CHECK(face.sentInterests.empty());
+}
+
+BOOST_AUTO_TEST_CASE(HighestSeqNoPruning)
+{
+  ndn::Name otherRouter("/ndn/site/%C1.router/other-router");
+  ndn::Name lsaName = lsdb.getLsaName(otherRouter, Lsa::Type::NAME);
+
+  BOOST_CHECK(lsdb.updateHighestSeqNo(lsaName, 2));
+  BOOST_CHECK(!lsdb.updateHighestSeqNo(lsaName, 1));
+  BOOST_CHECK(lsdb.updateHighestSeqNo(lsaName, 2));
+  BOOST_CHECK_EQUAL(lsdb.m_highestSeqNo.at(lsaName).seqNo, 2);
+
+  NameLsa lsa(otherRouter, 2, ndn::time::system_clock::TimePoint::max(), NamePrefixList{});
+  lsdb.installLsa(std::make_shared<NameLsa>(lsa));
+  lsdb.removeLsa(otherRouter, Lsa::Type::NAME);
+
+  // The removed LSA leaves a tombstone that still rejects older sequence numbers
+  BOOST_CHECK(!lsdb.updateHighestSeqNo(lsaName, 1));
+  advanceClocks(1_s, lsdb.m_lsaRefreshTime.count() + 1);
+  BOOST_CHECK_EQUAL(lsdb.m_highestSeqNo.count(lsaName), 0);
+
+  // A newer sequence number revives the entry and cancels the pruning
+  BOOST_CHECK(lsdb.updateHighestSeqNo(lsaName, 3));
+  lsdb.schedulePruneHighestSeqNo(lsaName);
+  BOOST_CHECK(lsdb.updateHighestSeqNo(lsaName, 4));
+  advanceClocks(1_s, lsdb.m_lsaRefreshTime.count() + 1);
+  BOOST_CHECK_EQUAL(lsdb.m_highestSeqNo.count(lsaName), 1);
+}
+
+BOOST_AUTO_TEST_CASE(Snapshot)
+{
+  conf.setStateFileDir("/tmp");
+  ndn::Name router1("/ndn/site/%C1.router/router1");
+  ndn::Name router2("/ndn/site/%C1.router/router2");
+  auto now = ndn::time::system_clock::now();
+
+  NameLsa nameLsa(router1, 12, now + 3600_s, NamePrefixList{ndn::Name("/ndn/name1")});
+  lsdb.installLsa(std::make_shared<NameLsa>(nameLsa));
+  AdjacencyList adjacencies;
+  AdjLsa adjLsa(router1, 5, now + 3600_s, 0, adjacencies);
+  lsdb.installLsa(std::make_shared<AdjLsa>(adjLsa));
+  // Expires before the restart
+  NameLsa expiringLsa(router2, 3, now + 10_s, NamePrefixList{});
+  lsdb.installLsa(std::make_shared<NameLsa>(expiringLsa));
+
+  lsdb.writeSnapshot();
+  lsdb.removeLsa(router1, Lsa::Type::NAME);
+  lsdb.removeLsa(router1, Lsa::Type::ADJACENCY);
+  lsdb.removeLsa(router2, Lsa::Type::NAME);
+
+  advanceClocks(1_s, 20);
+  lsdb.loadSnapshot();
+
+  auto loaded = lsdb.findLsa<NameLsa>(router1);
+  BOOST_REQUIRE(loaded != nullptr);
+  BOOST_CHECK_EQUAL(loaded->getSeqNo(), 12);
+  BOOST_CHECK_EQUAL(loaded->getNpl(), nameLsa.getNpl());
+  BOOST_CHECK(lsdb.doesLsaExist(router1, Lsa::Type::ADJACENCY));
+  BOOST_CHECK(!lsdb.doesLsaExist(router2, Lsa::Type::NAME));
+  // Own LSAs are not part of the snapshot, so loading does not replace them
+  BOOST_CHECK(lsdb.doesLsaExist(conf.getRouterPrefix(), Lsa::Type::NAME));
+
+  boost::filesystem::remove(lsdb.getSnapshotFileName());
+}
+
+BOOST_AUTO_TEST_CASE(SnapshotWriter)
+{
+  conf.setStateFileDir("/tmp");
+  conf.setStateFsync(true);
+  conf.setLsdbSnapshotInterval(60);
+  // Snapshots are enabled when the LSDB is constructed
+  Lsdb snapshotLsdb(face, m_keyChain, conf);
+  BOOST_CHECK_EQUAL(snapshotLsdb.m_snapshotWriter.getNThreads(), 1);
+  BOOST_CHECK_EQUAL(lsdb.m_snapshotWriter.getNThreads(), 0);
+
+  ndn::Name router1("/ndn/site/%C1.router/router1");
+  auto now = ndn::time::system_clock::now();
+  NameLsa nameLsa(router1, 7, now + 3600_s, NamePrefixList{ndn::Name("/ndn/name1")});
+  snapshotLsdb.installLsa(std::make_shared<NameLsa>(nameLsa));
+
+  // The shutdown write is on disk once flushSnapshot returns
+  boost::filesystem::remove(snapshotLsdb.getSnapshotFileName());
+  snapshotLsdb.flushSnapshot();
+  BOOST_REQUIRE(boost::filesystem::exists(snapshotLsdb.getSnapshotFileName()));
+
+  lsdb.loadSnapshot();
+  auto loaded = lsdb.findLsa<NameLsa>(router1);
+  BOOST_REQUIRE(loaded != nullptr);
+  BOOST_CHECK_EQUAL(loaded->getSeqNo(), 7);
+
+  boost::filesystem::remove(snapshotLsdb.getSnapshotFileName());
+}
+
 BOOST_AUTO_TEST_CASE(TestIsLsaNew)
 {
   ndn::Name originRouter("/ndn/memphis/%C1.Router/other-router");
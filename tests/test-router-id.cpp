@@ -0,0 +1,188 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "router-id.hpp"
+#include "adjacent.hpp"
+#include "tests/boost-test.hpp"
+
+#include <thread>
+
+namespace nlsr {
+namespace test {
+
+BOOST_AUTO_TEST_SUITE(TestRouterId)
+
+BOOST_AUTO_TEST_CASE(Intern)
+{
+  RouterIdTable& table = RouterIdTable::get();
+  ndn::Name routerA("/ndn/router-id-test/%C1.Router/a");
+  ndn::Name routerB("/ndn/router-id-test/%C1.Router/b");
+
+  BOOST_CHECK(!table.find(routerA));
+  size_t size = table.size();
+
+  RouterId a = table.intern(routerA);
+  RouterId b = table.intern(routerB);
+  BOOST_CHECK_NE(a, b);
+  BOOST_CHECK_EQUAL(table.size(), size + 2);
+
+  // A name keeps its ID
+  BOOST_CHECK_EQUAL(table.intern(routerA), a);
+  BOOST_CHECK_EQUAL(table.intern(ndn::Name("/ndn/router-id-test/%C1.Router/a")), a);
+  BOOST_REQUIRE(table.find(routerB));
+  BOOST_CHECK_EQUAL(*table.find(routerB), b);
+  BOOST_CHECK_EQUAL(table.size(), size + 2);
+
+  BOOST_CHECK_EQUAL(table.getName(a), routerA);
+  BOOST_CHECK_EQUAL(table.getName(b), routerB);
+}
+
+BOOST_AUTO_TEST_CASE(Hash)
+{
+  ndn::Name name("/ndn/router-id-test/%C1.Router/a");
+  BOOST_CHECK_EQUAL(RouterIdTable::hash(name), RouterIdTable::hash(ndn::Name(name.toUri())));
+
+  // A decoded name hashes the same as the name it was encoded from
+  ndn::Name decoded(name.wireEncode());
+  BOOST_CHECK_EQUAL(RouterIdTable::hash(decoded), RouterIdTable::hash(name));
+
+  BOOST_CHECK_NE(RouterIdTable::hash("/ab/c"), RouterIdTable::hash("/a/bc"));
+  BOOST_CHECK_NE(RouterIdTable::hash("/a"), RouterIdTable::hash(ndn::Name("/a").appendNumber(0)));
+  BOOST_CHECK_NE(RouterIdTable::hash(ndn::Name()), RouterIdTable::hash("/a"));
+}
+
+BOOST_AUTO_TEST_CASE(CachedInAdjacent)
+{
+  Adjacent adjacent("/ndn/router-id-test/%C1.Router/c");
+  RouterId id = adjacent.getNameId();
+  BOOST_CHECK_EQUAL(id, RouterIdTable::get().intern("/ndn/router-id-test/%C1.Router/c"));
+  BOOST_CHECK_EQUAL(Adjacent(adjacent).getNameId(), id);
+
+  ndn::Name renamed("/ndn/router-id-test/%C1.Router/d");
+  adjacent.setName(renamed);
+  BOOST_CHECK_EQUAL(adjacent.getNameId(), RouterIdTable::get().intern(renamed));
+  // The old name was referenced only by the adjacent and its copy
+  BOOST_CHECK(!RouterIdTable::get().find("/ndn/router-id-test/%C1.Router/c"));
+}
+
+BOOST_AUTO_TEST_CASE(Reclaim)
+{
+  RouterIdTable& table = RouterIdTable::get();
+  ndn::Name router("/ndn/router-id-test/%C1.Router/e");
+  size_t size = table.size();
+
+  RouterId id = RouterIdTable::INVALID_ID;
+  {
+    RouterIdRef ref;
+    id = ref.intern(router);
+    BOOST_CHECK_EQUAL(ref.intern("/ndn/router-id-test/%C1.Router/ignored"), id);
+    BOOST_CHECK_EQUAL(table.size(), size + 1);
+
+    RouterIdRef copy(ref);
+    ref.reset();
+    BOOST_REQUIRE(table.find(router));
+    BOOST_CHECK_EQUAL(*table.find(router), id);
+    BOOST_CHECK_EQUAL(table.getName(copy), router);
+  }
+  // The last reference is gone
+  BOOST_CHECK(!table.find(router));
+  BOOST_CHECK_EQUAL(table.size(), size);
+  BOOST_CHECK_THROW(table.getName(id), std::out_of_range);
+
+  // The ID is given to the next new name instead of growing the table
+  RouterIdRef other;
+  BOOST_CHECK_EQUAL(other.intern("/ndn/router-id-test/%C1.Router/f"), id);
+  BOOST_CHECK_EQUAL(table.size(), size + 1);
+
+  // Moves hand the reference over and copies take another one
+  RouterIdRef moved(std::move(other));
+  BOOST_CHECK_EQUAL(static_cast<RouterId>(other), RouterIdTable::INVALID_ID);
+  BOOST_CHECK_EQUAL(RouterIdRef(moved), id);
+  BOOST_CHECK_EQUAL(*table.find("/ndn/router-id-test/%C1.Router/f"), id);
+}
+
+BOOST_AUTO_TEST_CASE(Growth)
+{
+  RouterIdTable& table = RouterIdTable::get();
+  size_t size = table.size();
+
+  // Enough names to rebuild the index and fill several chunks
+  std::vector<RouterIdRef> refs(3 * RouterIdTable::CHUNK_SIZE);
+  for (size_t i = 0; i < refs.size(); ++i) {
+    refs[i].intern(ndn::Name("/ndn/router-id-test/growth").appendNumber(i));
+  }
+  BOOST_CHECK_EQUAL(table.size(), size + refs.size());
+
+  // Every other name goes away, and new names take over their IDs
+  for (size_t i = 0; i < refs.size(); i += 2) {
+    RouterId id = refs[i];
+    refs[i].reset();
+    BOOST_CHECK_EQUAL(refs[i].intern(ndn::Name("/ndn/router-id-test/regrowth").appendNumber(i)),
+                      id);
+  }
+  for (size_t i = 0; i < refs.size(); ++i) {
+    ndn::Name name(i % 2 == 0 ? "/ndn/router-id-test/regrowth" : "/ndn/router-id-test/growth");
+    name.appendNumber(i);
+    BOOST_CHECK_EQUAL(table.getName(refs[i]), name);
+    BOOST_CHECK(table.find(name) == static_cast<RouterId>(refs[i]));
+  }
+  BOOST_CHECK(!table.find(ndn::Name("/ndn/router-id-test/growth").appendNumber(0)));
+  BOOST_CHECK_EQUAL(table.size(), size + refs.size());
+}
+
+BOOST_AUTO_TEST_CASE(ConcurrentUse)
+{
+  RouterIdTable& table = RouterIdTable::get();
+  size_t size = table.size();
+  std::vector<ndn::Name> routers;
+  for (int i = 0; i < 8; ++i) {
+    routers.push_back(ndn::Name("/ndn/router-id-test/%C1.Router/concurrent").appendNumber(i));
+  }
+
+  std::vector<std::thread> threads;
+  std::atomic<int> nErrors{0};
+  for (int t = 0; t < 4; ++t) {
+    threads.emplace_back([&, t] {
+      for (int i = 0; i < 2000; ++i) {
+        const ndn::Name& router = routers[(i + t) % routers.size()];
+        RouterIdRef ref;
+        RouterId id = ref.intern(router);
+        // While held, the ID stands for the name and lookups agree
+        if (table.getName(id) != router || table.find(router) != id) {
+          ++nErrors;
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) {
+    thread.join();
+  }
+
+  BOOST_CHECK_EQUAL(nErrors.load(), 0);
+  BOOST_CHECK_EQUAL(table.size(), size);
+  for (const auto& router : routers) {
+    BOOST_CHECK(!table.find(router));
+  }
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr
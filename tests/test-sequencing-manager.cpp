@@ -42,6 +42,8 @@ public:
 
   ~SequencingManagerFixture()
   {
+    // Nothing is left for the destructor of the manager to write after the removal
+    m_seqManager.flush();
     boost::filesystem::remove(seqFile);
   }
 
@@ -100,6 +102,60 @@ BOOST_AUTO_TEST_CASE(CorruptFile)
   checkSeqNumbers(10, 10, 0);
 }
 
+BOOST_AUTO_TEST_CASE(SeqNoLease)
+{
+  auto readNameLsaSeq = [this] {
+    std::ifstream inputFile(seqFile);
+    std::string seqType;
+    uint64_t seqNo = 0;
+    inputFile >> seqType >> seqNo;
+    return seqNo;
+  };
+
+  // A restart from the file, which skips ahead by 10, never reuses a sequence number
+  for (uint64_t i = 0; i < 3 * SequencingManager::SEQ_NO_LEASE; ++i) {
+    m_seqManager.increaseNameLsaSeq();
+    m_seqManager.writeSeqNoToFile();
+    BOOST_CHECK_LT(m_seqManager.getNameLsaSeq(), readNameLsaSeq() + 10);
+  }
+
+  m_seqManager.flush();
+  BOOST_CHECK_GE(readNameLsaSeq(), m_seqManager.getNameLsaSeq());
+}
+
+BOOST_AUTO_TEST_CASE(BurstDoesNotBlock)
+{
+  auto readNameLsaSeq = [this] {
+    std::ifstream inputFile(seqFile);
+    std::string seqType;
+    uint64_t seqNo = 0;
+    inputFile >> seqType >> seqNo;
+    return seqNo;
+  };
+
+  // The first lease after a start from a file is written before publishing
+  writeToFile("NameLsaSeq 100\nAdjLsaSeq 100\nCorLsaSeq 0");
+  initiateFromFile();
+  m_seqManager.increaseNameLsaSeq();
+  m_seqManager.writeSeqNoToFile();
+  BOOST_CHECK_EQUAL(m_seqManager.m_nBlockingWrites, 1);
+  BOOST_CHECK_EQUAL(readNameLsaSeq(), m_seqManager.getNameLsaSeq() +
+                                      SequencingManager::SEQ_NO_LEASE);
+
+  // A burst within the lease is not written on the caller's thread
+  for (uint64_t i = 0; i < SequencingManager::SEQ_NO_LEASE; ++i) {
+    m_seqManager.increaseNameLsaSeq();
+    m_seqManager.writeSeqNoToFile();
+  }
+  BOOST_CHECK_EQUAL(m_seqManager.m_nBlockingWrites, 1);
+
+  // The writer thread renews the lease meanwhile
+  for (int i = 0; i < 100 && readNameLsaSeq() < m_seqManager.getNameLsaSeq(); ++i) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  }
+  BOOST_CHECK_GE(readNameLsaSeq(), m_seqManager.getNameLsaSeq());
+}
+
 BOOST_AUTO_TEST_SUITE_END()
 
 } // namespace test
@@ -0,0 +1,74 @@
+/* -*- Mode:C++; c-file-style:"gnu"; indent-tabs-mode:nil; -*- */
+/*
+ * Copyright (c) 2014-2021,  The University of Memphis,
+ *                           Regents of the University of California
+ *
+ * This file is part of NLSR (Named-data Link State Routing).
+ * See AUTHORS.md for complete list of NLSR authors and contributors.
+ *
+ * NLSR is free software: you can redistribute it and/or modify it under the terms
+ * of the GNU General Public License as published by the Free Software Foundation,
+ * either version 3 of the License, or (at your option) any later version.
+ *
+ * NLSR is distributed in the hope that it will be useful, but WITHOUT ANY WARRANTY;
+ * without even the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+ * PURPOSE.  See the GNU General Public License for more details.
+ *
+ * You should have received a copy of the GNU General Public License along with
+ * NLSR, e.g., in COPYING.md file.  If not, see <http://www.gnu.org/licenses/>.
+ */
+
+#include "utility/worker-pool.hpp"
+
+#include "tests/boost-test.hpp"
+
+#include <atomic>
+#include <vector>
+
+namespace nlsr {
+namespace test {
+
+using util::WorkerPool;
+
+BOOST_AUTO_TEST_SUITE(TestWorkerPool)
+
+BOOST_AUTO_TEST_CASE(Post)
+{
+  std::vector<size_t> order;
+  {
+    WorkerPool pool(1);
+    BOOST_CHECK_EQUAL(pool.getNThreads(), 1);
+    for (size_t i = 0; i < 10; ++i) {
+      pool.post([&order, i] { order.push_back(i); });
+    }
+    // The destructor waits for the queued jobs
+  }
+
+  // A single worker runs the jobs in the order they were posted
+  std::vector<size_t> expected{0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+  BOOST_CHECK_EQUAL_COLLECTIONS(order.begin(), order.end(), expected.begin(), expected.end());
+}
+
+BOOST_AUTO_TEST_CASE(PostToSeveralThreads)
+{
+  std::atomic<size_t> count{0};
+  {
+    WorkerPool pool(4);
+    BOOST_CHECK_EQUAL(pool.getNThreads(), 4);
+    for (size_t i = 0; i < 100; ++i) {
+      pool.post([&count] { ++count; });
+    }
+  }
+  BOOST_CHECK_EQUAL(count, 100);
+}
+
+BOOST_AUTO_TEST_CASE(NoThreads)
+{
+  WorkerPool pool(0);
+  BOOST_CHECK_EQUAL(pool.getNThreads(), 0);
+}
+
+BOOST_AUTO_TEST_SUITE_END()
+
+} // namespace test
+} // namespace nlsr